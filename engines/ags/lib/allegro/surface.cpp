@@ -201,13 +201,6 @@ void BITMAP::draw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 
 	auto args = DrawInnerArgs(this, (horizFlip || vertFlip) ? &temp : srcBitmap, (horizFlip || vertFlip) ? flipped.getBounds() : srcRect, Common::Rect(dstX, dstY, dstX + 1, dstY + 1), skipTrans, srcAlpha, false, false, tintRed, tintGreen, tintBlue, false);
 	if (!args.shouldDraw) return;
-	if (!args.sameFormat && args.src.format.bytesPerPixel == 1) {
-		if (format.bytesPerPixel == 4)
-			drawInnerGeneric<4, 1, false>(args);
-		else
-			drawInnerGeneric<2, 1, false>(args);
-		return;
-	}
 #ifdef SCUMMVM_NEON
 	if (_G(simd_flags) & AGS3::Globals::SIMD_NEON) {
 		drawNEON<false>(args);
@@ -236,10 +229,27 @@ void BITMAP::stretchDraw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 	auto args = DrawInnerArgs(this, srcBitmap, srcRect, dstRect, skipTrans, srcAlpha, false, false, -1, -1, -1, true);
 	if (!args.shouldDraw) return;
 	if (!args.sameFormat && args.src.format.bytesPerPixel == 1) {
-		if (format.bytesPerPixel == 4)
-			drawInnerGeneric<4, 1, true>(args);
-		else
-			drawInnerGeneric<2, 1, true>(args);
+		// Paletted sources are expanded row by row, so they can be stretched
+		// directly in the optimized paths
+#ifdef SCUMMVM_NEON
+		if (_G(simd_flags) & AGS3::Globals::SIMD_NEON) {
+			drawNEON<true>(args);
+			return;
+		}
+#endif
+#ifdef SCUMMVM_AVX2
+		if (_G(simd_flags) & AGS3::Globals::SIMD_AVX2) {
+			drawAVX2<true>(args);
+			return;
+		}
+#endif
+#ifdef SCUMMVM_SSE2
+		if (_G(simd_flags) & AGS3::Globals::SIMD_SSE2) {
+			drawSSE2<true>(args);
+			return;
+		}
+#endif
+		drawGeneric<true>(args);
 		return;
 	}
 
@@ -193,6 +193,10 @@ void BITMAP::drawGeneric(DrawInnerArgs &args) {
 		drawInnerGeneric<4, 2, Scale>(args);
 	} else if (format.bytesPerPixel == 2 && args.src.format.bytesPerPixel == 4) {
 		drawInnerGeneric<2, 4, Scale>(args);
+	} else if (format.bytesPerPixel == 4 && args.src.format.bytesPerPixel == 1) {
+		drawInnerGeneric<4, 1, Scale>(args);
+	} else if (format.bytesPerPixel == 2 && args.src.format.bytesPerPixel == 1) {
+		drawInnerGeneric<2, 1, Scale>(args);
 	}
 }
 
@@ -954,6 +954,97 @@ static void drawInner1Bpp(BITMAP::DrawInnerArgs &args) {
 	}
 }
 
+// Paletted (8bpp) sources drawn onto 2bpp or 4bpp destinations. Every source row
+// is first expanded to ARGB through the palette, after which it goes through the
+// same blending code as the 4bpp blits. Transparent pixels are expanded to 0,
+// which can never match a palette entry since those are always fully opaque.
+template<int DestBytesPerPixel, bool Scale>
+static void drawInnerPalWithConv(BITMAP::DrawInnerArgs &args) {
+	const int xDir = args.horizFlip ? -1 : 1;
+	uint32x4_t tint = vshlq_n_u32(vdupq_n_u32(args.srcAlpha), 24);
+	tint = vorrq_u32(tint, vshlq_n_u32(vdupq_n_u32(args.tintRed), 16));
+	tint = vorrq_u32(tint, vshlq_n_u32(vdupq_n_u32(args.tintGreen), 8));
+	tint = vorrq_u32(tint, vdupq_n_u32(args.tintBlue));
+	uint32x4_t maskedAlphas = vmovq_n_u32(0xffffffff);
+	uint32x4_t transColors = vmovq_n_u32(0);
+	uint32x4_t alphas = vmovq_n_u32(args.srcAlpha);
+
+	uint32 palette[PAL_SIZE];
+	for (int i = 0; i < PAL_SIZE; ++i)
+		palette[i] = 0xff000000 | (args.palette[i].r << 16) | (args.palette[i].g << 8) | args.palette[i].b;
+	if (args.skipTrans)
+		palette[args.transColor] = 0;
+
+	// Clip the bounds ahead of time (so we don't waste time checking if we are in bounds when
+	// we are in the inner loop)
+	int xCtrStart = 0, xCtrWidth = args.dstRect.width();
+	if (args.xStart + xCtrWidth > args.destArea.w) {
+		xCtrWidth = args.destArea.w - args.xStart;
+	}
+	if (args.xStart < 0) {
+		xCtrStart = -args.xStart;
+		args.xStart = 0;
+	}
+	int destY = args.yStart, yCtr = 0, srcYCtr = 0, scaleYCtr = 0, yCtrHeight = args.dstRect.height();
+	if (args.yStart < 0) {
+		yCtr = -args.yStart;
+		destY = 0;
+		if (Scale) {
+			scaleYCtr = yCtr * args.scaleY;
+			srcYCtr = scaleYCtr / BITMAP::SCALE_THRESHOLD;
+		}
+	}
+	if (args.yStart + yCtrHeight > args.destArea.h) {
+		yCtrHeight = args.destArea.h - args.yStart;
+	}
+	const int rowWidth = xCtrWidth - xCtrStart;
+	if (rowWidth <= 0)
+		return;
+
+	Common::Array<uint32> srcRow;
+	srcRow.resize(rowWidth);
+
+	byte *destP = (byte *)args.destArea.getBasePtr(args.xStart, destY);
+	const byte *srcP = (const byte *)args.src.getBasePtr(
+	                       args.horizFlip ? args.srcArea.right - 1 : args.srcArea.left,
+	                       args.vertFlip ? args.srcArea.bottom - 1 - yCtr : args.srcArea.top + yCtr);
+	for (; yCtr < yCtrHeight; ++yCtr, scaleYCtr += args.scaleY) {
+		if (Scale) {
+			int newSrcYCtr = scaleYCtr / BITMAP::SCALE_THRESHOLD;
+			if (srcYCtr != newSrcYCtr) {
+				srcP += args.src.pitch * (newSrcYCtr - srcYCtr);
+				srcYCtr = newSrcYCtr;
+			}
+		}
+
+		// Expand the row through the palette
+		for (int x = 0, xCtr = xCtrStart, scaleXCtr = xCtrStart * args.scaleX; x < rowWidth; ++x, ++xCtr, scaleXCtr += args.scaleX) {
+			if (Scale)
+				srcRow[x] = palette[srcP[scaleXCtr / BITMAP::SCALE_THRESHOLD]];
+			else
+				srcRow[x] = palette[srcP[xDir * xCtr]];
+		}
+
+		const byte *rowP = (const byte *)&srcRow[0];
+		int x = 0;
+		for (; x + 4 <= rowWidth; x += 4) {
+			drawPixelSIMD<DestBytesPerPixel, 4>(destP + x * DestBytesPerPixel, rowP, tint, alphas, maskedAlphas, transColors, 1, x * 4, args.srcAlpha, args.skipTrans, false, args.useTint, vmovq_n_u32(0));
+		}
+		if (x < rowWidth) {
+			// Blend the last few pixels through a padded buffer
+			uint32 srcCols[4] = {0};
+			uint32 destCols[4] = {0};
+			memcpy(srcCols, rowP + x * 4, (rowWidth - x) * 4);
+			memcpy(destCols, destP + x * DestBytesPerPixel, (rowWidth - x) * DestBytesPerPixel);
+			drawPixelSIMD<DestBytesPerPixel, 4>((byte *)destCols, (const byte *)srcCols, tint, alphas, maskedAlphas, transColors, 1, 0, args.srcAlpha, args.skipTrans, false, args.useTint, vmovq_n_u32(0));
+			memcpy(destP + x * DestBytesPerPixel, destCols, (rowWidth - x) * DestBytesPerPixel);
+		}
+
+		destP += args.destArea.pitch;
+		if (!Scale) srcP += args.vertFlip ? -args.src.pitch : args.src.pitch;
+	}
+}
+
 }; // end of class DrawInnerImpl_NEON
 
 template<bool Scale>
@@ -968,6 +1059,10 @@ void BITMAP::drawNEON(DrawInnerArgs &args) {
 		DrawInnerImpl_NEON::drawInner4BppWithConv<4, 2, Scale>(args);
 	} else if (format.bytesPerPixel == 2 && args.src.format.bytesPerPixel == 4) {
 		DrawInnerImpl_NEON::drawInner4BppWithConv<2, 4, Scale>(args);
+	} else if (format.bytesPerPixel == 4 && args.src.format.bytesPerPixel == 1) {
+		DrawInnerImpl_NEON::drawInnerPalWithConv<4, Scale>(args);
+	} else if (format.bytesPerPixel == 2 && args.src.format.bytesPerPixel == 1) {
+		DrawInnerImpl_NEON::drawInnerPalWithConv<2, Scale>(args);
 	}
 }
 
@@ -248,6 +248,117 @@ void Test_BlenderModes() {
 	}
 }
 
+void Test_PalettedBlits() {
+	// Compares the optimized paletted (8bpp) to 16/32bpp blits against the generic ones,
+	// using the same tolerances as Test_BlenderModes for the blend results
+	const int srcWidth = 37, srcHeight = 5;
+	const uint simdVariants[] = {AGS3::Globals::SIMD_AVX2, AGS3::Globals::SIMD_SSE2, AGS3::Globals::SIMD_NEON};
+	const int srcAlphas[] = {-1, 0, 1, 127, 255};
+	uint oldSimdFlags = _G(simd_flags);
+	uint32 seed = 0x1234567;
+	auto nextRandom = [&]() {
+		seed = seed * 1103515245 + 12345;
+		return (seed >> 16) & 0x7fff;
+	};
+
+	for (int i = 0; i < PAL_SIZE; ++i) {
+		_G(current_palette)[i].r = nextRandom() & 0x3f;
+		_G(current_palette)[i].g = nextRandom() & 0x3f;
+		_G(current_palette)[i].b = nextRandom() & 0x3f;
+	}
+	Graphics::ManagedSurface owner(srcWidth, srcHeight, Graphics::PixelFormat::createFormatCLUT8());
+	BITMAP src(&owner);
+	for (int y = 0; y < srcHeight; ++y)
+		for (int x = 0; x < srcWidth; ++x)
+			*(byte *)src.getBasePtr(x, y) = (x % 7 == 0) ? 0 : (nextRandom() & 0xff);
+
+	for (int depth = 2; depth <= 4; depth += 2) {
+		const Graphics::PixelFormat destFormat = (depth == 4) ?
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24) : Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		Graphics::ManagedSurface ownerInit(srcWidth * 2, srcHeight * 2, destFormat);
+		for (int y = 0; y < ownerInit.h; ++y)
+			for (int x = 0; x < ownerInit.w; ++x)
+				ownerInit.setPixel(x, y, destFormat.ARGBToColor(nextRandom() & 0xff, nextRandom() & 0xff, nextRandom() & 0xff, nextRandom() & 0xff));
+		Graphics::ManagedSurface ownerControl(srcWidth * 2, srcHeight * 2, destFormat);
+		Graphics::ManagedSurface ownerSimd(srcWidth * 2, srcHeight * 2, destFormat);
+		BITMAP control(&ownerControl), simd(&ownerSimd);
+
+		for (int blenderMode = (int)kSourceAlphaBlender; blenderMode <= (int)kTintLightBlenderMode; blenderMode++) {
+			_G(_blender_mode) = (BlenderMode)blenderMode;
+			int tolerance;
+			switch ((BlenderMode)blenderMode) {
+			case kArgbToArgbBlender:
+			case kRgbToArgbBlender:
+			case kOpaqueBlenderMode:
+			case kAdditiveBlenderMode:
+				tolerance = 1;
+				break;
+			case kTintBlenderMode:
+			case kTintLightBlenderMode:
+				tolerance = 2;
+				break;
+			default:
+				tolerance = 0;
+				break;
+			}
+			if (depth == 2)
+				tolerance = 1;
+
+			for (size_t variant = 0; variant < ARRAYSIZE(simdVariants); ++variant) {
+				if (!(oldSimdFlags & simdVariants[variant]))
+					continue;
+				for (size_t alphaIdx = 0; alphaIdx < ARRAYSIZE(srcAlphas); ++alphaIdx) {
+					// Light levels go up to 250, see blendTintSprite
+					if (blenderMode == kTintLightBlenderMode && srcAlphas[alphaIdx] > 250)
+						continue;
+					for (int mode = 0; mode < 8; ++mode) {
+						const bool skipTrans = (mode & 1) != 0;
+						const bool useTint = (mode & 2) != 0 && srcAlphas[alphaIdx] != -1;
+						const bool stretch = (mode & 4) != 0;
+						for (int y = 0; y < ownerInit.h; ++y) {
+							memcpy(ownerControl.getBasePtr(0, y), ownerInit.getBasePtr(0, y), ownerInit.w * depth);
+							memcpy(ownerSimd.getBasePtr(0, y), ownerInit.getBasePtr(0, y), ownerInit.w * depth);
+						}
+
+						for (int pass = 0; pass < 2; ++pass) {
+							_G(simd_flags) = pass ? simdVariants[variant] : AGS3::Globals::SIMD_NONE;
+							BITMAP &dest = pass ? simd : control;
+							if (stretch)
+								dest.stretchDraw(&src, Common::Rect(srcWidth, srcHeight), Common::Rect(3, 1, 3 + srcWidth * 2 - 5, 1 + srcHeight + 3), skipTrans, srcAlphas[alphaIdx]);
+							else if (useTint)
+								dest.draw(&src, Common::Rect(srcWidth, srcHeight), -2, 3, false, false, skipTrans, srcAlphas[alphaIdx], 200, 40, 90);
+							else
+								dest.draw(&src, Common::Rect(srcWidth, srcHeight), 5, -1, false, false, skipTrans, srcAlphas[alphaIdx]);
+						}
+
+						for (int y = 0; y < ownerControl.h; ++y) {
+							for (int x = 0; x < ownerControl.w; ++x) {
+								uint8 a1, r1, g1, b1, a2, r2, g2, b2;
+								destFormat.colorToARGB(control.getpixel(x, y), a1, r1, g1, b1);
+								destFormat.colorToARGB(simd.getpixel(x, y), a2, r2, g2, b2);
+								if (depth == 2) {
+									// Compare the 16-bit channels at their native precision
+									r1 >>= 3; g1 >>= 2; b1 >>= 3;
+									r2 >>= 3; g2 >>= 2; b2 >>= 3;
+								}
+								if (ABS((int)a1 - (int)a2) > tolerance || ABS((int)r1 - (int)r2) > tolerance ||
+								        ABS((int)g1 - (int)g2) > tolerance || ABS((int)b1 - (int)b2) > tolerance) {
+									debug("Paletted blit mismatch at %d,%d: blender %d, depth %d, alpha %d, mode %d, simd %x",
+									      x, y, blenderMode, depth * 8, srcAlphas[alphaIdx], mode, simdVariants[variant]);
+									debug("control argb: %d, %d, %d, %d simd argb: %d, %d, %d, %d", a1, r1, g1, b1, a2, r2, g2, b2);
+									assert(false && "paletted blit is over the tolerance");
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	_G(simd_flags) = oldSimdFlags;
+}
+
 void Test_GfxTransparency() {
 	// Test that every transparency which is a multiple of 10 is converted
 	// forth and back without losing precision
@@ -265,6 +376,9 @@ void Test_GfxTransparency() {
 
 void Test_Gfx() {
 	Test_GfxTransparency();
+#if defined(SCUMMVM_AVX2) || defined(SCUMMVM_SSE2) || defined(SCUMMVM_NEON)
+	Test_PalettedBlits();
+#endif
 #if (defined(SCUMMVM_AVX2) || defined(SCUMMVM_SSE2) || defined(SCUMMVM_NEON)) && defined(SLOW_TESTS)
 	Test_BlenderModes();
 	// This could take a LONG time
@@ -748,6 +748,9 @@ bool Actor::tick(bool forceDraw, Common::Rect *screenRect) {
 		_animationId = newAnimation;
 		_animationFrame = newFrame;
 
+		// Have the next frames ready by the time they are drawn
+		_vm->_sliceAnimations->prefetchFrames(_animationId, _animationFrame + 1);
+
 		Vector3 positionChange = _vm->_sliceAnimations->getPositionChange(_animationId);
 		float angleChange = _vm->_sliceAnimations->getFacingChange(_animationId);
 
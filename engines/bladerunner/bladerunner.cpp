@@ -1275,6 +1275,9 @@ void BladeRunnerEngine::gameTick() {
 		}
 	}
 
+	// Load some of the animation pages the actors will need next
+	_sliceAnimations->processPrefetch();
+
 	_items->tick();
 
 	_itemPickup->tick();
@@ -59,6 +59,7 @@ enum DebugLevels {
 	kDebugScript = 1,
 	kDebugSound,
 	kDebugAnimation,
+	kDebugVideo,
 };
 
 class Actor;
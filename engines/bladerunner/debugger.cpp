@@ -45,6 +45,7 @@
 #include "bladerunner/settings.h"
 #include "bladerunner/set.h"
 #include "bladerunner/set_effects.h"
+#include "bladerunner/slice_animations.h"
 #include "bladerunner/text_resource.h"
 #include "bladerunner/time.h"
 #include "bladerunner/vector.h"
@@ -146,6 +147,7 @@ Debugger::Debugger(BladeRunnerEngine *vm) : GUI::Debugger() {
 	registerCmd("playvqa", WRAP_METHOD(Debugger, cmdPlayVqa));
 	registerCmd("ammo", WRAP_METHOD(Debugger, cmdAmmo));
 	registerCmd("cheat", WRAP_METHOD(Debugger, cmdCheatReport));
+	registerCmd("prefetch", WRAP_METHOD(Debugger, cmdPrefetch));
 #if BLADERUNNER_ORIGINAL_BUGS
 #else
 	registerCmd("effect", WRAP_METHOD(Debugger, cmdEffect));
@@ -3331,4 +3333,36 @@ bool Debugger::cmdCheatReport(int argc, const char** argv) {
 	return true;
 }
 
+bool Debugger::cmdPrefetch(int argc, const char **argv) {
+	bool invalidSyntax = false;
+
+	if (argc == 1) {
+		SliceAnimations *sliceAnimations = _vm->_sliceAnimations;
+		debugPrintf("Animation pages loaded: %u KB\n", sliceAnimations->getLoadedSize() / 1024);
+		debugPrintf("Prefetched and not used yet: %u KB, prefetch budget: %u KB\n", sliceAnimations->getUnusedPrefetchedSize() / 1024, sliceAnimations->getPrefetchBudget() / 1024);
+		debugPrintf("Page faults: %u\n", sliceAnimations->getPageFaults());
+		debugPrintf("Prefetched pages: %u, used: %u\n", sliceAnimations->getPrefetchedPages(), sliceAnimations->getPrefetchHits());
+	} else if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		_vm->_sliceAnimations->resetPageCounters();
+		debugPrintf("Animation page counters reset\n");
+	} else if (argc == 3 && !scumm_stricmp(argv[1], "budget")) {
+		int budget = atoi(argv[2]);
+		if (budget < 0) {
+			invalidSyntax = true;
+		} else {
+			_vm->_sliceAnimations->setPrefetchBudget(budget * 1024);
+			debugPrintf("Prefetch budget set to %d KB\n", budget);
+		}
+	} else {
+		invalidSyntax = true;
+	}
+
+	if (invalidSyntax) {
+		debugPrintf("Show the animation page counters, reset them, or set the memory budget of prefetching (0 disables it).\n");
+		debugPrintf("Usage: %s [reset | budget <KB>]\n", argv[0]);
+	}
+
+	return true;
+}
+
 } // End of namespace BladeRunner
@@ -35,6 +35,7 @@ static const DebugChannelDef debugFlagList[] = {
 	{BladeRunner::kDebugScript, "Script", "Debug the scripts"},
 	{BladeRunner::kDebugSound, "Sound", "Debug the sound"},
 	{BladeRunner::kDebugAnimation, "Animation", "Debug the model animations"},
+	{BladeRunner::kDebugVideo, "Video", "Debug the VQA video decoding"},
 	DEBUG_CHANNEL_END
 };
 
@@ -282,6 +282,11 @@ MODULE_OBJS = \
 	waypoints.o \
 	zbuffer.o
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	slice_renderer-sse2.o
+endif
+
 # This module can be built as a plugin
 ifeq ($(ENABLE_BLADERUNNER), DYNAMIC_PLUGIN)
 PLUGIN := 1
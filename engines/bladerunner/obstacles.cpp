@@ -361,6 +361,17 @@ int Obstacles::findEmptyPolygon() const {
 	return -1;
 }
 
+bool Obstacles::segmentCanIntersect(const Polygon &poly, Vector2 from, Vector2 to) {
+	// The rect of a polygon bounds all of its edges, so a segment whose bounding box
+	// misses the rect cannot cross any of them. The margin covers the rounding
+	// of lineIntersection() on large coordinates.
+	const float margin = 1.0f;
+	return !(MAX(from.x, to.x) + margin < poly.rect.x0
+	      || MIN(from.x, to.x) - margin > poly.rect.x1
+	      || MAX(from.y, to.y) + margin < poly.rect.y0
+	      || MIN(from.y, to.y) - margin > poly.rect.y1);
+}
+
 float Obstacles::getLength(float x0, float z0, float x1, float z1) {
 	if (x0 == x1) {
 		return fabs(z1 - z0);
@@ -401,6 +412,10 @@ bool Obstacles::findNextWaypoint(const Vector3 &from, const Vector3 &to, Vector3
 			continue;
 		}
 
+		if (!segmentCanIntersect(poly, from.xz(), to.xz())) {
+			continue;
+		}
+
 		int     nearVertIndex;
 		float   nearDist;
 		Vector2 nearPos;
@@ -768,6 +783,10 @@ bool Obstacles::findFarthestAvailablePathVertex(Vector2 *path, int pathSize, Vec
 				continue;
 			}
 
+			if (!segmentCanIntersect(*polygon, Vector2(start.x, start.z), path[pathVertexIdx])) {
+				continue;
+			}
+
 			for (int polygonVertexIdx = 0; polygonVertexIdx < polygon->verticeCount && pathVertexAvailable; ++polygonVertexIdx) {
 				int polygonVertexNextIdx = (polygonVertexIdx + 1) % polygon->verticeCount;
 
@@ -889,11 +908,19 @@ void Obstacles::backup() {
 }
 
 void Obstacles::restore() {
+	// This runs after every walk step, so only the vertices in use are copied
 	for (int i = 0; i != kPolygonCount; ++i) {
-		_polygons[i].isPresent = false;
+		copyPolygon(_polygons[i], _polygonsBackup[i]);
 	}
-	for (int i = 0; i != kPolygonCount; ++i) {
-		_polygons[i] = _polygonsBackup[i];
+}
+
+void Obstacles::copyPolygon(Polygon &dst, const Polygon &src) {
+	dst.isPresent    = src.isPresent;
+	dst.verticeCount = src.verticeCount;
+	dst.rect         = src.rect;
+	if (src.isPresent) {
+		memcpy(dst.vertices, src.vertices, src.verticeCount * sizeof(Vector2));
+		memcpy(dst.vertexType, src.vertexType, src.verticeCount * sizeof(VertexType));
 	}
 }
 
@@ -74,6 +74,9 @@ class Obstacles {
 
 	bool mergePolygons(Polygon &polyA, Polygon &PolyB);
 
+	static bool segmentCanIntersect(const Polygon &poly, Vector2 from, Vector2 to);
+	static void copyPolygon(Polygon &dst, const Polygon &src);
+
 public:
 	Obstacles(BladeRunnerEngine *vm);
 	~Obstacles();
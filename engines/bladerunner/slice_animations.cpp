@@ -27,6 +27,7 @@
 #include "common/debug.h"
 #include "common/file.h"
 #include "common/system.h"
+#include "common/util.h"
 
 namespace BladeRunner {
 
@@ -270,15 +271,14 @@ void *SliceAnimations::getFramePtr(uint32 animation, uint32 frame) {
 
 	if (page._data == nullptr) {                          // if not cached already
 		newPage = true;
-		page._data = _coreAnimPageFile.loadPage(pageId);    // look in COREANIM first
-
-		if (page._data == nullptr) {                      // if not in COREAMIM
-			page._data = _framesPageFile.loadPage(pageId);  // Look in CDFRAMES or HDFRAMES loaded data
-
-			if (page._data == nullptr) {
-				error("Unable to locate page %d for animation %d frame %d", pageId, animation, frame);
-			}
+		++_pageFaults;
+		if (!loadPage(pageId)) {
+			error("Unable to locate page %d for animation %d frame %d", pageId, animation, frame);
 		}
+	} else if (page._prefetched) {
+		++_prefetchHits;
+		page._prefetched = false;
+		--_unusedPrefetchedPageCount;
 	}
 
 	page._lastAccess = _vm->_time->currentSystem();
@@ -287,6 +287,101 @@ void *SliceAnimations::getFramePtr(uint32 animation, uint32 frame) {
 	return (byte *)page._data + pageOffset;
 }
 
+bool SliceAnimations::loadPage(uint32 pageId) {
+	Page &page = _pages[pageId];
+
+	page._data = _coreAnimPageFile.loadPage(pageId);    // look in COREANIM first
+
+	if (page._data == nullptr) {                        // if not in COREAMIM
+		page._data = _framesPageFile.loadPage(pageId);  // Look in CDFRAMES or HDFRAMES loaded data
+
+		if (page._data == nullptr) {
+			return false;
+		}
+	}
+
+	++_loadedPageCount;
+	return true;
+}
+
+void SliceAnimations::freePage(Page &page) {
+	if (page._data) {
+		free(page._data);
+		page._data = nullptr;
+		--_loadedPageCount;
+	}
+	if (page._prefetched) {
+		page._prefetched = false;
+		--_unusedPrefetchedPageCount;
+	}
+}
+
+void SliceAnimations::prefetchFrames(uint32 animation, uint32 frame, uint32 count) {
+	if (animation >= _animations.size() || _pageSize == 0) {
+		return;
+	}
+
+	const Animation &anim = _animations[animation];
+	if (anim.frameCount == 0) {
+		return;
+	}
+
+	// Looping animations wrap around, others just reload frames already in use
+	count = MIN(count, anim.frameCount);
+
+	uint32 lastPageId = 0xFFFFFFFF;
+	for (uint32 i = 0; i != count; ++i) {
+		uint32 frameOffset = anim.offset + ((frame + i) % anim.frameCount) * anim.frameSize;
+		uint32 pageId = frameOffset / _pageSize;
+		if (pageId == lastPageId || pageId >= _pages.size()) {
+			continue;
+		}
+		lastPageId = pageId;
+
+		Page &page = _pages[pageId];
+		if (page._data == nullptr && !page._prefetchQueued) {
+			page._prefetchQueued = true;
+			_prefetchQueue.push(pageId);
+		}
+	}
+}
+
+void SliceAnimations::processPrefetch() {
+	uint32 startTime = g_system->getMillis();
+
+	while (!_prefetchQueue.empty()) {
+		if ((_unusedPrefetchedPageCount + 1) * _pageSize > _prefetchBudget) {
+			// Out of budget, the pages will be loaded on demand
+			clearPrefetchQueue();
+			return;
+		}
+
+		uint32 pageId = _prefetchQueue.pop();
+		Page &page = _pages[pageId];
+		page._prefetchQueued = false;
+
+		if (page._data != nullptr || !loadPage(pageId)) {
+			continue;
+		}
+
+		++_prefetchedPages;
+		++_unusedPrefetchedPageCount;
+		page._prefetched = true;
+		page._lastAccess = _vm->_time->currentSystem();
+		updatePagesList(page, false);
+
+		if (g_system->getMillis() - startTime >= kPrefetchTimeSlice) {
+			break;
+		}
+	}
+}
+
+void SliceAnimations::clearPrefetchQueue() {
+	while (!_prefetchQueue.empty()) {
+		_pages[_prefetchQueue.pop()]._prefetchQueued = false;
+	}
+}
+
 void SliceAnimations::updatePagesList(Page &page, bool newPage) {
 	// We are already at the end, nothing to update
 	// Only cleanup old pages if any
@@ -357,8 +452,7 @@ void SliceAnimations::cleanupOutdatedPages() {
 		_lastUsedPage->_nextPage = next;
 		next->_prevPage = _lastUsedPage;
 
-		free(page->_data);
-		page->_data = nullptr;
+		freePage(*page);
 		page->_lastAccess = 0;
 		page->_prevPage = nullptr;
 		page->_nextPage = nullptr;
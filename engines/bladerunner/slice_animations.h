@@ -24,6 +24,7 @@
 
 #include "common/array.h"
 #include "common/file.h"
+#include "common/queue.h"
 #include "common/str.h"
 #include "common/types.h"
 
@@ -61,8 +62,10 @@ class SliceAnimations {
 		// Use a doubly linked list to sort pages by access time
 		Page   *_prevPage;
 		Page   *_nextPage;
+		bool   _prefetched;     // Loaded ahead of time and not used yet
+		bool   _prefetchQueued;
 
-		Page() : _data(nullptr), _lastAccess(0), _prevPage(nullptr), _nextPage(nullptr) {}
+		Page() : _data(nullptr), _lastAccess(0), _prevPage(nullptr), _nextPage(nullptr), _prefetched(false), _prefetchQueued(false) {}
 	};
 
 	struct PageFile {
@@ -94,10 +97,28 @@ class SliceAnimations {
 	PageFile _coreAnimPageFile;
 	PageFile _framesPageFile;
 
+	// Pages of the upcoming animation frames, loaded a few at a time
+	// by processPrefetch() so the first use of a frame doesn't read the disk
+	Common::Queue<uint32> _prefetchQueue;
+	uint32 _prefetchBudget;
+	uint32 _loadedPageCount;
+	uint32 _unusedPrefetchedPageCount;
+
+	uint32 _pageFaults;
+	uint32 _prefetchedPages;
+	uint32 _prefetchHits;
+
+	bool loadPage(uint32 pageId);
+	void freePage(Page &page);
+	void clearPrefetchQueue();
 	void updatePagesList(Page &page, bool newPage);
 	void cleanupOutdatedPages();
 
 public:
+	static const uint32 kPrefetchFrames         = 12;
+	static const uint32 kPrefetchTimeSlice      = 2;  // in milliseconds
+	static const uint32 kDefaultPrefetchBudget  = 4 * 1024 * 1024;
+
 	SliceAnimations(BladeRunnerEngine *vm)
 		: _vm(vm)
 		, _coreAnimPageFile(this)
@@ -106,7 +127,13 @@ public:
 		, _pageSize(0)
 		, _pageCount(0)
 		, _paletteCount(0)
-		, _lastUsedPage(nullptr) {}
+		, _lastUsedPage(nullptr)
+		, _prefetchBudget(kDefaultPrefetchBudget)
+		, _loadedPageCount(0)
+		, _unusedPrefetchedPageCount(0)
+		, _pageFaults(0)
+		, _prefetchedPages(0)
+		, _prefetchHits(0) {}
 	~SliceAnimations();
 
 	bool open(const Common::String &name);
@@ -122,6 +149,21 @@ public:
 
 	Vector3 getPositionChange(int animation) const;
 	float   getFacingChange(int animation) const;
+
+	void prefetchFrames(uint32 animation, uint32 frame, uint32 count = kPrefetchFrames);
+	void processPrefetch();
+
+	// Prefetching stops while the prefetched pages not used yet take more than this.
+	// Pages already drawn are left to the usual LRU cleanup and don't count.
+	void   setPrefetchBudget(uint32 budget) { _prefetchBudget = budget; }
+	uint32 getPrefetchBudget() const { return _prefetchBudget; }
+	uint32 getLoadedSize() const { return _loadedPageCount * _pageSize; }
+	uint32 getUnusedPrefetchedSize() const { return _unusedPrefetchedPageCount * _pageSize; }
+
+	uint32 getPageFaults() const { return _pageFaults; }
+	uint32 getPrefetchedPages() const { return _prefetchedPages; }
+	uint32 getPrefetchHits() const { return _prefetchHits; }
+	void   resetPageCounters() { _pageFaults = _prefetchedPages = _prefetchHits = 0; }
 };
 
 } // End of namespace BladeRunner
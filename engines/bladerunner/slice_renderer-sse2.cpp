@@ -0,0 +1,118 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "bladerunner/slice_renderer.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace BladeRunner {
+
+// The z-buffer holds unsigned values, SSE2 only has signed 16-bit compares,
+// so both sides are biased by 0x8000 before comparing.
+
+static FORCEINLINE __m128i sliceDepthMask(__m128i zBiased, __m128i zbuf) {
+	return _mm_cmplt_epi16(zBiased, _mm_xor_si128(zbuf, _mm_set1_epi16((int16)0x8000)));
+}
+
+static FORCEINLINE __m128i sliceSelect(__m128i mask, __m128i a, __m128i b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+void drawSliceSpan16SSE2(uint16 *dst, uint16 *zbuffer, int width, uint16 z, uint16 color) {
+	const __m128i zv = _mm_set1_epi16((int16)z);
+	const __m128i zBiased = _mm_xor_si128(zv, _mm_set1_epi16((int16)0x8000));
+	const __m128i cv = _mm_set1_epi16((int16)color);
+
+	int x = 0;
+	for (; x + 8 <= width; x += 8) {
+		__m128i zbuf = _mm_loadu_si128((const __m128i *)(zbuffer + x));
+		__m128i mask = sliceDepthMask(zBiased, zbuf);
+		if (!_mm_movemask_epi8(mask))
+			continue;
+
+		_mm_storeu_si128((__m128i *)(zbuffer + x), sliceSelect(mask, zv, zbuf));
+		__m128i d = _mm_loadu_si128((const __m128i *)(dst + x));
+		_mm_storeu_si128((__m128i *)(dst + x), sliceSelect(mask, cv, d));
+	}
+
+	for (; x < width; ++x) {
+		if (z < zbuffer[x]) {
+			zbuffer[x] = z;
+			dst[x] = color;
+		}
+	}
+}
+
+void drawSliceSpan32SSE2(uint32 *dst, uint16 *zbuffer, int width, uint16 z, uint32 color) {
+	const __m128i zv = _mm_set1_epi16((int16)z);
+	const __m128i zBiased = _mm_xor_si128(zv, _mm_set1_epi16((int16)0x8000));
+	const __m128i cv = _mm_set1_epi32((int32)color);
+
+	int x = 0;
+	for (; x + 8 <= width; x += 8) {
+		__m128i zbuf = _mm_loadu_si128((const __m128i *)(zbuffer + x));
+		__m128i mask = sliceDepthMask(zBiased, zbuf);
+		if (!_mm_movemask_epi8(mask))
+			continue;
+
+		_mm_storeu_si128((__m128i *)(zbuffer + x), sliceSelect(mask, zv, zbuf));
+
+		// Widen the 16-bit lane masks to the 32-bit pixels
+		__m128i maskLo = _mm_unpacklo_epi16(mask, mask);
+		__m128i maskHi = _mm_unpackhi_epi16(mask, mask);
+		__m128i dLo = _mm_loadu_si128((const __m128i *)(dst + x));
+		__m128i dHi = _mm_loadu_si128((const __m128i *)(dst + x + 4));
+		_mm_storeu_si128((__m128i *)(dst + x), sliceSelect(maskLo, cv, dLo));
+		_mm_storeu_si128((__m128i *)(dst + x + 4), sliceSelect(maskHi, cv, dHi));
+	}
+
+	for (; x < width; ++x) {
+		if (z < zbuffer[x]) {
+			zbuffer[x] = z;
+			dst[x] = color;
+		}
+	}
+}
+
+} // End of namespace BladeRunner
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
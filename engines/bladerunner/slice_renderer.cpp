@@ -29,6 +29,7 @@
 
 #include "common/memstream.h"
 #include "common/rect.h"
+#include "common/system.h"
 #include "common/util.h"
 
 namespace BladeRunner {
@@ -36,6 +37,11 @@ namespace BladeRunner {
 SliceRenderer::SliceRenderer(BladeRunnerEngine *vm) {
 	_vm = vm;
 	_pixelFormat = screenPixelFormat();
+#ifdef SCUMMVM_SSE2
+	_useSSE2 = g_system->hasFeature(OSystem::kFeatureCpuSSE2);
+#else
+	_useSSE2 = false;
+#endif
 
 	// original game is going just up to 942 and not 997
 	for (int i = 0; i < ARRAYSIZE(_animationsShadowEnabled); ++i) {
@@ -537,6 +543,16 @@ void SliceRenderer::drawOnScreen(int animationId, int animationFrame, int screen
 	}
 }
 
+template<typename PixelType>
+static void drawSliceSpan(PixelType *dst, uint16 *zbuffer, int width, uint16 z, PixelType color) {
+	for (int x = 0; x < width; ++x) {
+		if (z < zbuffer[x]) {
+			zbuffer[x] = z;
+			dst[x] = color;
+		}
+	}
+}
+
 void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine) {
 	if (slice < 0 || (uint32)slice >= _frameSliceCount) {
 		return;
@@ -544,6 +560,8 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 
 	SliceAnimations::Palette &palette = _vm->_sliceAnimations->getPalette(_framePaletteIndex);
 
+	byte *dstLine = (byte *)surface.getBasePtr(0, CLIP(y, 0, surface.h - 1));
+
 	byte *p = (byte *)_sliceFramePtr + 0x20 + 4 * slice;
 
 	uint32 polyOffset = READ_LE_UINT32(p);
@@ -585,11 +603,41 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 						outColor = _pixelFormat.RGBToColor(Color::get8BitColorFrom5Bit(color.r), Color::get8BitColorFrom5Bit(color.g), Color::get8BitColorFrom5Bit(color.b));
 					}
 
-					for (int x = previousVertexX; x != vertexX; ++x) {
+					// The span is drawn directly on the surface line, only the part
+					// beyond the surface width (if any) is clipped per pixel
+					int spanEnd = MIN<int>(vertexX, surface.w);
+					int width = spanEnd - previousVertexX;
+					if (width > 0) {
+						switch (surface.format.bytesPerPixel) {
+						case 2:
+#ifdef SCUMMVM_SSE2
+							if (_useSSE2) {
+								drawSliceSpan16SSE2((uint16 *)dstLine + previousVertexX, zbufferLine + previousVertexX, width, vertexZ, outColor);
+								break;
+							}
+#endif
+							drawSliceSpan<uint16>((uint16 *)dstLine + previousVertexX, zbufferLine + previousVertexX, width, vertexZ, outColor);
+							break;
+						case 4:
+#ifdef SCUMMVM_SSE2
+							if (_useSSE2) {
+								drawSliceSpan32SSE2((uint32 *)dstLine + previousVertexX, zbufferLine + previousVertexX, width, vertexZ, outColor);
+								break;
+							}
+#endif
+							drawSliceSpan<uint32>((uint32 *)dstLine + previousVertexX, zbufferLine + previousVertexX, width, vertexZ, outColor);
+							break;
+						default:
+							drawSliceSpan<uint8>(dstLine + previousVertexX, zbufferLine + previousVertexX, width, vertexZ, outColor);
+							break;
+						}
+					}
+
+					for (int x = MAX(spanEnd, previousVertexX); x < vertexX; ++x) {
 						if (vertexZ < zbufferLine[x]) {
 							zbufferLine[x] = (uint16)vertexZ;
 
-							void *dstPtr = surface.getBasePtr(CLIP(x, 0, surface.w - 1), CLIP(y, 0, surface.h - 1));
+							void *dstPtr = surface.getBasePtr(surface.w - 1, CLIP(y, 0, surface.h - 1));
 							drawPixel(surface, dstPtr, outColor);
 						}
 					}
@@ -90,6 +90,8 @@ class SliceRenderer {
 
 	Graphics::PixelFormat _pixelFormat;
 
+	bool _useSSE2;
+
 public:
 	SliceRenderer(BladeRunnerEngine *vm);
 	~SliceRenderer();
@@ -118,6 +120,12 @@ private:
 	void drawShadowPolygon(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 };
 
+#ifdef SCUMMVM_SSE2
+// slice_renderer-sse2.cpp
+void drawSliceSpan16SSE2(uint16 *dst, uint16 *zbuffer, int width, uint16 z, uint16 color);
+void drawSliceSpan32SSE2(uint32 *dst, uint16 *zbuffer, int width, uint16 z, uint32 color);
+#endif
+
 class SliceRendererLights {
 	Lights *_lights;
 	Color   _cacheColor[20];
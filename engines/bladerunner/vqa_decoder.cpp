@@ -140,6 +140,11 @@ VQADecoder::VQADecoder() {
 	_header.unk5         = 0;
 	_readingFrame        = -1;
 	_decodingFrame       = -1;
+	_framesRead          = 0;
+	_framesDecoded       = 0;
+	_readTime            = 0;
+	_decodeTime          = 0;
+	_maxDecodeTime       = 0;
 	_vqpPalsArr          = nullptr;
 	_numOfVQPPalettes    = 0;
 	_oldV2VQA                 = false;
@@ -154,6 +159,16 @@ VQADecoder::~VQADecoder() {
 }
 
 void VQADecoder::close() {
+	if (_framesDecoded) {
+		debugC(kDebugVideo, "VQADecoder: %u frames read in %u ms, %u frames decoded in %u ms, slowest decode %u ms",
+			_framesRead, _readTime, _framesDecoded, _decodeTime, _maxDecodeTime);
+	}
+	_framesRead    = 0;
+	_framesDecoded = 0;
+	_readTime      = 0;
+	_decodeTime    = 0;
+	_maxDecodeTime = 0;
+
 	for (uint i = _codebooks.size(); i != 0; --i) {
 		delete[] _codebooks[i - 1].data;
 	}
@@ -233,7 +248,14 @@ void VQADecoder::overrideOffsetXY(uint16 offX, uint16 offY) {
 
 void VQADecoder::decodeVideoFrame(Graphics::Surface *surface, int frame, bool forceDraw) {
 	_decodingFrame = frame;
+
+	uint32 startTime = g_system->getMillis();
 	_videoTrack->decodeVideoFrame(surface, forceDraw);
+	uint32 decodeTime = g_system->getMillis() - startTime;
+
+	_decodeTime += decodeTime;
+	_maxDecodeTime = MAX(_maxDecodeTime, decodeTime);
+	++_framesDecoded;
 }
 
 void VQADecoder::decodeZBuffer(ZBuffer *zbuffer) {
@@ -302,7 +324,11 @@ void VQADecoder::readFrame(int frame, uint readFlags) {
 	_s->seek(frameOffset);
 
 	_readingFrame = frame;
+
+	uint32 startTime = g_system->getMillis();
 	readPacket(readFlags);
+	_readTime += g_system->getMillis() - startTime;
+	++_framesRead;
 }
 
 bool VQADecoder::readVQHD(Common::SeekableReadStream *s, uint32 size) {
@@ -702,6 +728,7 @@ VQADecoder::VQAVideoTrack::VQAVideoTrack(VQADecoder *vqaDecoder) {
 	_numFrames = header->numFrames;
 	_width     = header->width;
 	_height    = header->height;
+	_bpp       = screenPixelFormat().bytesPerPixel;
 	_blockW    = header->blockW;
 	_blockH    = header->blockH;
 	_frameRate = header->frameRate;
@@ -1137,8 +1164,20 @@ bool VQADecoder::VQAVideoTrack::readVPTR(Common::SeekableReadStream *s, uint32 s
 	return true;
 }
 
+// Blocks are small (4x2 in the game videos), so the row copy is given a fixed
+// size for the common cases and compiles to a single 8 or 16 byte move
+template<uint RowSize>
+static inline void copyBlock(uint8 *dst, const uint8 *src, uint pitch, uint height) {
+	for (uint y = height; y != 0; --y) {
+		memcpy(dst, src, RowSize);
+		dst += pitch;
+		src += RowSize;
+	}
+}
+
 void VQADecoder::VQAVideoTrack::VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha) {
-	uint bpp = screenPixelFormat().bytesPerPixel;
+	const uint bpp = _bpp;
+	const uint rowSize = _blockW * bpp;
 
 	const uint8 *const block_src = &_codebook[bpp *  srcBlock  * _blockW * _blockH];
 	const uint8 *const mask_base = &_codebook[bpp * _maxBlocks * _blockW * _blockH];
@@ -1146,21 +1185,33 @@ void VQADecoder::VQAVideoTrack::VPTRWriteBlock(Graphics::Surface *surface, unsig
 
 	uint16 blocks_per_line = _width / _blockW;
 
-	uint32 intermDiv = 0;
-	uint32 dst_x = 0;
-	uint32 dst_y = 0;
+	// Walk the destination blocks, only dividing once to find the first one
+	uint32 block_y = dstBlock / blocks_per_line;
+	uint32 block_x = dstBlock - block_y * blocks_per_line;
+	uint8 *dstPtr = (uint8 *)surface->getBasePtr(block_x * _blockW + _offsetX, block_y * _blockH + _offsetY);
 
 	for (uint i = count; i != 0; --i) {
-		intermDiv = (dstBlock + count - i) / blocks_per_line; // start of current blocks line
-		dst_x = ((dstBlock + count - i) - intermDiv * blocks_per_line) * _blockW + _offsetX;
-		dst_y = intermDiv * _blockH + _offsetY;
-
-		uint8* dstPtr = (uint8 *)surface->getBasePtr(dst_x, dst_y);
 		if (alpha) {
 			// Use mask to blit
-			Graphics::maskBlit(dstPtr, block_src, mask_src, surface->pitch, _blockW * bpp, _blockW, _blockW, _blockH, bpp);
+			Graphics::maskBlit(dstPtr, block_src, mask_src, surface->pitch, rowSize, _blockW, _blockW, _blockH, bpp);
+		} else if (rowSize == 8) {
+			copyBlock<8>(dstPtr, block_src, surface->pitch, _blockH);
+		} else if (rowSize == 16) {
+			copyBlock<16>(dstPtr, block_src, surface->pitch, _blockH);
+		} else {
+			Graphics::copyBlit(dstPtr, block_src, surface->pitch, rowSize, _blockW, _blockH, bpp);
+		}
+
+		if (i == 1) {
+			break;
+		}
+
+		if (++block_x == blocks_per_line) {
+			block_x = 0;
+			++block_y;
+			dstPtr = (uint8 *)surface->getBasePtr(_offsetX, block_y * _blockH + _offsetY);
 		} else {
-			Graphics::copyBlit(dstPtr, block_src, surface->pitch, _blockW * bpp, _blockW, _blockH, bpp);
+			dstPtr += rowSize;
 		}
 	}
 }
@@ -185,6 +185,13 @@ public:
 	VQAVideoTrack *_videoTrack;
 	VQAAudioTrack *_audioTrack;
 
+	// Decoding time of the current video, in milliseconds
+	uint32 _framesRead;
+	uint32 _framesDecoded;
+	uint32 _readTime;
+	uint32 _decodeTime;
+	uint32 _maxDecodeTime;
+
 	void readPacket(uint readFlags);
 
 	bool readVQHD(Common::SeekableReadStream *s, uint32 size);
@@ -241,6 +248,7 @@ public:
 
 		uint16 _numFrames;
 		uint16 _width, _height;
+		uint8  _bpp;
 		uint8  _blockW, _blockH;
 		uint8  _frameRate;
 		uint8  _cbParts;
@@ -43,12 +43,14 @@
 
 namespace Director {
 
+// Number of differently sized mattes kept per bitmap
+static const uint kMaxCachedMattes = 4;
+
 BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Common::SeekableReadStreamEndian &stream, uint32 castTag, uint16 version, uint8 flags1)
 		: CastMember(cast, castId, stream) {
 	_type = kCastBitmap;
 	_picture = new Picture();
 	_ditheredImg = nullptr;
-	_matte = nullptr;
 	_noMatte = false;
 	_bytes = 0;
 	_pitch = 0;
@@ -244,7 +246,6 @@ BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Common::SeekableRe
 BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Image::ImageDecoder *img, uint8 flags1)
 	: CastMember(cast, castId) {
 	_type = kCastBitmap;
-	_matte = nullptr;
 	_noMatte = false;
 	_bytes = 0;
 	if (img != nullptr) {
@@ -282,7 +283,6 @@ BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, BitmapCastMember &
 
 	_picture = source._picture ? new Picture(*source._picture) : nullptr;
 	_ditheredImg = nullptr;
-	_matte = nullptr;
 
 	_pitch = source._pitch;
 	_regX = source._regX;
@@ -298,7 +298,6 @@ BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, BitmapCastMember &
 	_bitsPerPixel = source._bitsPerPixel;
 
 	_tag = source._tag;
-	_matte = nullptr;
 	_noMatte = false;
 	_external = source._external;
 
@@ -316,11 +315,7 @@ BitmapCastMember::~BitmapCastMember() {
 		_ditheredImg = nullptr;
 	}
 
-	if (_matte) {
-		_matte->free();
-		delete _matte;
-		_matte = nullptr;
-	}
+	clearMattes();
 }
 
 Graphics::MacWidget *BitmapCastMember::createWidget(Common::Rect &bbox, Channel *channel, SpriteType spriteType) {
@@ -548,7 +543,7 @@ bool BitmapCastMember::isModified() {
 	return false;
 }
 
-void BitmapCastMember::createMatte(const Common::Rect &bbox) {
+Graphics::Surface *BitmapCastMember::createMatte(const Common::Rect &bbox) {
 	// Like background trans, but all white pixels NOT ENCLOSED by coloured pixels
 	// are transparent
 	Graphics::Surface tmp;
@@ -561,6 +556,7 @@ void BitmapCastMember::createMatte(const Common::Rect &bbox) {
 	// Searching white color in the corners
 	uint32 whiteColor = 0;
 	bool colorFound = false;
+	Graphics::Surface *matte = nullptr;
 	const byte *palette = g_director->getPalette();
 
 	if (tmp.format.isCLUT8()) {
@@ -590,12 +586,6 @@ void BitmapCastMember::createMatte(const Common::Rect &bbox) {
 		debugC(1, kDebugImages, "BitmapCastMember::createMatte(): No white color for matte image cast %d, name %s", _castId, _name.c_str());
 	} else {
 		debugC(1, kDebugImages, "BitmapCastMember::createMatte(): Will create matte for cast %d, name %s, whiteColor: 0x%08x", _castId, _name.c_str(), whiteColor);
-		if (_matte) {
-			_matte->free();
-			delete _matte;
-			_matte = nullptr;
-		}
-
 		Graphics::FloodFill matteFill(&tmp, whiteColor, 0, true);
 
 		for (int yy = 0; yy < tmp.h; yy++) {
@@ -612,42 +602,72 @@ void BitmapCastMember::createMatte(const Common::Rect &bbox) {
 		Graphics::Surface *matteSurf = matteFill.getMask();
 		// convert the mask to the same surface format used for 1bpp bitmaps.
 		// this uses the director palette scheme, so white is 0x00 and black is 0xff.
-		_matte = new Graphics::Surface();
-		_matte->create(matteSurf->w, matteSurf->h, Graphics::PixelFormat::createFormatCLUT8());
+		matte = new Graphics::Surface();
+		matte->create(matteSurf->w, matteSurf->h, Graphics::PixelFormat::createFormatCLUT8());
 		for (int y = 0; y < matteSurf->h; y++) {
 			for (int x = 0; x < matteSurf->w; x++) {
-				_matte->setPixel(x, y, matteSurf->getPixel(x, y) ? 0x00 : 0xff);
+				matte->setPixel(x, y, matteSurf->getPixel(x, y) ? 0x00 : 0xff);
 			}
 		}
 		_noMatte = false;
+
+		// Keep the mattes of the most recently used sizes around, so sprites
+		// stretched to different sizes don't have to flood fill on every frame.
+		// The least recently used one is at the front
+		if (_mattes.size() >= kMaxCachedMattes) {
+			_mattes[0]->free();
+			delete _mattes[0];
+			_mattes.remove_at(0);
+		}
+		_mattes.push_back(matte);
 	}
 
 	tmp.free();
+
+	return matte;
+}
+
+void BitmapCastMember::clearMattes() {
+	for (auto &matte : _mattes) {
+		matte->free();
+		delete matte;
+	}
+	_mattes.clear();
+	_noMatte = false;
 }
 
 Graphics::Surface *BitmapCastMember::getMatte(const Common::Rect &bbox) {
+	// Mattes only depend on the picture and the size it's drawn at,
+	// so they stay valid until the picture changes. The mattes are kept
+	// from the least to the most recently used, so a hit moves to the back
+	for (uint i = 0; i < _mattes.size(); i++) {
+		Graphics::Surface *matte = _mattes[i];
+		if (matte->w == bbox.width() && matte->h == bbox.height()) {
+			_mattes.remove_at(i);
+			_mattes.push_back(matte);
+			return matte;
+		}
+	}
+
 	// Lazy loading of mattes
-	if (!_matte && !_noMatte) {
-		createMatte(bbox);
+	if (_noMatte)
+		return nullptr;
 
-		if (ConfMan.getBool("dump_scripts") && _matte) {
-			Common::String prepend = _cast->getMacName();
-			Common::String filename = Common::String::format("./dumps/%s-%s-%d-matte.png", encodePathForDump(prepend).c_str(), tag2str(_tag), _castId);
-			Common::DumpFile bitmapFile;
+	bool firstMatte = _mattes.empty();
+	Graphics::Surface *matte = createMatte(bbox);
 
-			bitmapFile.open(Common::Path(filename), true);
-			Image::writePNG(bitmapFile, *_matte, Video::quickTimeDefaultPalette256);
+	if (firstMatte && ConfMan.getBool("dump_scripts") && matte) {
+		Common::String prepend = _cast->getMacName();
+		Common::String filename = Common::String::format("./dumps/%s-%s-%d-matte.png", encodePathForDump(prepend).c_str(), tag2str(_tag), _castId);
+		Common::DumpFile bitmapFile;
 
-			bitmapFile.close();
-		}
-	}
+		bitmapFile.open(Common::Path(filename), true);
+		Image::writePNG(bitmapFile, *matte, Video::quickTimeDefaultPalette256);
 
-	// check for the scale matte
-	if (_matte && (_matte->w != bbox.width() || _matte->h != bbox.height())) {
-		createMatte(bbox);
+		bitmapFile.close();
 	}
 
-	return _matte;
+	return matte;
 }
 
 Common::String BitmapCastMember::formatInfo() {
@@ -866,6 +886,8 @@ void BitmapCastMember::unload() {
 		_ditheredImg = nullptr;
 	}
 
+	clearMattes();
+
 	_loaded = false;
 }
 
@@ -891,6 +913,8 @@ void BitmapCastMember::setPicture(PictureReference &picture) {
 		_ditheredImg = nullptr;
 	}
 
+	clearMattes();
+
 	// Make sure we get redrawn
 	setModified(true);
 	// TODO: Should size be adjusted?
@@ -903,6 +927,7 @@ void BitmapCastMember::setPicture(Image::ImageDecoder &image, bool adjustSize) {
 		auto surf = image.getSurface();
 		_size = surf->pitch * surf->h + _picture->getPaletteSize();
 	}
+	clearMattes();
 	// Make sure we get redrawn
 	setModified(true);
 }
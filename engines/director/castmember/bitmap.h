@@ -43,8 +43,9 @@ public:
 	Graphics::MacWidget *createWidget(Common::Rect &bbox, Channel *channel, SpriteType spriteType) override;
 
 	bool isModified() override;
-	void createMatte(const Common::Rect &bbox);
+	Graphics::Surface *createMatte(const Common::Rect &bbox);
 	Graphics::Surface *getMatte(const Common::Rect &bbox);
+	void clearMattes();
 	Graphics::Surface *getDitherImg();
 
 	bool hasField(int field) override;
@@ -74,7 +75,7 @@ public:
 
 	Picture *_picture = nullptr;
 	Graphics::Surface *_ditheredImg;
-	Graphics::Surface *_matte;
+	Common::Array<Graphics::Surface *> _mattes;
 
 	int _version;
 
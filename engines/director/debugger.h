@@ -73,6 +73,8 @@ public:
 	~Debugger();
 	void debugLogFile(Common::String logs, bool prompt);
 	void stepHook();
+	// Whether stepHook() has to be called for every Lingo instruction
+	bool isStepHookActive() const { return _step || _finish || _bpCheckFunc || _bpCheckMoviePath; }
 	void frameHook();
 	void movieHook();
 	void eventHook(LEvent eventId);
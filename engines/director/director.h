@@ -409,6 +409,16 @@ struct DirectorPlotData {
 	}
 };
 
+// Vectorized row compositors for blend and arithmetic inks on 32-bit surfaces
+#ifdef SCUMMVM_SSE2
+// graphics-sse2.cpp
+void inkBlitSpanSSE2(InkType ink, int alpha, uint32 *dst, const uint32 *src, const byte *msk, int width, uint32 rgbMask, uint32 alphaMask);
+#endif
+#ifdef SCUMMVM_NEON
+// graphics-neon.cpp
+void inkBlitSpanNEON(InkType ink, int alpha, uint32 *dst, const uint32 *src, const byte *msk, int width, uint32 rgbMask, uint32 alphaMask);
+#endif
+
 extern DirectorEngine *g_director;
 extern Debugger *g_debugger;
 
@@ -0,0 +1,164 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "director/director.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Director {
+
+// See graphics-sse2.cpp
+template<int Ink>
+static FORCEINLINE uint8x16_t inkOp(uint8x16_t s, uint8x16_t d, uint8x8_t alpha, uint8x8_t invAlpha) {
+	switch (Ink) {
+	case kInkTypeBlend: {
+		// (d * alpha + s * (255 - alpha)) / 255, see lerpByte()
+		uint16x8_t lo = vmlal_u8(vmull_u8(vget_low_u8(d), alpha), vget_low_u8(s), invAlpha);
+		uint16x8_t hi = vmlal_u8(vmull_u8(vget_high_u8(d), alpha), vget_high_u8(s), invAlpha);
+		// Exact division by 255 for x <= 255 * 255: (x + 1 + (x >> 8)) >> 8
+		const uint16x8_t one = vdupq_n_u16(1);
+		lo = vshrq_n_u16(vaddq_u16(vaddq_u16(lo, one), vshrq_n_u16(lo, 8)), 8);
+		hi = vshrq_n_u16(vaddq_u16(vaddq_u16(hi, one), vshrq_n_u16(hi, 8)), 8);
+		return vcombine_u8(vmovn_u16(lo), vmovn_u16(hi));
+	}
+	case kInkTypeAddPin:
+		return vqaddq_u8(d, s);
+	case kInkTypeAdd:
+		return vaddq_u8(d, s);
+	case kInkTypeSubPin:
+		return vqsubq_u8(vqsubq_u8(d, s), vdupq_n_u8(1));
+	case kInkTypeLight:
+		return vmaxq_u8(s, d);
+	case kInkTypeSub:
+		return vsubq_u8(d, s);
+	case kInkTypeDark:
+	default:
+		return vminq_u8(s, d);
+	}
+}
+
+template<int Ink>
+static void inkSpan(uint32 *dst, const uint32 *src, const byte *msk, int width, int alpha, uint32 rgbMask, uint32 alphaMask) {
+	const uint8x16_t rgbMaskVec = vreinterpretq_u8_u32(vdupq_n_u32(rgbMask));
+	const uint8x16_t alphaMaskVec = vreinterpretq_u8_u32(vdupq_n_u32(alphaMask));
+	const uint8x8_t alphaVec = vdup_n_u8(alpha);
+	const uint8x8_t invAlphaVec = vdup_n_u8(255 - alpha);
+
+	uint32 srcTail[4], dstTail[4];
+	byte mskTail[4];
+
+	for (int x = 0; x < width; x += 4) {
+		const uint32 *s = src + x;
+		uint32 *d = dst + x;
+		const byte *m = msk ? msk + x : nullptr;
+		int count = MIN(width - x, 4);
+
+		// Go through a small buffer for the last few pixels of the row
+		if (count < 4) {
+			memset(srcTail, 0, sizeof(srcTail));
+			memset(dstTail, 0, sizeof(dstTail));
+			memset(mskTail, 0, sizeof(mskTail));
+			memcpy(srcTail, s, count * sizeof(uint32));
+			memcpy(dstTail, d, count * sizeof(uint32));
+			if (m)
+				memcpy(mskTail, m, count);
+			s = srcTail;
+			d = dstTail;
+			m = m ? mskTail : nullptr;
+		}
+
+		uint8x16_t sv = vreinterpretq_u8_u32(vld1q_u32(s));
+		uint8x16_t dv = vreinterpretq_u8_u32(vld1q_u32(d));
+		uint8x16_t rv = vorrq_u8(vandq_u8(inkOp<Ink>(sv, dv, alphaVec, invAlphaVec), rgbMaskVec), alphaMaskVec);
+
+		if (m) {
+			// Widen the four mask bytes to a lane mask of drawn pixels
+			uint32 draw[4] = { m[0] ? 0xffffffffu : 0, m[1] ? 0xffffffffu : 0, m[2] ? 0xffffffffu : 0, m[3] ? 0xffffffffu : 0 };
+			rv = vbslq_u8(vreinterpretq_u8_u32(vld1q_u32(draw)), rv, dv);
+		}
+
+		vst1q_u32(d, vreinterpretq_u32_u8(rv));
+
+		if (count < 4)
+			memcpy(dst + x, dstTail, count * sizeof(uint32));
+	}
+}
+
+void inkBlitSpanNEON(InkType ink, int alpha, uint32 *dst, const uint32 *src, const byte *msk, int width, uint32 rgbMask, uint32 alphaMask) {
+	// A blend factor takes precedence over the ink, like in InkPrimitives::drawPoint()
+	if (alpha) {
+		inkSpan<kInkTypeBlend>(dst, src, msk, width, alpha, rgbMask, alphaMask);
+		return;
+	}
+
+	switch (ink) {
+	case kInkTypeAddPin:
+		inkSpan<kInkTypeAddPin>(dst, src, msk, width, 0, rgbMask, alphaMask);
+		break;
+	case kInkTypeAdd:
+		inkSpan<kInkTypeAdd>(dst, src, msk, width, 0, rgbMask, alphaMask);
+		break;
+	case kInkTypeSubPin:
+		inkSpan<kInkTypeSubPin>(dst, src, msk, width, 0, rgbMask, alphaMask);
+		break;
+	case kInkTypeLight:
+		inkSpan<kInkTypeLight>(dst, src, msk, width, 0, rgbMask, alphaMask);
+		break;
+	case kInkTypeSub:
+		inkSpan<kInkTypeSub>(dst, src, msk, width, 0, rgbMask, alphaMask);
+		break;
+	case kInkTypeDark:
+		inkSpan<kInkTypeDark>(dst, src, msk, width, 0, rgbMask, alphaMask);
+		break;
+	default:
+		error("inkBlitSpanNEON(): Unsupported ink %d", ink);
+	}
+}
+
+} // End of namespace Director
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,167 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "director/director.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Director {
+
+// Arithmetic inks treat each colour channel separately, which for byte
+// aligned 32-bit formats maps onto unsigned byte lanes. Bytes outside of
+// rgbMask are replaced by alphaMask, like MacWindowManager::findBestColor() does.
+
+template<int Ink>
+static FORCEINLINE __m128i inkOp(__m128i s, __m128i d, __m128i alpha, __m128i invAlpha) {
+	switch (Ink) {
+	case kInkTypeBlend: {
+		// (d * alpha + s * (255 - alpha)) / 255, see lerpByte()
+		const __m128i zero = _mm_setzero_si128();
+		__m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), alpha), _mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), invAlpha));
+		__m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), alpha), _mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), invAlpha));
+		// Exact division by 255 for x <= 255 * 255: (x + 1 + (x >> 8)) >> 8
+		const __m128i one = _mm_set1_epi16(1);
+		lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(lo, one), _mm_srli_epi16(lo, 8)), 8);
+		hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(hi, one), _mm_srli_epi16(hi, 8)), 8);
+		return _mm_packus_epi16(lo, hi);
+	}
+	case kInkTypeAddPin:
+		return _mm_adds_epu8(d, s);
+	case kInkTypeAdd:
+		return _mm_add_epi8(d, s);
+	case kInkTypeSubPin:
+		return _mm_subs_epu8(_mm_subs_epu8(d, s), _mm_set1_epi8(1));
+	case kInkTypeLight:
+		return _mm_max_epu8(s, d);
+	case kInkTypeSub:
+		return _mm_sub_epi8(d, s);
+	case kInkTypeDark:
+	default:
+		return _mm_min_epu8(s, d);
+	}
+}
+
+template<int Ink>
+static void inkSpan(uint32 *dst, const uint32 *src, const byte *msk, int width, int alpha, uint32 rgbMask, uint32 alphaMask) {
+	const __m128i rgbMaskVec = _mm_set1_epi32(rgbMask);
+	const __m128i alphaMaskVec = _mm_set1_epi32(alphaMask);
+	const __m128i alphaVec = _mm_set1_epi16(alpha);
+	const __m128i invAlphaVec = _mm_set1_epi16(255 - alpha);
+	const __m128i zero = _mm_setzero_si128();
+
+	uint32 srcTail[4], dstTail[4];
+	byte mskTail[4];
+
+	for (int x = 0; x < width; x += 4) {
+		const uint32 *s = src + x;
+		uint32 *d = dst + x;
+		const byte *m = msk ? msk + x : nullptr;
+		int count = MIN(width - x, 4);
+
+		// Go through a small buffer for the last few pixels of the row
+		if (count < 4) {
+			memset(srcTail, 0, sizeof(srcTail));
+			memset(dstTail, 0, sizeof(dstTail));
+			memset(mskTail, 0, sizeof(mskTail));
+			memcpy(srcTail, s, count * sizeof(uint32));
+			memcpy(dstTail, d, count * sizeof(uint32));
+			if (m)
+				memcpy(mskTail, m, count);
+			s = srcTail;
+			d = dstTail;
+			m = m ? mskTail : nullptr;
+		}
+
+		__m128i sv = _mm_loadu_si128((const __m128i *)s);
+		__m128i dv = _mm_loadu_si128((const __m128i *)d);
+		__m128i rv = _mm_or_si128(_mm_and_si128(inkOp<Ink>(sv, dv, alphaVec, invAlphaVec), rgbMaskVec), alphaMaskVec);
+
+		if (m) {
+			// Widen the four mask bytes to a lane mask of untouched pixels
+			__m128i keep = _mm_cmpeq_epi8(_mm_cvtsi32_si128(READ_UINT32(m)), zero);
+			keep = _mm_unpacklo_epi8(keep, keep);
+			keep = _mm_unpacklo_epi16(keep, keep);
+			rv = _mm_or_si128(_mm_and_si128(keep, dv), _mm_andnot_si128(keep, rv));
+		}
+
+		_mm_storeu_si128((__m128i *)d, rv);
+
+		if (count < 4)
+			memcpy(dst + x, dstTail, count * sizeof(uint32));
+	}
+}
+
+void inkBlitSpanSSE2(InkType ink, int alpha, uint32 *dst, const uint32 *src, const byte *msk, int width, uint32 rgbMask, uint32 alphaMask) {
+	// A blend factor takes precedence over the ink, like in InkPrimitives::drawPoint()
+	if (alpha) {
+		inkSpan<kInkTypeBlend>(dst, src, msk, width, alpha, rgbMask, alphaMask);
+		return;
+	}
+
+	switch (ink) {
+	case kInkTypeAddPin:
+		inkSpan<kInkTypeAddPin>(dst, src, msk, width, 0, rgbMask, alphaMask);
+		break;
+	case kInkTypeAdd:
+		inkSpan<kInkTypeAdd>(dst, src, msk, width, 0, rgbMask, alphaMask);
+		break;
+	case kInkTypeSubPin:
+		inkSpan<kInkTypeSubPin>(dst, src, msk, width, 0, rgbMask, alphaMask);
+		break;
+	case kInkTypeLight:
+		inkSpan<kInkTypeLight>(dst, src, msk, width, 0, rgbMask, alphaMask);
+		break;
+	case kInkTypeSub:
+		inkSpan<kInkTypeSub>(dst, src, msk, width, 0, rgbMask, alphaMask);
+		break;
+	case kInkTypeDark:
+		inkSpan<kInkTypeDark>(dst, src, msk, width, 0, rgbMask, alphaMask);
+		break;
+	default:
+		error("inkBlitSpanSSE2(): Unsupported ink %d", ink);
+	}
+}
+
+} // End of namespace Director
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
@@ -291,88 +291,37 @@ void DirectorEngine::draw() {
 }
 
 template <typename T>
-class InkPrimitives final : public Graphics::Primitives {
-public:
-	constexpr InkPrimitives() {}
-	void drawPoint(int x, int y, uint32 src, void *data) override;
-private:
-	inline void decomposeColor(Graphics::MacWindowManager *wm, uint32 color, byte &r, byte &g, byte &b) {
-		if (sizeof(T) == sizeof(byte)) {
-			wm->getPaletteEntry(color, r, g, b);
-		} else {
-			wm->_pixelformat.colorToRGB(color, r, g, b);
-		}
+static inline void inkDecomposeColor(Graphics::MacWindowManager *wm, uint32 color, byte &r, byte &g, byte &b) {
+	if (sizeof(T) == sizeof(byte)) {
+		wm->getPaletteEntry(color, r, g, b);
+	} else {
+		wm->_pixelformat.colorToRGB(color, r, g, b);
 	}
-};
+}
 
 template <typename T>
-void InkPrimitives<T>::drawPoint(int x, int y, uint32 src, void *data) {
-	DirectorPlotData *p = (DirectorPlotData *)data;
+static FORCEINLINE void inkBlendPixel(DirectorPlotData *p, T *dst, uint32 src) {
+	// Sprite blend does not respect colourization; defaults to matte ink
 	Graphics::MacWindowManager *wm = p->d->_wm;
+	byte rSrc, gSrc, bSrc;
+	byte rDst, gDst, bDst;
 
-	if (!p->destRect.contains(x, y))
-		return;
-
-
-	T *dst;
-	uint32 tmpDst;
+	inkDecomposeColor<T>(wm, src, rSrc, gSrc, bSrc);
+	inkDecomposeColor<T>(wm, *dst, rDst, gDst, bDst);
 
-	dst = (T *)p->dst->getBasePtr(x, y);
-
-	if (p->ms) {
-		if (p->ms->pd->thickness.x > 1 || p->ms->pd->thickness.y > 1) {
-			Common::Point prevThickness = p->ms->pd->thickness;
-			int x1 = x;
-			int x2 = x1 + prevThickness.x;
-			int y1 = y;
-			int y2 = y1 + prevThickness.y;
-
-			p->ms->pd->thickness = Common::Point(1, 1);	// We do not want recursive loops
-
-			for (y = y1; y < y2; y++)
-				for (x = x1; x < x2; x++)
-					if (x >= 0 && x < p->ms->pd->surface->w && y >= 0 && y < p->ms->pd->surface->h) {
-						drawPoint(x, y, src, data);
-					}
-
-			p->ms->pd->thickness = prevThickness;
-			return;
-		}
-
-		if (p->ms->tile) {
-			int x1 = (p->ms->tileRect->left + p->ms->pd->fillOriginX + x) % p->ms->tileRect->width();
-			if (x1 < 0)
-				x1 += p->ms->tileRect->width();
-			int y1 = (p->ms->tileRect->top  + p->ms->pd->fillOriginY + y) % p->ms->tileRect->height();
-			if (y1 < 0)
-				y1 += p->ms->tileRect->height();
-
-			src = p->ms->tile->_surface.getPixel(x1, y1);
-		} else {
-			// Get the pixel that macDrawPixel will give us, but store it to apply the
-			// ink later
-			tmpDst = *dst;
-			wm->getDrawPrimitives().drawPoint(x, y, src, p->ms->pd);
-			src = *dst;
-
-			*dst = tmpDst;
-		}
-	} else if (p->alpha) {
-		// Sprite blend does not respect colourization; defaults to matte ink
-		byte rSrc, gSrc, bSrc;
-		byte rDst, gDst, bDst;
-
-		decomposeColor(wm, src, rSrc, gSrc, bSrc);
-		decomposeColor(wm, *dst, rDst, gDst, bDst);
+	rDst = lerpByte(rSrc, rDst, p->alpha, 255);
+	gDst = lerpByte(gSrc, gDst, p->alpha, 255);
+	bDst = lerpByte(bSrc, bDst, p->alpha, 255);
+	*dst = wm->findBestColor(rDst, gDst, bDst);
+}
 
-		rDst = lerpByte(rSrc, rDst, p->alpha, 255);
-		gDst = lerpByte(gSrc, gDst, p->alpha, 255);
-		bDst = lerpByte(bSrc, bDst, p->alpha, 255);
-		*dst = wm->findBestColor(rDst, gDst, bDst);
-		return;
-	}
+// Applies the ink to a single pixel. This is inlined into the row compositors
+// below with a constant ink, so the switch is resolved at compile time there.
+template <typename T>
+static FORCEINLINE void inkPixel(DirectorPlotData *p, InkType ink, T *dst, uint32 src) {
+	Graphics::MacWindowManager *wm = p->d->_wm;
 
- 	switch (p->ink) {
+	switch (ink) {
 	case kInkTypeBackgndTrans:
 		if (p->srfMask) {
 			// If there's a mask, we already dealing with transparency, so just copy the pixel.
@@ -414,7 +363,7 @@ void InkPrimitives<T>::drawPoint(int x, int y, uint32 src, void *data) {
 		} else {
 			// Find the inverse of the colour and match it back to the palette if required
 			byte rSrc, gSrc, bSrc;
-			decomposeColor(wm, src, rSrc, gSrc, bSrc);
+			inkDecomposeColor<T>(wm, src, rSrc, gSrc, bSrc);
 
 			*dst = wm->findBestColor(~rSrc, ~gSrc, ~bSrc);
 		}
@@ -506,10 +455,10 @@ void InkPrimitives<T>::drawPoint(int x, int y, uint32 src, void *data) {
 		byte rSrc, gSrc, bSrc;
 		byte rDst, gDst, bDst;
 
-		decomposeColor(wm, src, rSrc, gSrc, bSrc);
-		decomposeColor(wm, *dst, rDst, gDst, bDst);
+		inkDecomposeColor<T>(wm, src, rSrc, gSrc, bSrc);
+		inkDecomposeColor<T>(wm, *dst, rDst, gDst, bDst);
 
-		switch (p->ink) {
+		switch (ink) {
 		case kInkTypeAddPin:
 			// Add src to dst, but pinning each channel so it can't go above 0xff.
 			*dst = wm->findBestColor(rDst + MIN(0xff - rDst, (int)rSrc), gDst + MIN(0xff - gDst, (int)gSrc), bDst + MIN(0xff - bDst, (int)bSrc));
@@ -541,6 +490,225 @@ void InkPrimitives<T>::drawPoint(int x, int y, uint32 src, void *data) {
 	}
 }
 
+template <typename T>
+class InkPrimitives final : public Graphics::Primitives {
+public:
+	constexpr InkPrimitives() {}
+	void drawPoint(int x, int y, uint32 src, void *data) override;
+};
+
+template <typename T>
+void InkPrimitives<T>::drawPoint(int x, int y, uint32 src, void *data) {
+	DirectorPlotData *p = (DirectorPlotData *)data;
+	Graphics::MacWindowManager *wm = p->d->_wm;
+
+	if (!p->destRect.contains(x, y))
+		return;
+
+
+	T *dst;
+	uint32 tmpDst;
+
+	dst = (T *)p->dst->getBasePtr(x, y);
+
+	if (p->ms) {
+		if (p->ms->pd->thickness.x > 1 || p->ms->pd->thickness.y > 1) {
+			Common::Point prevThickness = p->ms->pd->thickness;
+			int x1 = x;
+			int x2 = x1 + prevThickness.x;
+			int y1 = y;
+			int y2 = y1 + prevThickness.y;
+
+			p->ms->pd->thickness = Common::Point(1, 1);	// We do not want recursive loops
+
+			for (y = y1; y < y2; y++)
+				for (x = x1; x < x2; x++)
+					if (x >= 0 && x < p->ms->pd->surface->w && y >= 0 && y < p->ms->pd->surface->h) {
+						drawPoint(x, y, src, data);
+					}
+
+			p->ms->pd->thickness = prevThickness;
+			return;
+		}
+
+		if (p->ms->tile) {
+			int x1 = (p->ms->tileRect->left + p->ms->pd->fillOriginX + x) % p->ms->tileRect->width();
+			if (x1 < 0)
+				x1 += p->ms->tileRect->width();
+			int y1 = (p->ms->tileRect->top  + p->ms->pd->fillOriginY + y) % p->ms->tileRect->height();
+			if (y1 < 0)
+				y1 += p->ms->tileRect->height();
+
+			src = p->ms->tile->_surface.getPixel(x1, y1);
+		} else {
+			// Get the pixel that macDrawPixel will give us, but store it to apply the
+			// ink later
+			tmpDst = *dst;
+			wm->getDrawPrimitives().drawPoint(x, y, src, p->ms->pd);
+			src = *dst;
+
+			*dst = tmpDst;
+		}
+	} else if (p->alpha) {
+		inkBlendPixel<T>(p, dst, src);
+		return;
+	}
+
+	inkPixel<T>(p, p->ink, dst, src);
+}
+
+// Row compositors used by inkBlitSurface(). The ink of a sprite doesn't
+// change while it is being drawn, so a compositor specialised for it is
+// picked once per sprite instead of going through drawPoint() per pixel.
+// A null mask means every pixel of the row is drawn.
+typedef void (*InkSpanFunc)(DirectorPlotData *p, void *dst, const void *src, const byte *msk, int width);
+
+static bool inkNeedsPreprocess(const DirectorPlotData *p) {
+	return p->sprite == kTextSprite || p->sprite == kButtonSprite || p->sprite == kCheckboxSprite || p->sprite == kRadioButtonSprite;
+}
+
+// Ink < 0 takes the ink from the plot data at runtime
+template <typename T, int Ink>
+static void inkSpan(DirectorPlotData *p, void *dstPtr, const void *srcPtr, const byte *msk, int width) {
+	T *dst = (T *)dstPtr;
+	const T *src = (const T *)srcPtr;
+	InkType ink = Ink < 0 ? p->ink : (InkType)Ink;
+	bool preprocess = inkNeedsPreprocess(p);
+
+	for (int x = 0; x < width; x++) {
+		if (msk && !msk[x])
+			continue;
+
+		inkPixel<T>(p, ink, &dst[x], preprocess ? p->preprocessColor(src[x]) : src[x]);
+	}
+}
+
+template <typename T>
+static void inkCopySpan(DirectorPlotData *p, void *dstPtr, const void *srcPtr, const byte *msk, int width) {
+	T *dst = (T *)dstPtr;
+	const T *src = (const T *)srcPtr;
+
+	if (!msk) {
+		memcpy(dst, src, width * sizeof(T));
+		return;
+	}
+
+	for (int x = 0; x < width; x++) {
+		if (msk[x])
+			dst[x] = src[x];
+	}
+}
+
+template <typename T>
+static void inkBlendSpan(DirectorPlotData *p, void *dstPtr, const void *srcPtr, const byte *msk, int width) {
+	T *dst = (T *)dstPtr;
+	const T *src = (const T *)srcPtr;
+	bool preprocess = inkNeedsPreprocess(p);
+
+	for (int x = 0; x < width; x++) {
+		if (msk && !msk[x])
+			continue;
+
+		inkBlendPixel<T>(p, &dst[x], preprocess ? p->preprocessColor(src[x]) : src[x]);
+	}
+}
+
+#if defined(SCUMMVM_SSE2) || defined(SCUMMVM_NEON)
+// The vector compositors work on byte lanes, so every colour channel
+// has to be a full byte
+static bool inkSpanFormatIsVectorizable(const Graphics::PixelFormat &format) {
+	return format.bytesPerPixel == 4 && format.rLoss == 0 && format.gLoss == 0 && format.bLoss == 0 &&
+		format.rShift % 8 == 0 && format.gShift % 8 == 0 && format.bShift % 8 == 0 &&
+		(format.aLoss == 8 || (format.aLoss == 0 && format.aShift % 8 == 0));
+}
+#endif
+
+#ifdef SCUMMVM_SSE2
+static void inkSpanSSE2(DirectorPlotData *p, void *dst, const void *src, const byte *msk, int width) {
+	const Graphics::PixelFormat &format = p->d->_wm->_pixelformat;
+	inkBlitSpanSSE2(p->ink, CLIP(p->alpha, 0, 255), (uint32 *)dst, (const uint32 *)src, msk, width,
+		format.ARGBToColor(0, 0xff, 0xff, 0xff), format.ARGBToColor(0xff, 0, 0, 0));
+}
+#endif
+
+#ifdef SCUMMVM_NEON
+static void inkSpanNEON(DirectorPlotData *p, void *dst, const void *src, const byte *msk, int width) {
+	const Graphics::PixelFormat &format = p->d->_wm->_pixelformat;
+	inkBlitSpanNEON(p->ink, CLIP(p->alpha, 0, 255), (uint32 *)dst, (const uint32 *)src, msk, width,
+		format.ARGBToColor(0, 0xff, 0xff, 0xff), format.ARGBToColor(0xff, 0, 0, 0));
+}
+#endif
+
+// Returns the vectorized compositor for blend and arithmetic inks, if there's one
+template <typename T>
+static InkSpanFunc getVectorInkSpan(DirectorPlotData *p) {
+#if defined(SCUMMVM_SSE2) || defined(SCUMMVM_NEON)
+	// Colourized text needs preprocessColor() on each pixel
+	if (sizeof(T) != 4 || inkNeedsPreprocess(p) || !inkSpanFormatIsVectorizable(p->d->_wm->_pixelformat))
+		return nullptr;
+
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		return inkSpanNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		return inkSpanSSE2;
+#endif
+#endif
+
+	return nullptr;
+}
+
+template <typename T>
+static InkSpanFunc getInkSpan(DirectorPlotData *p) {
+	InkSpanFunc vectorSpan;
+
+	if (p->alpha) {
+		vectorSpan = getVectorInkSpan<T>(p);
+		return vectorSpan ? vectorSpan : inkBlendSpan<T>;
+	}
+
+	switch (p->ink) {
+	case kInkTypeCopy:
+	case kInkTypeMatte:
+	case kInkTypeBlend:
+		if (!p->applyColor)
+			return inkCopySpan<T>;
+		return inkSpan<T, kInkTypeCopy>;
+	case kInkTypeMask:
+		if (!p->applyColor && !inkNeedsPreprocess(p))
+			return inkCopySpan<T>;
+		return inkSpan<T, kInkTypeCopy>;
+	case kInkTypeTransparent:
+		return inkSpan<T, kInkTypeTransparent>;
+	case kInkTypeReverse:
+		return inkSpan<T, kInkTypeReverse>;
+	case kInkTypeGhost:
+		return inkSpan<T, kInkTypeGhost>;
+	case kInkTypeNotCopy:
+		return inkSpan<T, kInkTypeNotCopy>;
+	case kInkTypeNotTrans:
+		return inkSpan<T, kInkTypeNotTrans>;
+	case kInkTypeNotReverse:
+		return inkSpan<T, kInkTypeNotReverse>;
+	case kInkTypeNotGhost:
+		return inkSpan<T, kInkTypeNotGhost>;
+	case kInkTypeBackgndTrans:
+		return inkSpan<T, kInkTypeBackgndTrans>;
+	case kInkTypeAddPin:
+	case kInkTypeAdd:
+	case kInkTypeSubPin:
+	case kInkTypeLight:
+	case kInkTypeSub:
+	case kInkTypeDark:
+		vectorSpan = getVectorInkSpan<T>(p);
+		return vectorSpan ? vectorSpan : inkSpan<T, -1>;
+	default:
+		return inkSpan<T, -1>;
+	}
+}
+
 Graphics::Primitives *DirectorEngine::getInkPrimitives() {
 	if (!_primitives) {
 		if (_pixelformat.bytesPerPixel == 1)
@@ -779,40 +947,75 @@ void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Sur
 	// format as the window manager. Most of the time this is
 	// the job of BitmapCastMember::createWidget.
 
-	Graphics::Primitives *primitives = g_director->getInkPrimitives();
+	int bpp = d->_wm->_pixelformat.bytesPerPixel;
 
-	srcPoint.y = abs(srcRect.top - destRect.top);
-	for (int i = 0; i < destRect.height(); i++, srcPoint.y++) {
-		srcPoint.x = abs(srcRect.left - destRect.left);
-		const byte *msk = mask ? (const byte *)mask->getBasePtr(srcPoint.x, srcPoint.y) : nullptr;
+	if (!ms && (bpp == 1 || bpp == 4)) {
+		InkSpanFunc span = (bpp == 1) ? getInkSpan<byte>(this) : getInkSpan<uint32>(this);
+		int srcX = abs(srcRect.left - destRect.left);
+		int srcY = abs(srcRect.top - destRect.top);
+		int width = destRect.width();
 
-		if (srfMask) {
-			if (srcPoint.y >= srfMask->h)
-				continue;
+		// Pixels past the right edge of the source are skipped, so clip the
+		// spans instead of checking every pixel
+		int spanWidth = CLIP<int>(srfClip.right - srcX, 0, width);
+		if (srfMask)
+			spanWidth = MIN<int>(spanWidth, MAX<int>(srfMask->w - srcX, 0));
 
-			msk = (const byte *)srfMask->getBasePtr(srcPoint.x, srcPoint.y);
-		}
+		for (int i = 0; i < destRect.height(); i++, srcY++) {
+			const byte *msk = mask ? (const byte *)mask->getBasePtr(srcX, srcY) : nullptr;
+
+			if (srfMask) {
+				if (srcY >= srfMask->h)
+					continue;
 
-		for (int j = 0; j < destRect.width(); j++, srcPoint.x++) {
-			if (!srfClip.contains(srcPoint)) {
+				msk = (const byte *)srfMask->getBasePtr(srcX, srcY);
+			}
+
+			if (width > 0 && (srcY >= srfClip.bottom || srcX + width > srfClip.right))
 				failedBoundsCheck = true;
+
+			if (srcY >= srfClip.bottom)
 				continue;
+
+			if (spanWidth > 0)
+				span(this, dst->getBasePtr(destRect.left, destRect.top + i), srf->getBasePtr(srcX, srcY), msk, spanWidth);
+		}
+	} else {
+		Graphics::Primitives *primitives = g_director->getInkPrimitives();
+
+		srcPoint.y = abs(srcRect.top - destRect.top);
+		for (int i = 0; i < destRect.height(); i++, srcPoint.y++) {
+			srcPoint.x = abs(srcRect.left - destRect.left);
+			const byte *msk = mask ? (const byte *)mask->getBasePtr(srcPoint.x, srcPoint.y) : nullptr;
+
+			if (srfMask) {
+				if (srcPoint.y >= srfMask->h)
+					continue;
+
+				msk = (const byte *)srfMask->getBasePtr(srcPoint.x, srcPoint.y);
 			}
 
-			// Do not try render beyond the mask bounds
-			if (srfMask && (srcPoint.x >= srfMask->w))
-				continue;
+			for (int j = 0; j < destRect.width(); j++, srcPoint.x++) {
+				if (!srfClip.contains(srcPoint)) {
+					failedBoundsCheck = true;
+					continue;
+				}
 
-			if (!(mask || srfMask) || (msk && (*msk++))) {
-				if (d->_wm->_pixelformat.bytesPerPixel == 1) {
-					primitives->drawPoint(destRect.left + j, destRect.top + i,
-										preprocessColor(*((byte *)srf->getBasePtr(srcPoint.x, srcPoint.y))), this);
-				} else if (d->_wm->_pixelformat.bytesPerPixel == 2) {
-					primitives->drawPoint(destRect.left + j, destRect.top + i,
-										preprocessColor(*((uint16 *)srf->getBasePtr(srcPoint.x, srcPoint.y))), this);
-				} else {
-					primitives->drawPoint(destRect.left + j, destRect.top + i,
-										preprocessColor(*((uint32 *)srf->getBasePtr(srcPoint.x, srcPoint.y))), this);
+				// Do not try render beyond the mask bounds
+				if (srfMask && (srcPoint.x >= srfMask->w))
+					continue;
+
+				if (!(mask || srfMask) || (msk && (*msk++))) {
+					if (d->_wm->_pixelformat.bytesPerPixel == 1) {
+						primitives->drawPoint(destRect.left + j, destRect.top + i,
+											preprocessColor(*((byte *)srf->getBasePtr(srcPoint.x, srcPoint.y))), this);
+					} else if (d->_wm->_pixelformat.bytesPerPixel == 2) {
+						primitives->drawPoint(destRect.left + j, destRect.top + i,
+											preprocessColor(*((uint16 *)srf->getBasePtr(srcPoint.x, srcPoint.y))), this);
+					} else {
+						primitives->drawPoint(destRect.left + j, destRect.top + i,
+											preprocessColor(*((uint32 *)srf->getBasePtr(srcPoint.x, srcPoint.y))), this);
+					}
 				}
 			}
 		}
@@ -627,9 +627,41 @@ Common::String Lingo::formatFunctionBody(Symbol &sym) {
 	return result;
 }
 
+bool Lingo::canExecuteFast() {
+	// Per-instruction tracing, the debugger's step/breakpoint checks and the
+	// ImGui debugger's stepping need the slow path. debugChannelSet() levels are
+	// monotonic, so checking the lowest level used by execute() covers the others.
+	return !debugChannelSet(4, kDebugLingoExec) && !debugChannelSet(-1, kDebugFewFramesOnly) &&
+		!g_debugger->isStepHookActive() && !_exec._shouldPause;
+}
+
+uint Lingo::executeFast(int targetFrame) {
+	uint count = 0;
+
+	while (count < kLingoFastBatchSize) {
+		ScriptData *script = _state->script;
+		inst func = (*script)[_state->pc];
+		if (func == STOP)
+			break;
+
+		_state->pc++;
+		(*func)();
+		count++;
+
+		if (_abort || _freezeState || _playDone || _state->script == nullptr)
+			break;
+		if (_state->pc >= _state->script->size())
+			break;
+		if (targetFrame != -1 && (int)_state->callstack.size() == targetFrame)
+			break;
+	}
+
+	return count;
+}
+
 bool Lingo::execute(int targetFrame) {
-	uint localCounter = 0;
-	uint lastUpdate = 0;
+	uint32 lastPoll = g_system->getMillis();
+	uint32 lastUpdate = lastPoll;
 
 	while (!_abort && !_freezeState && !_playDone && _state->script && (*_state->script)[_state->pc] != STOP) {
 		if (targetFrame != -1 && (int)_state->callstack.size() == targetFrame)
@@ -655,7 +687,9 @@ bool Lingo::execute(int targetFrame) {
 		}
 
 		// process events every so often
-		if (localCounter > 0 && localCounter % 100 == 0) {
+		uint32 now = g_system->getMillis();
+		if (now - lastPoll >= kLingoEventPollInterval) {
+			lastPoll = now;
 			_vm->processSysEvents();
 			// Also process update widgets!
 			Movie *movie = g_director->getCurrentMovie();
@@ -670,44 +704,48 @@ bool Lingo::execute(int targetFrame) {
 			}
 		}
 
-		uint current = _state->pc;
+		if (_state->script == nullptr) {
+			debugC(1, kDebugLingoExec, "Lingo::execute(): PANIC: No script to execute (1)");
+			break;
+		}
+
+		if (canExecuteFast()) {
+			// Run a batch of instructions without any of the tracing below
+			_globalCounter += executeFast(targetFrame);
+		} else {
+			uint current = _state->pc;
 
-		if (debugChannelSet(5, kDebugLingoExec))
-			printStack("Stack before: ", current);
+			if (debugChannelSet(5, kDebugLingoExec))
+				printStack("Stack before: ", current);
 
-		if (debugChannelSet(9, kDebugLingoExec)) {
-			debug("Vars before");
-			printAllVars();
-			if (_state->me.type == OBJECT)
-				debug("me: %s", _state->me.asString(true).c_str());
-		}
+			if (debugChannelSet(9, kDebugLingoExec)) {
+				debug("Vars before");
+				printAllVars();
+				if (_state->me.type == OBJECT)
+					debug("me: %s", _state->me.asString(true).c_str());
+			}
 
-		if (debugChannelSet(4, kDebugLingoExec)) {
-			Common::String instr = decodeInstruction(_state->script, _state->pc);
-			debugC(4, kDebugLingoExec, "[%5d]: %s", current, instr.c_str());
-		}
+			if (debugChannelSet(4, kDebugLingoExec)) {
+				Common::String instr = decodeInstruction(_state->script, _state->pc);
+				debugC(4, kDebugLingoExec, "[%5d]: %s", current, instr.c_str());
+			}
 
-		g_debugger->stepHook();
+			g_debugger->stepHook();
 
-		if (_state->script == nullptr) {
-			debugC(1, kDebugLingoExec, "Lingo::execute(): PANIC: No script to execute (1)");
-			break;
-		}
+			_state->pc++;
+			(*((*_state->script)[_state->pc - 1]))();
 
-		_state->pc++;
-		(*((*_state->script)[_state->pc - 1]))();
+			if (debugChannelSet(5, kDebugLingoExec))
+				printStack("Stack after: ", current);
 
-		if (debugChannelSet(5, kDebugLingoExec))
-			printStack("Stack after: ", current);
+			if (debugChannelSet(9, kDebugLingoExec)) {
+				debug("Vars after");
+				printAllVars();
+			}
 
-		if (debugChannelSet(9, kDebugLingoExec)) {
-			debug("Vars after");
-			printAllVars();
+			_globalCounter++;
 		}
 
-		_globalCounter++;
-		localCounter++;
-
 		if (!_abort && _state->script == nullptr) {
 			debugC(1, kDebugLingoExec, "Lingo::execute(): PANIC: No script to execute (2)");
 			break;
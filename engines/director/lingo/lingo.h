@@ -358,6 +358,11 @@ struct LingoState {
 	~LingoState();
 };
 
+// Lingo::execute polls for events and widget updates at this interval (in ms)
+const uint32 kLingoEventPollInterval = 10;
+// Number of instructions Lingo::executeFast runs before returning to the main loop
+const uint kLingoFastBatchSize = 256;
+
 enum LingoExecState {
 	kRunning,
 	kPause,
@@ -426,6 +431,8 @@ public:
 
 public:
 	bool execute(int targetFrame = -1);
+	bool canExecuteFast();
+	uint executeFast(int targetFrame);
 	void switchStateFromWindow();
 	void freezeState();
 	void freezePlayState();
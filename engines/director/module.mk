@@ -244,6 +244,15 @@ MODULE_OBJS += \
 
 endif
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	graphics-neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	graphics-sse2.o
+endif
+
 # HACK: Skip this when including the file for detection objects.
 ifeq "$(LOAD_RULES_MK)" "1"
 director-grammar:
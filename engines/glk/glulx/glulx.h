@@ -159,7 +159,13 @@ private:
 
 	int undo_chain_size;
 	int undo_chain_num;
-	byte **undo_chain;
+	undostate_t **undo_chain;
+
+	/**
+	 * Copy of RAM (ramstart to endmem) as it was in the most recent undo state.
+	 */
+	byte *undo_ram;
+	uint undo_ram_len;
 
 	/**
 	 * This will contain a copy of RAM (ramstate to endmem) as it exists in the game file.
@@ -953,6 +959,25 @@ public:
 	 */
 	uint perform_restoreundo();
 
+	/**
+	 * Store the pages of undo_ram which differ from the current RAM into the given (previously
+	 * most recent) undo state, then bring undo_ram up to date. This returns 0 on success, 1 on failure.
+	 */
+	uint write_undo_pages(undostate_t *state);
+
+	/**
+	 * Put the pages stored in the given undo state back into undo_ram, making it the most recent
+	 * state. This returns 0 on success, 1 on failure.
+	 */
+	uint read_undo_pages(undostate_t *state);
+
+	/**
+	 * Copy undo_ram into main memory, leaving the protected range alone.
+	 */
+	uint restore_undo_ram(uint newendmem);
+
+	void free_undostate(undostate_t *state);
+
 	uint perform_verify();
 
 	/**@}*/
@@ -392,6 +392,26 @@ struct dest_struct {
 };
 typedef dest_struct dest_t;
 
+/**
+ * Undo states track RAM in pages of this size. Memory sizes are always a multiple of 256.
+ */
+#define UNDO_PAGESIZE (256)
+
+/**
+ * An entry in the undo chain. Only the most recent state has its RAM kept in full (in undo_ram);
+ * each older state stores just the pages which differ from the state saved after it.
+ */
+struct undostate_struct {
+	uint endmem;     ///< Memory size when the state was saved
+	uint numpages;   ///< Number of pages stored in pageaddrs/pagedata
+	uint *pageaddrs; ///< Addresses of the stored pages
+	byte *pagedata;  ///< Contents of the stored pages
+	byte *data;      ///< Heap and stack chunks
+
+	undostate_struct() : endmem(0), numpages(0), pageaddrs(nullptr), pagedata(nullptr), data(nullptr) {}
+};
+typedef undostate_struct undostate_t;
+
 /**
  * These constants are defined in the Glulx spec.
  */
@@ -29,7 +29,7 @@ namespace Glulx {
 bool Glulx::init_serial() {
 	undo_chain_num = 0;
 	undo_chain_size = max_undo_level;
-	undo_chain = (unsigned char **)glulx_malloc(sizeof(unsigned char *) * undo_chain_size);
+	undo_chain = (undostate_t **)glulx_malloc(sizeof(undostate_t *) * undo_chain_size);
 	if (!undo_chain)
 		return false;
 
@@ -55,7 +55,7 @@ void Glulx::final_serial() {
 	if (undo_chain) {
 		int ix;
 		for (ix = 0; ix < undo_chain_num; ix++) {
-			glulx_free(undo_chain[ix]);
+			free_undostate(undo_chain[ix]);
 		}
 		glulx_free(undo_chain);
 	}
@@ -63,6 +63,12 @@ void Glulx::final_serial() {
 	undo_chain_size = 0;
 	undo_chain_num = 0;
 
+	if (undo_ram) {
+		glulx_free(undo_ram);
+		undo_ram = nullptr;
+	}
+	undo_ram_len = 0;
+
 #ifdef SERIALIZE_CACHE_RAM
 	if (ramcache) {
 		glulx_free(ramcache);
@@ -71,17 +77,140 @@ void Glulx::final_serial() {
 #endif /* SERIALIZE_CACHE_RAM */
 }
 
+void Glulx::free_undostate(undostate_t *state) {
+	if (!state)
+		return;
+
+	glulx_free(state->pageaddrs);
+	glulx_free(state->pagedata);
+	glulx_free(state->data);
+	delete state;
+}
+
+uint Glulx::write_undo_pages(undostate_t *state) {
+	uint ramlen = endmem - ramstart;
+	uint oldlen = undo_ram_len;
+	uint numpages = 0;
+	uint *pageaddrs = nullptr;
+	byte *pagedata = nullptr;
+	uint lx;
+
+	if (state) {
+		/* Collect the pages of the previous state which differ from the
+		   current RAM, including any which are past the end of memory
+		   now because it shrank. */
+		if (oldlen) {
+			pageaddrs = (uint *)glulx_malloc((oldlen / UNDO_PAGESIZE) * sizeof(uint));
+			if (!pageaddrs)
+				return 1;
+		}
+
+		for (lx = 0; lx < oldlen; lx += UNDO_PAGESIZE) {
+			if (lx >= ramlen || memcmp(undo_ram + lx, memmap + ramstart + lx, UNDO_PAGESIZE) != 0)
+				pageaddrs[numpages++] = lx;
+		}
+
+		if (numpages) {
+			pagedata = (byte *)glulx_malloc(numpages * UNDO_PAGESIZE);
+			if (!pagedata) {
+				glulx_free(pageaddrs);
+				return 1;
+			}
+			for (lx = 0; lx < numpages; lx++)
+				memcpy(pagedata + lx * UNDO_PAGESIZE, undo_ram + pageaddrs[lx], UNDO_PAGESIZE);
+		} else {
+			glulx_free(pageaddrs);
+			pageaddrs = nullptr;
+		}
+	}
+
+	if (ramlen != oldlen) {
+		byte *newram = (byte *)glulx_realloc(undo_ram, ramlen);
+		if (!newram) {
+			glulx_free(pageaddrs);
+			glulx_free(pagedata);
+			return 1;
+		}
+		undo_ram = newram;
+		undo_ram_len = ramlen;
+	}
+
+	/* Bring the copy of RAM up to date. */
+	if (state) {
+		for (lx = 0; lx < numpages && pageaddrs[lx] < ramlen; lx++)
+			memcpy(undo_ram + pageaddrs[lx], memmap + ramstart + pageaddrs[lx], UNDO_PAGESIZE);
+		if (ramlen > oldlen)
+			memcpy(undo_ram + oldlen, memmap + ramstart + oldlen, ramlen - oldlen);
+
+		state->numpages = numpages;
+		state->pageaddrs = pageaddrs;
+		state->pagedata = pagedata;
+	} else {
+		memcpy(undo_ram, memmap + ramstart, ramlen);
+	}
+
+	return 0;
+}
+
+uint Glulx::read_undo_pages(undostate_t *state) {
+	uint ramlen = state->endmem - ramstart;
+	uint lx;
+
+	if (ramlen != undo_ram_len) {
+		byte *newram = (byte *)glulx_realloc(undo_ram, ramlen);
+		if (!newram)
+			return 1;
+		undo_ram = newram;
+		undo_ram_len = ramlen;
+	}
+
+	/* If the state had more memory than the one after it, the pages past
+	   the end of that are all stored here. */
+	for (lx = 0; lx < state->numpages; lx++)
+		memcpy(undo_ram + state->pageaddrs[lx], state->pagedata + lx * UNDO_PAGESIZE, UNDO_PAGESIZE);
+
+	glulx_free(state->pageaddrs);
+	glulx_free(state->pagedata);
+	state->pageaddrs = nullptr;
+	state->pagedata = nullptr;
+	state->numpages = 0;
+
+	return 0;
+}
+
+uint Glulx::restore_undo_ram(uint newendmem) {
+	uint res, protlo, prothi;
+
+	res = change_memsize(newendmem, false);
+	if (res)
+		return res;
+
+	protlo = CLIP(protectstart, ramstart, endmem);
+	prothi = CLIP(protectend, protlo, endmem);
+
+	memcpy(memmap + ramstart, undo_ram, protlo - ramstart);
+	memcpy(memmap + prothi, undo_ram + (prothi - ramstart), endmem - prothi);
+
+	return 0;
+}
+
 uint Glulx::perform_saveundo() {
 	dest_t dest;
 	uint res;
-	uint memstart = 0, memlen = 0, heapstart = 0, heaplen = 0;
+	uint heapstart = 0, heaplen = 0;
 	uint stackstart = 0, stacklen = 0;
+	undostate_t *state = nullptr;
 
 	/* The format for undo-saves is simpler than for saves on disk. We
-	   just have a memory chunk, a heap chunk, and a stack chunk, in
-	   that order. We skip the IFF chunk headers (although the size
-	   fields are still there.) We also don't bother with IFF's 16-bit
-	   alignment. */
+	   just have a heap chunk and a stack chunk, in that order. We skip
+	   the IFF chunk headers (although the size fields are still there.)
+	   We also don't bother with IFF's 16-bit alignment.
+
+	   Main memory isn't serialized at all. The newest state's RAM is
+	   kept in undo_ram, and each older state only holds the pages which
+	   differ from the state after it. Pages are compared rather than
+	   tracked as they are written, since Glk writes into memory directly
+	   (line input buffers, retained arrays). */
 
 	if (undo_chain_size == 0)
 		return 1;
@@ -92,14 +221,6 @@ uint Glulx::perform_saveundo() {
 	if (res == 0) {
 		res = write_long(&dest, 0); /* space for chunk length */
 	}
-	if (res == 0) {
-		memstart = dest._pos;
-		res = write_memstate(&dest);
-		memlen = dest._pos - memstart;
-	}
-	if (res == 0) {
-		res = write_long(&dest, 0); /* space for chunk length */
-	}
 	if (res == 0) {
 		heapstart = dest._pos;
 		res = write_heapstate(&dest, false);
@@ -120,12 +241,6 @@ uint Glulx::perform_saveundo() {
 		if (!dest._ptr)
 			res = 1;
 	}
-	if (res == 0) {
-		res = reposition_write(&dest, memstart - 4);
-	}
-	if (res == 0) {
-		res = write_long(&dest, memlen);
-	}
 	if (res == 0) {
 		res = reposition_write(&dest, heapstart - 4);
 	}
@@ -139,21 +254,35 @@ uint Glulx::perform_saveundo() {
 		res = write_long(&dest, stacklen);
 	}
 
+	if (res == 0) {
+		state = new undostate_t();
+		state->endmem = endmem;
+		state->data = dest._ptr;
+		dest._ptr = nullptr;
+
+		/* The previous state turns into a page delta, unless it's about
+		   to be dropped off the end of the chain anyway. */
+		if (undo_chain_num > 0 && undo_chain_size > 1)
+			res = write_undo_pages(undo_chain[0]);
+		else
+			res = write_undo_pages(nullptr);
+	}
+
 	if (res == 0) {
 		/* It worked. */
 		if (undo_chain_num >= undo_chain_size) {
-			glulx_free(undo_chain[undo_chain_num - 1]);
+			free_undostate(undo_chain[undo_chain_num - 1]);
 			undo_chain[undo_chain_num - 1] = nullptr;
 		}
 		if (undo_chain_size > 1)
 			memmove(undo_chain + 1, undo_chain,
-			        (undo_chain_size - 1) * sizeof(unsigned char *));
-		undo_chain[0] = dest._ptr;
+			        (undo_chain_size - 1) * sizeof(undostate_t *));
+		undo_chain[0] = state;
 		if (undo_chain_num < undo_chain_size)
 			undo_chain_num += 1;
-		dest._ptr = nullptr;
 	} else {
 		/* It didn't work. */
+		free_undostate(state);
 		if (dest._ptr) {
 			glulx_free(dest._ptr);
 			dest._ptr = nullptr;
@@ -165,9 +294,11 @@ uint Glulx::perform_saveundo() {
 
 uint Glulx::perform_restoreundo() {
 	dest_t dest;
+	undostate_t *state;
 	uint res, val = 0;
 	uint heapsumlen = 0;
 	uint *heapsumarr = nullptr;
+	int ix;
 
 	/* If profiling is enabled and active then fail. */
 #ifdef VM_PROFILING
@@ -178,15 +309,15 @@ uint Glulx::perform_restoreundo() {
 	if (undo_chain_size == 0 || undo_chain_num == 0)
 		return 1;
 
+	state = undo_chain[0];
 	dest._isMem = true;
-	dest._ptr = undo_chain[0];
+	dest._ptr = state->data;
+
+	heap_clear();
 
 	res = 0;
 	if (res == 0) {
-		res = read_long(&dest, &val);
-	}
-	if (res == 0) {
-		res = read_memstate(&dest, val);
+		res = restore_undo_ram(state->endmem);
 	}
 	if (res == 0) {
 		res = read_long(&dest, &val);
@@ -209,17 +340,30 @@ uint Glulx::perform_restoreundo() {
 	}
 
 	if (res == 0) {
-		/* It worked. */
+		/* It worked. The next state becomes the newest one, so its pages
+		   go back into undo_ram. If that fails, the older states can't be
+		   rebuilt any more and are dropped. */
+		if (undo_chain_num > 1 && read_undo_pages(undo_chain[1])) {
+			for (ix = 1; ix < undo_chain_num; ix++) {
+				free_undostate(undo_chain[ix]);
+				undo_chain[ix] = nullptr;
+			}
+			undo_chain_num = 1;
+		}
+
 		if (undo_chain_size > 1)
 			memmove(undo_chain, undo_chain + 1,
-			        (undo_chain_size - 1) * sizeof(unsigned char *));
+			        (undo_chain_size - 1) * sizeof(undostate_t *));
 		undo_chain_num -= 1;
-		glulx_free(dest._ptr);
-		dest._ptr = nullptr;
-	} else {
-		/* It didn't work. */
-		dest._ptr = nullptr;
+		free_undostate(state);
+
+		if (undo_chain_num == 0) {
+			glulx_free(undo_ram);
+			undo_ram = nullptr;
+			undo_ram_len = 0;
+		}
 	}
+	dest._ptr = nullptr;
 
 	return res;
 }
@@ -37,6 +37,10 @@
 
 #include "scumm/akos.h"
 
+#ifdef ENABLE_HE
+#include "scumm/he/moonbase/ai_benchmark.h"
+#endif
+
 namespace Scumm {
 
 void debugC(int channel, const char *s, ...) {
@@ -94,6 +98,10 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 		registerCmd("grail",  WRAP_METHOD(ScummDebugger, Cmd_PrintGrail));
 	if (_vm->_game.id == GID_MONKEY && _vm->_game.platform == Common::kPlatformSegaCD)
 		registerCmd("passcode",  WRAP_METHOD(ScummDebugger, Cmd_Passcode));
+#ifdef ENABLE_HE
+	if (_vm->_game.id == GID_MOONBASE)
+		registerCmd("aibench",  WRAP_METHOD(ScummDebugger, Cmd_AIBenchmark));
+#endif
 
 	registerCmd("loadgame",  WRAP_METHOD(ScummDebugger, Cmd_LoadGame));
 	registerCmd("savegame",  WRAP_METHOD(ScummDebugger, Cmd_SaveGame));
@@ -1408,6 +1416,31 @@ bool ScummDebugger::Cmd_Passcode(int argc, const char **argv) {
 	return false;
 }
 
+#ifdef ENABLE_HE
+bool ScummDebugger::Cmd_AIBenchmark(int argc, const char **argv) {
+	int rounds = (argc > 1) ? atoi(argv[1]) : 1;
+	if (rounds < 1) {
+		debugPrintf("Usage: aibench [<rounds>]\n");
+		return true;
+	}
+
+	Common::Array<AISearchBenchmarkResult> results;
+	benchmarkAISearch(results, rounds);
+
+	uint32 totalTime = 0;
+	debugPrintf("Generator  Seed   Size  Nodes   Passes  Depth  Cost     Time\n");
+	for (uint i = 0; i < results.size(); i++) {
+		const AISearchBenchmarkResult &result = results[i];
+		debugPrintf("%-9s  %-5d  %-4d  %-6d  %-6d  %-5d  %-7.1f  %dms\n", result.generator, result.seed, result.mapSize,
+			result.nodes, result.passes, result.depth, result.cost, result.time);
+		totalTime += result.time;
+	}
+	debugPrintf("Total time for %d round(s): %dms\n", rounds, totalTime);
+
+	return true;
+}
+#endif
+
 bool ScummDebugger::Cmd_ResetCursors(int argc, const char **argv) {
 	_vm->resetCursors();
 	detach();
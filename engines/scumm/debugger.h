@@ -64,6 +64,9 @@ private:
 	bool Cmd_PrintDraft(int argc, const char **argv);
 	bool Cmd_PrintGrail(int argc, const char **argv);
 	bool Cmd_Passcode(int argc, const char **argv);
+#ifdef ENABLE_HE
+	bool Cmd_AIBenchmark(int argc, const char **argv);
+#endif
 
 	bool Cmd_Debug(int argc, const char **argv);
 
@@ -1172,6 +1172,7 @@ void ScummEngine_v71he::redrawBGAreas() {
 void ScummEngine_v72he::redrawBGAreas() {
 	ScummEngine_v71he::redrawBGAreas();
 	_wiz->flushAWizBuffer();
+	_wiz->endDecodedImageCacheFrame();
 }
 #endif
 
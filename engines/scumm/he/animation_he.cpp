@@ -162,6 +162,7 @@ void MoviePlayer::handleNextFrame() {
 		uint8 *dst = _vm->findWrappedBlock(MKTAG('W','I','Z','D'), dstPtr, 0, 0);
 		assert(dst);
 		copyFrameToBuffer(dst, kDstResource, 0, 0, _vm->_screenWidth * _vm->_bytesPerPixel);
+		_vm->_wiz->invalidateDecodedImage(_wizResNum);
 	} else if (_flags & vfBackground) {
 		copyFrameToBuffer(pvs->getBackPixels(0, 0), kDstScreen, 0, 0, pvs->pitch);
 
@@ -0,0 +1,191 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/system.h"
+
+#include "scumm/he/moonbase/ai_benchmark.h"
+#include "scumm/he/moonbase/ai_tree.h"
+#include "scumm/he/moonbase/map_katton.h"
+#include "scumm/he/moonbase/map_main.h"
+#include "scumm/he/moonbase/map_spiff.h"
+
+namespace Scumm {
+
+static const int kBenchmarkMaxNodes = 100000;
+// The benchmark has no scripts counting passes, so it expands more nodes per
+// pass than the game does to keep the pass overhead out of the timings
+static const uint32 kBenchmarkNodesPerPass = 64;
+
+// Walks a generated map tile by tile; the map wraps around on both axes
+class MapWalker : public IContainedObject {
+private:
+	const MapFile *_map;
+	int _dimension;
+	int _x, _y;
+	int _fromX, _fromY;
+	int _targetX, _targetY;
+
+	int tileCost(int x, int y) const {
+		switch (_map->terrainStates[x][y]) {
+		case 0x93: case 0x94: case 0x00: case 0x96:
+			return 1;
+		case 0x97: case 0x99: case 0x0D: case 0x9A:
+			return 2;
+		case 0x9B: case 0x9C: case 0x1A: case 0x9D:
+			return 3;
+		default:
+			// Slopes, cliffs, water and craters
+			return 5;
+		}
+	}
+
+	int wrappedDistance(int a, int b) const {
+		int dist = ABS(a - b);
+		return MIN(dist, _dimension - dist);
+	}
+
+protected:
+	float calcH() override {
+		return (float)MAX(wrappedDistance(_x, _targetX), wrappedDistance(_y, _targetY));
+	}
+
+public:
+	MapWalker(const MapFile *map, int dimension, int x, int y, int targetX, int targetY) :
+		_map(map), _dimension(dimension), _x(x), _y(y), _fromX(-1), _fromY(-1), _targetX(targetX), _targetY(targetY) {}
+
+	IContainedObject *duplicate() override {
+		MapWalker *walker = new MapWalker(_map, _dimension, _x, _y, _targetX, _targetY);
+		walker->_fromX = _fromX;
+		walker->_fromY = _fromY;
+		walker->setValueG(getValueG());
+		return walker;
+	}
+
+	int numChildrenToGen() override { return 8; }
+
+	IContainedObject *createChildObj(int index, int &completionFlag) override {
+		static const int8 stepX[8] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+		static const int8 stepY[8] = { -1, -1, -1, 0, 0, 1, 1, 1 };
+
+		completionFlag = 1;
+
+		int x = (_x + stepX[index] + _dimension) % _dimension;
+		int y = (_y + stepY[index] + _dimension) % _dimension;
+
+		// Never step straight back
+		if (x == _fromX && y == _fromY)
+			return nullptr;
+
+		MapWalker *walker = new MapWalker(_map, _dimension, x, y, _targetX, _targetY);
+		walker->_fromX = _x;
+		walker->_fromY = _y;
+
+		float cost = (float)tileCost(x, y);
+		if (stepX[index] && stepY[index])
+			cost *= 1.4f;
+
+		walker->setValueG(getValueG() + cost);
+		return walker;
+	}
+
+	int checkSuccess() override { return (_x == _targetX) && (_y == _targetY); }
+
+	float calcT() override {
+		if (checkSuccess())
+			return SUCCESS;
+
+		return getG() + calcH();
+	}
+};
+
+static void getStartPoints(const MapFile *map, int dimension, int &x1, int &y1, int &x2, int &y2) {
+	if (map->twoPlayerPoints[0].x != 0xFFFF && map->twoPlayerPoints[1].x != 0xFFFF) {
+		x1 = (map->twoPlayerPoints[0].x / 60) % dimension;
+		y1 = (map->twoPlayerPoints[0].y / 60) % dimension;
+		x2 = (map->twoPlayerPoints[1].x / 60) % dimension;
+		y2 = (map->twoPlayerPoints[1].y / 60) % dimension;
+	} else {
+		x1 = y1 = 0;
+		x2 = y2 = dimension / 2;
+	}
+}
+
+void benchmarkAISearch(Common::Array<AISearchBenchmarkResult> &results, int rounds) {
+	static const int seeds[] = { 1, 1234, 31337 };
+	static const int sizes[] = { 32, 48, 64 };
+
+	results.clear();
+
+	for (int generator = SPIFF_GEN; generator <= KATTON_GEN; generator++) {
+		for (int i = 0; i < ARRAYSIZE(seeds); i++) {
+			const int seed = seeds[i];
+			const int size = sizes[i];
+
+			MapFile *map;
+			if (generator == SPIFF_GEN) {
+				SpiffGenerator spiff(seed);
+				map = spiff.generateMap(3, 1, size, 3, 3);
+			} else {
+				KattonGenerator katton(seed);
+				map = katton.generateMap(3, 1, size, 3, 3);
+			}
+
+			AISearchBenchmarkResult result;
+			result.generator = (generator == SPIFF_GEN) ? "spiff" : "katton";
+			result.seed = seed;
+			result.mapSize = size;
+			result.nodes = 0;
+			result.passes = 0;
+			result.depth = 0;
+			result.cost = 0;
+			result.time = 0;
+
+			int startX, startY, targetX, targetY;
+			getStartPoints(map, size, startX, startY, targetX, targetY);
+
+			for (int round = 0; round < rounds; round++) {
+				uint32 start = g_system->getMillis();
+
+				Tree tree(new MapWalker(map, size, startX, startY, targetX, targetY), size * 2, kBenchmarkMaxNodes, nullptr);
+				tree.setNodesPerPass(kBenchmarkNodesPerPass);
+
+				int passes = 1;
+				Node *retNode = tree.aStarSearch_singlePassInit();
+				while (!retNode) {
+					retNode = tree.aStarSearch_singlePass();
+					passes++;
+				}
+
+				result.nodes = MAX(result.nodes, Node::getNodeCount());
+				result.passes = passes;
+				result.depth = retNode->getDepth();
+				result.cost = retNode->getContainedObject()->getValueG();
+				result.time += g_system->getMillis() - start;
+			}
+
+			results.push_back(result);
+			delete map;
+		}
+	}
+}
+
+} // End of namespace Scumm
@@ -0,0 +1,52 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef SCUMM_HE_MOONBASE_AI_BENCHMARK_H
+#define SCUMM_HE_MOONBASE_AI_BENCHMARK_H
+
+#include "common/array.h"
+
+namespace Scumm {
+
+struct AISearchBenchmarkResult {
+	const char *generator;
+	int seed;
+	int mapSize;
+
+	int nodes;     // Peak number of search nodes alive
+	int passes;    // Number of search passes needed
+	int depth;     // Length of the path found
+	float cost;    // Cost of the path found
+	uint32 time;   // Total time spent, in milliseconds
+};
+
+/**
+ * Runs the AI tree search on a fixed set of maps built by the random map
+ * generators, walking between the two player start points. The maps and
+ * the searches only depend on the seeds, so node counts and path costs
+ * can be compared between runs and builds; only the timings vary.
+ */
+void benchmarkAISearch(Common::Array<AISearchBenchmarkResult> &results, int rounds);
+
+} // End of namespace Scumm
+
+#endif
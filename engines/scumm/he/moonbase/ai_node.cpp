@@ -19,6 +19,8 @@
  *
  */
 
+#include "common/textconsole.h"
+
 #include "scumm/he/moonbase/ai_node.h"
 
 namespace Scumm {
@@ -30,6 +32,59 @@ IContainedObject::IContainedObject(IContainedObject &sourceContainedObject) {
 
 int Node::_nodeCount = 0;
 
+// Every block starts with a Node sized slot linking it to the next block,
+// followed by the nodes themselves. Free nodes are chained through their
+// first bytes. All blocks are released once the last node is gone.
+static const int kNodesPerBlock = 1024;
+
+static void *s_nodeBlocks = nullptr;
+static void *s_freeNodes = nullptr;
+static int s_allocatedNodes = 0;
+
+void *Node::operator new(size_t size) {
+	assert(size == sizeof(Node));
+
+	if (!s_freeNodes) {
+		byte *block = (byte *)malloc((kNodesPerBlock + 1) * sizeof(Node));
+		if (!block)
+			error("Node: Out of memory allocating %d search nodes", kNodesPerBlock);
+
+		*(void **)block = s_nodeBlocks;
+		s_nodeBlocks = block;
+
+		for (int i = kNodesPerBlock; i > 0; i--) {
+			void *slot = block + i * sizeof(Node);
+			*(void **)slot = s_freeNodes;
+			s_freeNodes = slot;
+		}
+	}
+
+	void *node = s_freeNodes;
+	s_freeNodes = *(void **)node;
+	s_allocatedNodes++;
+
+	return node;
+}
+
+void Node::operator delete(void *ptr) {
+	if (!ptr)
+		return;
+
+	*(void **)ptr = s_freeNodes;
+	s_freeNodes = ptr;
+
+	if (--s_allocatedNodes)
+		return;
+
+	while (s_nodeBlocks) {
+		void *next = *(void **)s_nodeBlocks;
+		free(s_nodeBlocks);
+		s_nodeBlocks = next;
+	}
+
+	s_freeNodes = nullptr;
+}
+
 Node::Node() {
 	_parent = nullptr;
 	_depth = 0;
@@ -42,6 +97,10 @@ Node::Node(Node *sourceNode) {
 	_children = sourceNode->getChildren();
 
 	_depth = sourceNode->getDepth();
+	// Copies are destroyed like any other node, so they have to be counted
+	// too. Otherwise every copy lowers the count, and searches on copied
+	// trees could go past MAX_NODES
+	_nodeCount++;
 
 	_contents = sourceNode->getContainedObject()->duplicate();
 }
@@ -76,6 +76,11 @@ public:
 	Node(Node *sourceNode);
 	~Node();
 
+	// Searches create and destroy nodes by the thousand, so they are carved
+	// out of larger blocks and recycled through a free list
+	static void *operator new(size_t size);
+	static void operator delete(void *ptr);
+
 	void setParent(Node *parentPtr) { _parent = parentPtr; }
 	Node *getParent() const { return _parent; }
 
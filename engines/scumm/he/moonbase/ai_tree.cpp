@@ -27,56 +27,93 @@
 
 namespace Scumm {
 
-static int compareTreeNodes(const void *a, const void *b) {
-	if (((const TreeNode *)a)->value < ((const TreeNode *)b)->value)
-		return -1;
-	else if (((const TreeNode *)a)->value > ((const TreeNode *)b)->value)
-		return 1;
-	else
-		return 0;
+void TreeFrontier::push(float value, Node *node) {
+	TreeNode entry(value, _nextOrder++, node);
+
+	uint pos = _heap.size();
+	_heap.push_back(entry);
+
+	while (pos > 0) {
+		uint parent = (pos - 1) / 2;
+		if (!(entry < _heap[parent]))
+			break;
+
+		_heap[pos] = _heap[parent];
+		pos = parent;
+	}
+
+	_heap[pos] = entry;
 }
 
-Tree::Tree(AI *ai) : _ai(ai) {
-	pBaseNode = new Node;
+Node *TreeFrontier::pop() {
+	assert(!_heap.empty());
+
+	Node *node = _heap[0].node;
+	TreeNode last = _heap.back();
+	_heap.pop_back();
+
+	uint size = _heap.size();
+	if (!size)
+		return node;
+
+	uint pos = 0;
+	for (;;) {
+		uint child = pos * 2 + 1;
+		if (child >= size)
+			break;
+
+		if (child + 1 < size && _heap[child + 1] < _heap[child])
+			child++;
+
+		if (!(_heap[child] < last))
+			break;
+
+		_heap[pos] = _heap[child];
+		pos = child;
+	}
+
+	_heap[pos] = last;
+
+	return node;
+}
+
+void TreeFrontier::clear() {
+	_heap.clear();
+	_nextOrder = 0;
+}
+
+void Tree::init() {
 	_maxDepth = MAX_DEPTH;
 	_maxNodes = MAX_NODES;
 	_currentNode = nullptr;
 	_currentChildIndex = 0;
+	_nodesPerPass = SEARCH_NODES_PER_PASS;
+}
 
-	_currentMap = new Common::SortedArray<TreeNode *>(compareTreeNodes);
+Tree::Tree(AI *ai) : _ai(ai) {
+	init();
+	pBaseNode = new Node;
 }
 
 Tree::Tree(IContainedObject *contents, AI *ai) : _ai(ai) {
+	init();
 	pBaseNode = new Node;
 	pBaseNode->setContainedObject(contents);
-	_maxDepth = MAX_DEPTH;
-	_maxNodes = MAX_NODES;
-	_currentNode = nullptr;
-	_currentChildIndex = 0;
-
-	_currentMap = new Common::SortedArray<TreeNode *>(compareTreeNodes);
 }
 
 Tree::Tree(IContainedObject *contents, int maxDepth, AI *ai) : _ai(ai) {
+	init();
 	pBaseNode = new Node;
 	pBaseNode->setContainedObject(contents);
 	_maxDepth = maxDepth;
-	_maxNodes = MAX_NODES;
-	_currentNode = nullptr;
-	_currentChildIndex = 0;
-
-	_currentMap = new Common::SortedArray<TreeNode *>(compareTreeNodes);
 }
 
 Tree::Tree(IContainedObject *contents, int maxDepth, int maxNodes, AI *ai) : _ai(ai) {
+	init();
 	pBaseNode = new Node;
 	pBaseNode->setContainedObject(contents);
 	_maxDepth = maxDepth;
 	_maxNodes = maxNodes;
-	_currentNode = nullptr;
-	_currentChildIndex = 0;
-
-	_currentMap = new Common::SortedArray<TreeNode *>(compareTreeNodes);
 }
 
 void Tree::duplicateTree(Node *sourceNode, Node *destNode) {
@@ -92,12 +129,11 @@ void Tree::duplicateTree(Node *sourceNode, Node *destNode) {
 }
 
 Tree::Tree(const Tree *sourceTree, AI *ai) : _ai(ai) {
+	init();
 	pBaseNode = new Node(sourceTree->getBaseNode());
 	_maxDepth = sourceTree->getMaxDepth();
 	_maxNodes = sourceTree->getMaxNodes();
-	_currentMap = new Common::SortedArray<TreeNode *>(compareTreeNodes);
-	_currentNode = nullptr;
-	_currentChildIndex = 0;
+	_nodesPerPass = sourceTree->getNodesPerPass();
 
 	duplicateTree(sourceTree->getBaseNode(), pBaseNode);
 }
@@ -119,12 +155,10 @@ Tree::~Tree() {
 			pTemp = nullptr;
 		}
 	}
-
-	delete _currentMap;
 }
 
 Node *Tree::aStarSearch() {
-	Common::SortedArray<TreeNode *> mmfpOpen(compareTreeNodes);
+	TreeFrontier mmfpOpen;
 
 	Node *currentNode = nullptr;
 	float currentT;
@@ -134,11 +168,10 @@ Node *Tree::aStarSearch() {
 	float temp = pBaseNode->getContainedObject()->calcT();
 
 	if (static_cast<int>(temp) != SUCCESS) {
-		mmfpOpen.insert(new TreeNode(pBaseNode->getObjectT(), pBaseNode));
+		mmfpOpen.push(pBaseNode->getObjectT(), pBaseNode);
 
-		while (mmfpOpen.size() && (retNode == nullptr)) {
-			currentNode = mmfpOpen.front()->node;
-			mmfpOpen.erase(mmfpOpen.begin());
+		while (!mmfpOpen.empty() && (retNode == nullptr)) {
+			currentNode = mmfpOpen.pop();
 
 			if ((currentNode->getDepth() < _maxDepth) && (Node::getNodeCount() < _maxNodes)) {
 				// Generate nodes
@@ -151,7 +184,7 @@ Node *Tree::aStarSearch() {
 					if (currentT == SUCCESS)
 						retNode = *i;
 					else
-						mmfpOpen.insert(new TreeNode(currentT, (*i)));
+						mmfpOpen.push(currentT, (*i));
 				}
 			} else {
 				retNode = currentNode;
@@ -169,11 +202,12 @@ Node *Tree::aStarSearch_singlePassInit() {
 	Node *retNode = nullptr;
 
 	_currentChildIndex = 1;
+	_currentMap.clear();
 
 	float temp = pBaseNode->getContainedObject()->calcT();
 
 	if (static_cast<int>(temp) != SUCCESS) {
-		_currentMap->insert(new TreeNode(pBaseNode->getObjectT(), pBaseNode));
+		_currentMap.push(pBaseNode->getObjectT(), pBaseNode);
 	} else {
 		retNode = pBaseNode;
 	}
@@ -182,23 +216,36 @@ Node *Tree::aStarSearch_singlePassInit() {
 }
 
 Node *Tree::aStarSearch_singlePass() {
+	// Keep expanding until a result turns up or enough nodes were expanded.
+	// A node whose children could not all be generated yet is left for
+	// the next pass, as is everything else once the pass is used up.
+	uint32 expanded = 0;
+	Node *retNode;
+
+	do {
+		retNode = aStarSearch_expandNext();
+	} while (!retNode && _currentChildIndex && ++expanded < _nodesPerPass);
+
+	return retNode;
+}
+
+Node *Tree::aStarSearch_expandNext() {
 	float currentT = 0.0;
 	Node *retNode = nullptr;
 
 	static int maxTime = 0;
 
 	if (_currentChildIndex == 1) {
-		maxTime = _ai->getPlayerMaxTime();
+		maxTime = _ai ? _ai->getPlayerMaxTime() : 0;
 	}
 
 	if (_currentChildIndex) {
-		if (!(_currentMap->size())) {
+		if (_currentMap.empty()) {
 			retNode = _currentNode;
 			return retNode;
 		}
 
-		_currentNode = _currentMap->front()->node;
-		_currentMap->erase(_currentMap->begin());
+		_currentNode = _currentMap.pop();
 	}
 
 	if ((_currentNode->getDepth() < _maxDepth) && (Node::getNodeCount() < _maxNodes) && ((!maxTime) || (_ai->getTimerValue(3) < maxTime))) {
@@ -208,7 +255,7 @@ Node *Tree::aStarSearch_singlePass() {
 		if (_currentChildIndex) {
 			Common::Array<Node *> vChildren = _currentNode->getChildren();
 
-			if (!vChildren.size() && !_currentMap->size()) {
+			if (!vChildren.size() && _currentMap.empty()) {
 				_currentChildIndex = 0;
 				retNode = _currentNode;
 			}
@@ -221,11 +268,11 @@ Node *Tree::aStarSearch_singlePass() {
 					retNode = *i;
 					i = vChildren.end() - 1;
 				} else {
-					_currentMap->insert(new TreeNode(currentT, (*i)));
+					_currentMap.push(currentT, (*i));
 				}
 			}
 
-			if (!(_currentMap->size()) && (currentT != SUCCESS)) {
+			if (_currentMap.empty() && (currentT != SUCCESS)) {
 				assert(_currentNode != nullptr);
 				retNode = _currentNode;
 			}
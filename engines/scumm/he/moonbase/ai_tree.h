@@ -32,11 +32,41 @@ const int MAX_NODES = 1000000;
 
 class AI;
 
+// Default number of nodes a single search pass may expand before handing
+// control back to the scripts. The scripts give up on a target after a
+// fixed number of passes, so anything but the single node of the original
+// game changes which targets the AI picks
+const uint32 SEARCH_NODES_PER_PASS = 1;
+
 struct TreeNode {
 	float value;
+	uint32 order;
 	Node *node;
 
-	TreeNode(float v, Node *n) { value = v; node = n; }
+	TreeNode() : value(0), order(0), node(nullptr) {}
+	TreeNode(float v, uint32 o, Node *n) : value(v), order(o), node(n) {}
+
+	// Nodes of equal value are expanded in the order they were found
+	bool operator<(const TreeNode &other) const {
+		return (value < other.value) || (value == other.value && order < other.order);
+	}
+};
+
+// Binary min-heap of the nodes waiting to be expanded
+class TreeFrontier {
+private:
+	Common::Array<TreeNode> _heap;
+	uint32 _nextOrder;
+
+public:
+	TreeFrontier() : _nextOrder(0) {}
+
+	bool empty() const { return _heap.empty(); }
+	uint size() const { return _heap.size(); }
+
+	void push(float value, Node *node);
+	Node *pop();
+	void clear();
 };
 
 class Tree {
@@ -48,11 +78,16 @@ private:
 
 	int _currentChildIndex;
 
-	Common::SortedArray<TreeNode *> *_currentMap;
+	TreeFrontier _currentMap;
 	Node *_currentNode;
 
+	uint32 _nodesPerPass;
+
 	AI *_ai;
 
+	void init();
+	Node *aStarSearch_expandNext();
+
 public:
 	Tree(AI *ai);
 	Tree(IContainedObject *contents, AI *ai);
@@ -70,6 +105,10 @@ public:
 	void setMaxNodes(int maxNodes) { _maxNodes = maxNodes; }
 	int getMaxNodes() const { return _maxNodes; }
 
+	// 0 and 1 both expand a single node per pass
+	void setNodesPerPass(uint32 nodesPerPass) { _nodesPerPass = nodesPerPass; }
+	uint32 getNodesPerPass() const { return _nodesPerPass; }
+
 	Node *aStarSearch();
 
 	Node *aStarSearch_singlePassInit();
@@ -72,6 +72,8 @@ void Wiz::takeAWiz(int globnum, int x1, int y1, int x2, int y2, bool back, bool
 	Common::Rect rect, clipRect;
 	WizPxShrdBuffer srcPtr;
 
+	invalidateDecodedImage(globnum);
+
 	VirtScreen *pvs = &_vm->_virtscr[kMainVirtScreen];
 	bufferWidth = pvs->w;
 	bufferHeight = pvs->h;
@@ -510,11 +512,143 @@ WizPxShrdBuffer Wiz::drawAWizPrimEx(int globNum, int state, int x, int y, int z,
 	return destPtr;
 }
 
+WizPxShrdBuffer Wiz::getDecodedAWizPrim(int globNum, int state, int32 flags, const WizRawPixel *optionalColorConversionTable, bool *isOpaque) {
+	if (isOpaque)
+		*isOpaque = false;
+
+	// These have side effects besides decoding the image...
+	if (flags & (kWRFUsePalette | kWRFPrint | kWRFZPlaneOn | kWRFZPlaneOff)) {
+		return drawAWizPrim(globNum, state, 0, 0, 0, 0, 0, nullptr, kWRFAlloc | flags, nullptr, optionalColorConversionTable);
+	}
+
+	const byte *srcData = getWizStateDataPrim(globNum, state);
+
+	DecodedImageKey key;
+	key.globNum = globNum;
+	key.state = state;
+	key.flags = flags & ~(kWRFForeground | kWRFBackground);
+	key.conversionTable = optionalColorConversionTable;
+	key.conversionTableHash = 0;
+	key.transparentColor = _vm->_game.heversion < 95 ? 0x05 : _vm->VAR(_vm->VAR_WIZ_TRANSPARENT_COLOR);
+	key.paletteChangedCounter = (flags & kWRFRemap) ? _vm->_paletteChangedCounter : 0;
+
+	// The conversion tables are palette slots, whose contents change
+	// with the palette...
+	const WizRawPixel *conversionTable = optionalColorConversionTable;
+	if (!conversionTable && _vm->_game.heversion > 98)
+		conversionTable = (const WizRawPixel *)_vm->getHEPaletteSlot(1);
+
+	if (conversionTable) {
+		uint32 hash = 0;
+		for (int i = 0; i < 256; i++)
+			hash = hash * 31 + conversionTable[i];
+		key.conversionTableHash = hash;
+	}
+
+	DecodedImageCache::iterator it = _decodedImages.find(key);
+	if (it != _decodedImages.end()) {
+		if (it->_value.srcData == srcData) {
+			_decodedImageHits++;
+			it->_value.lastUse = ++_decodedImageUseCounter;
+			if (isOpaque)
+				*isOpaque = it->_value.opaque;
+			return it->_value.buffer;
+		}
+
+		_decodedImageBytes -= it->_value.size;
+		_decodedImages.erase(it);
+	}
+
+	_decodedImageMisses++;
+
+	WizPxShrdBuffer buffer = drawAWizPrim(globNum, state, 0, 0, 0, 0, 0, nullptr, kWRFAlloc | flags, nullptr, optionalColorConversionTable);
+	if (!buffer())
+		return buffer;
+
+	int32 w, h;
+	getWizImageDim(globNum, state, w, h);
+
+	const uint32 pixelCount = w * h;
+	const uint32 size = pixelCount * (_uses16BitColor ? sizeof(WizRawPixel16) : sizeof(WizRawPixel8));
+
+	// Images bigger than a quarter of the budget would push out
+	// everything else, so they are never cached...
+	if (size > kDecodedImageCacheBudget / 4)
+		return buffer;
+
+	DecodedImage entry;
+	entry.buffer = buffer;
+	entry.srcData = srcData;
+	entry.size = size;
+	entry.lastUse = ++_decodedImageUseCounter;
+	entry.opaque = (key.transparentColor != -1);
+
+	// Look once for transparent pixels, so that fully opaque images
+	// can use the blitters which don't test every pixel...
+	const WizRawPixel transparentColor = (WizRawPixel)key.transparentColor;
+	if (_uses16BitColor) {
+		const WizRawPixel16 *pixels = (const WizRawPixel16 *)buffer();
+		for (uint32 i = 0; entry.opaque && i < pixelCount; i++)
+			entry.opaque = (pixels[i] != transparentColor);
+	} else {
+		const WizRawPixel8 *pixels = (const WizRawPixel8 *)buffer();
+		for (uint32 i = 0; entry.opaque && i < pixelCount; i++)
+			entry.opaque = (pixels[i] != transparentColor);
+	}
+
+	while (!_decodedImages.empty() && _decodedImageBytes + size > kDecodedImageCacheBudget) {
+		DecodedImageCache::iterator oldest = _decodedImages.begin();
+		for (it = _decodedImages.begin(); it != _decodedImages.end(); ++it) {
+			if (it->_value.lastUse < oldest->_value.lastUse)
+				oldest = it;
+		}
+
+		_decodedImageBytes -= oldest->_value.size;
+		_decodedImages.erase(oldest);
+		_decodedImageEvictions++;
+	}
+
+	_decodedImages[key] = entry;
+	_decodedImageBytes += size;
+
+	if (isOpaque)
+		*isOpaque = entry.opaque;
+
+	return buffer;
+}
+
+void Wiz::invalidateDecodedImage(int globNum) {
+	for (DecodedImageCache::iterator it = _decodedImages.begin(); it != _decodedImages.end(); ++it) {
+		if (it->_key.globNum == globNum) {
+			_decodedImageBytes -= it->_value.size;
+			_decodedImages.erase(it);
+		}
+	}
+}
+
+void Wiz::clearDecodedImageCache() {
+	_decodedImages.clear();
+	_decodedImageBytes = 0;
+}
+
+void Wiz::endDecodedImageCacheFrame() {
+	if (_decodedImageHits || _decodedImageMisses) {
+		debugC(DEBUG_RESOURCE, "Wiz::endDecodedImageCacheFrame(): %d hits, %d misses, %d evictions, %d images using %d bytes",
+			_decodedImageHits, _decodedImageMisses, _decodedImageEvictions, _decodedImages.size(), _decodedImageBytes);
+	}
+
+	_decodedImageHits = 0;
+	_decodedImageMisses = 0;
+	_decodedImageEvictions = 0;
+}
+
 void Wiz::buildAWiz(const WizPxShrdBuffer &bufPtr, int bufWidth, int bufHeight, const byte *palettePtr, const Common::Rect *rectPtr, int compressionType, int globNum, int transparentColor) {
 	int dataSize, globSize, dataOffset, counter, height, width;
 	Common::Rect compRect;
 	byte *ptr;
 
+	invalidateDecodedImage(globNum);
+
 	compRect.left = 0;
 	compRect.top = 0;
 	compRect.right = bufWidth - 1;
@@ -1395,6 +1529,8 @@ void Wiz::processWizImageDrawCmd(const WizImageCommand *params) {
 void Wiz::dwCreateRawWiz(int imageNum, int w, int h, int flags, int bitsPerPixel, int optionalSpotX, int optionalSpotY) {
 	int compressionType, wizdSize;
 
+	invalidateDecodedImage(imageNum);
+
 	int globSize = _vm->_resourceHeaderSize; // AWIZ header size
 	globSize += WIZBLOCK_WIZH_SIZE;
 
@@ -1486,6 +1622,9 @@ bool Wiz::dwGetMultiTypeBitmapFromImageState(int imageNum, int imageState, WizMu
 	byte *wizHeader;
 	byte *dataPtr;
 
+	// The caller might draw into the image...
+	invalidateDecodedImage(imageNum);
+
 	// Get the image header...
 	wizHeader = getWizStateHeaderPrim(imageNum, imageState);
 
@@ -1543,6 +1682,9 @@ bool Wiz::dwSetSimpleBitmapStructFromImage(int imageNum, int imageState, WizSimp
 	byte *wizHeader;
 	byte *dataPtr;
 
+	// The caller might draw into the image...
+	invalidateDecodedImage(imageNum);
+
 	// Get the image header...
 	wizHeader = (byte *)getWizStateHeaderPrim(imageNum, imageState);
 
@@ -1597,6 +1739,7 @@ int Wiz::dwTryToLoadWiz(Common::SeekableReadStream *inFile, const WizImageComman
 		return DW_LOAD_READ_FAILURE;
 	}
 
+	invalidateDecodedImage(params->image);
 	_vm->_res->setModified(rtImage, params->image);
 	return DW_LOAD_SUCCESS;
 }
@@ -1987,9 +2130,8 @@ void Wiz::handleRotate90SpecialCase(int image, int state, int x, int y, int shad
 	}
 
 	// Get the image from the basic drawing function...
-	srcBitmap.bufferPtr = drawAWizPrim(
-		image, state, 0, 0, 0, 0, 0, 0, kWRFAlloc,
-		0, optionalColorConversionTable);
+	bool isOpaque;
+	srcBitmap.bufferPtr = getDecodedAWizPrim(image, state, 0, optionalColorConversionTable, &isOpaque);
 
 	srcBitmap.bitmapWidth = w;
 	srcBitmap.bitmapHeight = h;
@@ -2002,7 +2144,7 @@ void Wiz::handleRotate90SpecialCase(int image, int state, int x, int y, int shad
 	}
 
 	// Call the 90 blit function...
-	if (_vm->VAR(_vm->VAR_WIZ_TRANSPARENT_COLOR) == -1) {
+	if (_vm->VAR(_vm->VAR_WIZ_TRANSPARENT_COLOR) == -1 || isOpaque) {
 		pgBlit90DegreeRotate(
 			&dstBitmap, x, y, &srcBitmap, nullptr, clipRect,
 			(flags & kWRFHFlip), (flags & kWRFVFlip));
@@ -2251,6 +2393,7 @@ void Wiz::remapImagePrim(int image, int state, int tableCount, const uint8 *rema
 	assert(basePtr);
 
 	// Set the modified bit...
+	invalidateDecodedImage(image);
 	_vm->_res->setModified(rtImage, image);
 	WRITE_BE_UINT32(basePtr + _vm->_resourceHeaderSize, WIZ_MAGIC_REMAP_NUMBER);
 	tablePtr = basePtr + _vm->_resourceHeaderSize + 4;
@@ -2848,6 +2991,7 @@ void Wiz::setWizCompressionType(int image, int state, int newType) {
 	assert(data);
 
 	WRITE_LE_UINT32(data + _vm->_resourceHeaderSize, newType);
+	invalidateDecodedImage(image);
 }
 
 int Wiz::getWizCompressionType(int image, int state) {
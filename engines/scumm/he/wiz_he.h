@@ -24,6 +24,7 @@
 
 //#define WIZ_DEBUG_BUFFERS
 
+#include "common/hashmap.h"
 #include "common/rect.h"
 
 namespace Scumm {
@@ -812,10 +813,64 @@ public:
 		Graphics::Surface *dstBitmap, int x, int y, Graphics::Surface *srcBitmap,
 		Common::Rect *optionalSrcRectPtr, Common::Rect *optionalclipRectPtr, int transferOp, MoonbaseDistortionInfo *mdi);
 
+	/*
+	 * Decoded image cache
+	 *
+	 * Rotated, scaled and warped draws need the whole image state decoded
+	 * to a temporary bitmap first. These bitmaps are kept, keyed by everything
+	 * the decoding depends on, until the image gets modified or the cache
+	 * goes over its byte budget, in which case the least recently used ones
+	 * are dropped.
+	 */
+	WizPxShrdBuffer getDecodedAWizPrim(int globNum, int state, int32 flags, const WizRawPixel *optionalColorConversionTable, bool *isOpaque = nullptr);
+	void invalidateDecodedImage(int globNum);
+	void clearDecodedImageCache();
+	void endDecodedImageCacheFrame();
 
 private:
 	ScummEngine_v71he *_vm;
 
+	struct DecodedImageKey {
+		int globNum;
+		int state;
+		int32 flags;
+		const WizRawPixel *conversionTable;
+		uint32 conversionTableHash;
+		int transparentColor;
+		int paletteChangedCounter;
+
+		bool operator==(const DecodedImageKey &other) const {
+			return globNum == other.globNum && state == other.state && flags == other.flags &&
+				conversionTable == other.conversionTable && conversionTableHash == other.conversionTableHash &&
+				transparentColor == other.transparentColor && paletteChangedCounter == other.paletteChangedCounter;
+		}
+	};
+
+	struct DecodedImageKeyHash {
+		uint operator()(const DecodedImageKey &key) const {
+			return (uint)(key.globNum * 31 + key.state) ^ (uint)key.flags ^ key.conversionTableHash;
+		}
+	};
+
+	struct DecodedImage {
+		WizPxShrdBuffer buffer;
+		const byte *srcData; // To notice resources which got reloaded elsewhere
+		uint32 size;
+		uint32 lastUse;
+		bool opaque;         // No pixel has the transparent color
+	};
+
+	typedef Common::HashMap<DecodedImageKey, DecodedImage, DecodedImageKeyHash> DecodedImageCache;
+
+	static const uint32 kDecodedImageCacheBudget = 8 * 1024 * 1024;
+
+	DecodedImageCache _decodedImages;
+	uint32 _decodedImageBytes = 0;
+	uint32 _decodedImageUseCounter = 0;
+	uint32 _decodedImageHits = 0;
+	uint32 _decodedImageMisses = 0;
+	uint32 _decodedImageEvictions = 0;
+
 
 public:
 	/* Drawing Primitives
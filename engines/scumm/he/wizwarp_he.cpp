@@ -81,6 +81,7 @@ bool Wiz::warpDrawWizTo4Points(int image, int state, const WarpWizPoint *dstPoin
 	int x, y;
 	WarpWizPoint srcPoints[4];
 	byte *ptr;
+	bool isOpaque = false;
 
 	// Set the optional remap table up to the default if one isn't specified...
 	if (!optionalColorConversionTable && _uses16BitColor) {
@@ -91,7 +92,7 @@ bool Wiz::warpDrawWizTo4Points(int image, int state, const WarpWizPoint *dstPoin
 	if ((getWizCompressionType(image, state) != kWCTNone) ||
 		(optionalColorConversionTable != nullptr) || (flags & (kWRFHFlip | kWRFVFlip | kWRFRemap))) {
 
-		srcBitmap.bufferPtr = drawAWizPrim(image, state, 0, 0, 0, 0, 0, 0, kWRFAlloc | flags, 0, optionalColorConversionTable);
+		srcBitmap.bufferPtr = getDecodedAWizPrim(image, state, flags, optionalColorConversionTable, &isOpaque);
 
 		if (!srcBitmap.bufferPtr()) {
 			return false;
@@ -157,6 +158,12 @@ bool Wiz::warpDrawWizTo4Points(int image, int state, const WarpWizPoint *dstPoin
 	srcPoints[3].x = 0;
 	srcPoints[3].y = srcBitmap.bitmapHeight - 1;
 
+	// Images without transparent pixels don't need the color key test...
+	if (isOpaque && !colorMixTable && !(flags & kWRFAreaSampleDuringWarp) &&
+		transparentColor == (_vm->_game.heversion < 95 ? 0x05 : _vm->VAR(_vm->VAR_WIZ_TRANSPARENT_COLOR))) {
+		transparentColor = -1;
+	}
+
 	// Call the warping primitive...
 	if (_vm->_game.heversion >= 95 && colorMixTable) {
 		rValue = warpNPt2NPtClippedWarpMixColors(
@@ -257,6 +257,7 @@ MODULE_OBJS += \
 	he/logic/moonbase_logic.o \
 	he/logic/puttrace.o \
 	he/logic/soccer.o \
+	he/moonbase/ai_benchmark.o \
 	he/moonbase/ai_defenseunit.o \
 	he/moonbase/ai_main.o \
 	he/moonbase/ai_node.o \
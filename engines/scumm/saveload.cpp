@@ -2378,6 +2378,9 @@ void ScummEngine_v71he::saveLoadWithSerializer(Common::Serializer &s) {
 	ScummEngine_v70he::saveLoadWithSerializer(s);
 
 	s.syncArray(_wiz->_polygons, ARRAYSIZE(_wiz->_polygons), syncWithSerializer);
+
+	if (s.isLoading())
+		_wiz->clearDecodedImageCache();
 }
 
 void syncWithSerializer(Common::Serializer &s, FloodFillCommand &ffc) {
@@ -154,6 +154,7 @@ namespace {
 // -----------------------------------------------------------------------------
 
 const uint32 MAX_ACCEPTED_FLASH_VERSION = 3;   // The maximum flash file version that is accepted by the loader
+const uint   RENDER_CACHE_BUDGET = 8 * 1024 * 1024; // The memory in bytes used by rasterized vector images
 
 
 // -----------------------------------------------------------------------------
@@ -212,7 +213,10 @@ Common::Rect CalculateBoundingBox(const VectorImageElement &vectorImageElement)
 // Construction
 // -----------------------------------------------------------------------------
 
-VectorImage::VectorImage(const byte *pFileData, uint fileSize, bool &success, const Common::String &fname) : _pixelData(0), _fname(fname) {
+Common::List<VectorImage::RenderCacheEntry> *VectorImage::_renderCache = nullptr;
+uint VectorImage::_renderCacheSize = 0;
+
+VectorImage::VectorImage(const byte *pFileData, uint fileSize, bool &success, const Common::String &fname) : _pixelData(0), _renderedImage(0), _fname(fname) {
 	success = false;
 	_bgColor = 0;
 
@@ -309,6 +313,8 @@ VectorImage::~VectorImage() {
 			if (_elements[j].getPathInfo(i).getVec())
 				free(_elements[j].getPathInfo(i).getVec());
 
+	removeFromRenderCache();
+	delete _renderedImage;
 	free(_pixelData);
 }
 
@@ -613,31 +619,78 @@ bool VectorImage::blit(int posX, int posY,
 					   uint color,
 					   int width, int height,
 					   RectangleList *updateRects) {
-	static VectorImage *oldThis = 0;
-	static int              oldWidth = -2;
-	static int              oldHeight = -2;
-
 	// If width or height to 0, nothing needs to be shown.
 	if (width == 0 || height == 0)
 		return true;
 
-	// Determine if the old image in the cache can not be reused and must be recalculated
-	if (!(oldThis == this && oldWidth == width && oldHeight == height)) {
-		render(width, height);
+	byte *pixelData = getRenderedPixelData(width, height);
+
+	// The rendered image does not own the pixel data, so it can be reused for every blit
+	if (!_renderedImage)
+		_renderedImage = new RenderedImage();
+
+	_renderedImage->replaceContent(pixelData, width, height);
+	_renderedImage->blit(posX, posY, flipping, pPartRect, color, width, height, updateRects);
+
+	return true;
+}
+
+byte *VectorImage::getRenderedPixelData(int width, int height) {
+	if (!_renderCache)
+		_renderCache = new Common::List<RenderCacheEntry>();
+
+	for (Common::List<RenderCacheEntry>::iterator it = _renderCache->begin(); it != _renderCache->end(); ++it) {
+		if (it->image == this && it->width == width && it->height == height) {
+			// Move the entry to the front of the list
+			RenderCacheEntry entry = *it;
+			_renderCache->erase(it);
+			_renderCache->push_front(entry);
+			return entry.pixelData;
+		}
+	}
 
-		oldThis = this;
-		oldHeight = height;
-		oldWidth = width;
+	// The image can not be found in the cache and must be rendered
+	render(width, height);
+
+	RenderCacheEntry entry;
+	entry.image = this;
+	entry.width = width;
+	entry.height = height;
+	entry.pixelData = _pixelData;
+	entry.size = ABS(width * height) * 4;
+	_pixelData = 0;
+
+	// Evict the least recently used images until the new one fits
+	while (!_renderCache->empty() && _renderCacheSize + entry.size > RENDER_CACHE_BUDGET) {
+		_renderCacheSize -= _renderCache->back().size;
+		free(_renderCache->back().pixelData);
+		_renderCache->pop_back();
 	}
 
-	RenderedImage *rend = new RenderedImage();
+	_renderCache->push_front(entry);
+	_renderCacheSize += entry.size;
 
-	rend->replaceContent(_pixelData, width, height);
-	rend->blit(posX, posY, flipping, pPartRect, color, width, height, updateRects);
+	return entry.pixelData;
+}
 
-	delete rend;
+void VectorImage::removeFromRenderCache() {
+	if (!_renderCache)
+		return;
 
-	return true;
+	for (Common::List<RenderCacheEntry>::iterator it = _renderCache->begin(); it != _renderCache->end(); ) {
+		if (it->image == this) {
+			_renderCacheSize -= it->size;
+			free(it->pixelData);
+			it = _renderCache->erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	if (_renderCache->empty()) {
+		delete _renderCache;
+		_renderCache = nullptr;
+	}
 }
 
 } // End of namespace Sword25
@@ -37,6 +37,7 @@
 
 #include "sword25/kernel/common.h"
 #include "sword25/gfx/image/image.h"
+#include "common/list.h"
 #include "common/rect.h"
 
 #include "art.h"
@@ -44,6 +45,7 @@
 namespace Sword25 {
 
 class VectorImage;
+class RenderedImage;
 
 /**
 	@brief Pfadinformationen zu BS_VectorImageElement Objekten
@@ -223,6 +225,27 @@ private:
 
 	byte *_pixelData;
 
+	/**
+	 * Rasterized images are kept in a cache shared by all vector images, most
+	 * recently used first, so that several vector images drawn in the same
+	 * frame do not have to be rendered again every frame.
+	 */
+	struct RenderCacheEntry {
+		VectorImage *image;
+		int width;
+		int height;
+		byte *pixelData;
+		uint size;
+	};
+
+	static Common::List<RenderCacheEntry> *_renderCache;
+	static uint _renderCacheSize;
+
+	byte *getRenderedPixelData(int width, int height);
+	void removeFromRenderCache();
+
+	RenderedImage *_renderedImage;
+
 	Common::String _fname;
 	uint _bgColor;
 };
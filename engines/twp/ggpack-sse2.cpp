@@ -0,0 +1,80 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "twp/ggpack.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Twp {
+
+// Each byte is xored with its key byte and with the previous key byte, where
+// the key byte only depends on the pre-xor value and the index of the byte.
+// So 16 key bytes are computed at once, and the previous ones are obtained by
+// shifting them by one byte and inserting the last key byte of the previous block.
+uint32 xorDecodeSSE2(byte *buf, uint32 size, int pos, const byte *magicBytes, int multiplier, int &previous) {
+	byte magic[32];
+	byte steps[16];
+	for (int i = 0; i < 32; i++)
+		magic[i] = magicBytes[(pos + i) & 0x0F];
+	for (int i = 0; i < 16; i++)
+		steps[i] = (byte)(i * multiplier);
+
+	const __m128i vMagic = _mm_loadu_si128((const __m128i *)magic);
+	const __m128i vSteps = _mm_loadu_si128((const __m128i *)steps);
+	__m128i carry = _mm_cvtsi32_si128(previous & 0xFF);
+
+	uint32 i = 0;
+	for (; i + 16 <= size; i += 16) {
+		const __m128i index = _mm_add_epi8(vSteps, _mm_set1_epi8((char)(i * multiplier)));
+		const __m128i key = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(buf + i)), _mm_xor_si128(vMagic, index));
+		const __m128i prev = _mm_or_si128(_mm_slli_si128(key, 1), carry);
+		_mm_storeu_si128((__m128i *)(buf + i), _mm_xor_si128(key, prev));
+		carry = _mm_srli_si128(key, 15);
+	}
+
+	previous = _mm_cvtsi128_si32(carry);
+	return i;
+}
+
+} // End of namespace Twp
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
@@ -21,6 +21,7 @@
 
 #include "common/archive.h"
 #include "common/debug.h"
+#include "common/system.h"
 #include "twp/detection.h"
 #include "twp/ggpack.h"
 
@@ -587,16 +588,29 @@ bool XorStream::open(Common::SeekableReadStream *stream, int len, const XorKey &
 	_previous = (len & 0xFF);
 	_key = key;
 	_size = len;
+	for (int i = 0; i < 16; i++)
+		_magicBytes[i] = (byte)_key.magicBytes[i];
+#ifdef SCUMMVM_SSE2
+	_useSSE2 = g_system->hasFeature(OSystem::kFeatureCpuSSE2);
+#endif
 	return true;
 }
 
 uint32 XorStream::read(void *dataPtr, uint32 dataSize) {
 	int p = (int)pos();
 	uint32 result = _s->read(dataPtr, dataSize);
-	char *buf = (char *)dataPtr;
-	for (size_t i = 0; i < dataSize; i++) {
-		int x = buf[i] ^ _key.magicBytes[p & 0x0F] ^ (i * _key.multiplier);
-		buf[i] = (char)(x ^ _previous);
+	byte *buf = (byte *)dataPtr;
+	uint32 i = 0;
+#ifdef SCUMMVM_SSE2
+	if (_useSSE2) {
+		i = xorDecodeSSE2(buf, dataSize, p, _magicBytes, _key.multiplier, _previous);
+		p += i;
+	}
+#endif
+	// Only the low byte of the key matters, so no sign extension is needed
+	for (; i < dataSize; i++) {
+		int x = buf[i] ^ _magicBytes[p & 0x0F] ^ (i * _key.multiplier);
+		buf[i] = (byte)(x ^ _previous);
 		_previous = x;
 		p++;
 	}
@@ -92,8 +92,15 @@ private:
 	int _start = 0;
 	int _size = 0;
 	XorKey _key;
+	byte _magicBytes[16];
+	bool _useSSE2 = false;
 };
 
+#ifdef SCUMMVM_SSE2
+// Decodes 16 bytes at a time; returns the number of bytes decoded
+uint32 xorDecodeSSE2(byte *buf, uint32 size, int pos, const byte *magicBytes, int multiplier, int &previous);
+#endif
+
 class RangeStream : public Common::SeekableReadStream {
 public:
 	RangeStream();
@@ -66,6 +66,11 @@ MODULE_OBJS += \
 
 endif
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	ggpack-sse2.o
+endif
+
 # This module can be built as a plugin
 ifeq ($(ENABLE_TWP), DYNAMIC_PLUGIN)
 PLUGIN := 1
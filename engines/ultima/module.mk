@@ -572,6 +572,7 @@ MODULE_OBJS += \
 	ultima8/world/item_factory.o \
 	ultima8/world/item_selection_process.o \
 	ultima8/world/item_sorter.o \
+	ultima8/world/item_sorter_list.o \
 	ultima8/world/map.o \
 	ultima8/world/map_glob.o \
 	ultima8/world/minimap.o \
@@ -141,6 +141,9 @@ Debugger::Debugger() : GUI::Debugger() {
 	registerCmd("UCMachine::traceClass", WRAP_METHOD(Debugger, cmdTraceClass));
 	registerCmd("UCMachine::traceAll", WRAP_METHOD(Debugger, cmdTraceAll));
 	registerCmd("UCMachine::stopTrace", WRAP_METHOD(Debugger, cmdStopTrace));
+	registerCmd("UCMachine::startProfile", WRAP_METHOD(Debugger, cmdStartProfile));
+	registerCmd("UCMachine::stopProfile", WRAP_METHOD(Debugger, cmdStopProfile));
+	registerCmd("UCMachine::showProfile", WRAP_METHOD(Debugger, cmdShowProfile));
 
 	registerCmd("FastAreaVisGump::toggle", WRAP_METHOD(Debugger, cmdToggleFastArea));
 	registerCmd("InverterProcess::invertScreen", WRAP_METHOD(Debugger, cmdInvertScreen));
@@ -1530,6 +1533,25 @@ bool Debugger::cmdStopTrace(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdStartProfile(int argc, const char **argv) {
+	UCMachine::get_instance()->startProfiling();
+
+	debugPrintf("UCMachine: profiling usecode\n");
+	return true;
+}
+
+bool Debugger::cmdStopProfile(int argc, const char **argv) {
+	UCMachine *uc = UCMachine::get_instance();
+	uc->stopProfiling();
+	uc->usecodeProfile();
+	return true;
+}
+
+bool Debugger::cmdShowProfile(int argc, const char **argv) {
+	UCMachine::get_instance()->usecodeProfile();
+	return true;
+}
+
 bool Debugger::cmdVerifyQuit(int argc, const char **argv) {
 	QuitGump::verifyQuit();
 	return false;
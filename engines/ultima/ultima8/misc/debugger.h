@@ -119,6 +119,9 @@ private:
 	bool cmdTraceClass(int argc, const char **argv);
 	bool cmdTraceAll(int argc, const char **argv);
 	bool cmdStopTrace(int argc, const char **argv);
+	bool cmdStartProfile(int argc, const char **argv);
+	bool cmdStopProfile(int argc, const char **argv);
+	bool cmdShowProfile(int argc, const char **argv);
 
 	// Miscellaneous
 	bool cmdToggleFastArea(int argc, const char **argv);
@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "common/memstream.h"
 
 #include "ultima/ultima8/usecode/uc_machine.h"
@@ -27,6 +28,7 @@
 #include "ultima/ultima8/kernel/kernel.h"
 #include "ultima/ultima8/kernel/delay_process.h"
 #include "ultima/ultima8/ultima8.h"
+#include "ultima/ultima8/games/game_data.h"
 #include "ultima/ultima8/world/current_map.h"
 #include "ultima/ultima8/world/world.h"
 #include "ultima/ultima8/usecode/bit_set.h"
@@ -79,6 +81,223 @@ enum UCSegments {
 	SEG_GLOBAL     = 0x8003
 };
 
+/**
+ * Reads the code of a usecode class while decoding it. Reading past the end
+ * of the code gives zeros, as with a MemoryReadStream.
+ */
+class UCCodeReader {
+public:
+	UCCodeReader(const uint8 *code, uint32 size) : _code(code), _size(size), _pos(0) { }
+
+	uint32 pos() const {
+		return _pos;
+	}
+
+	void seek(uint32 pos) {
+		assert(pos <= _size);
+		_pos = pos;
+	}
+
+	uint8 readByte() {
+		return _pos < _size ? _code[_pos++] : 0;
+	}
+
+	int8 readSByte() {
+		return static_cast<int8>(readByte());
+	}
+
+	uint16 readUint16LE() {
+		uint16 val = readByte();
+		return val | (readByte() << 8);
+	}
+
+	uint32 readUint32LE() {
+		uint32 val = readUint16LE();
+		return val | (static_cast<uint32>(readUint16LE()) << 16);
+	}
+
+	void read(void *dataPtr, uint32 dataSize) {
+		uint32 avail = MIN(dataSize, _size - _pos);
+		memcpy(dataPtr, _code + _pos, avail);
+		memset(static_cast<uint8 *>(dataPtr) + avail, 0, dataSize - avail);
+		_pos += avail;
+	}
+
+private:
+	const uint8 *_code;
+	uint32 _size;
+	uint32 _pos;
+};
+
+/**
+ * A decoded usecode instruction. The operands are stored in the order the
+ * opcode reads them, intrinsic calls have their function resolved, and
+ * strings are kept by the class and referred to by their index.
+ */
+struct UCInstruction {
+	uint8 opcode;
+	uint32 next; ///< offset of the following instruction
+	int32 op[5];
+	Intrinsic intrinsic;
+};
+
+/**
+ * The code of a usecode class, decoded one instruction at a time the first
+ * time it runs. All processes running code of the class share it.
+ */
+class UCDecodedClass {
+public:
+	UCDecodedClass(const uint8 *code, uint32 size, uint16 classId, const Intrinsic *intrinsics, unsigned int intrinsicCount) :
+		_code(code), _size(size), _classId(classId), _intrinsics(intrinsics), _intrinsicCount(intrinsicCount) {
+		_index.resize(size + 1);
+	}
+
+	const uint8 *getCode() const {
+		return _code;
+	}
+
+	uint32 getSize() const {
+		return _size;
+	}
+
+	uint32 getNumInstructions() const {
+		return _instructions.size();
+	}
+
+	const UCInstruction &getInstruction(uint32 offset) {
+		assert(offset <= _size);
+		if (!_index[offset])
+			decode(offset);
+		return _instructions[_index[offset] - 1];
+	}
+
+	const char *getString(uint32 index) const {
+		return _strings[index].c_str();
+	}
+
+private:
+	void decode(uint32 offset);
+
+	const uint8 *_code;
+	uint32 _size;
+	uint16 _classId;
+	const Intrinsic *_intrinsics;
+	unsigned int _intrinsicCount;
+
+	Common::Array<uint16> _index; ///< 1 + index of the instruction at each offset, or 0
+	Common::Array<UCInstruction> _instructions;
+	Common::Array<Common::String> _strings;
+};
+
+// The operands of each opcode, in the order they are read:
+// 's' signed byte, 'b' byte, 'w' 16 bit, 'l' 32 bit
+static const char *getOperandTypes(uint8 opcode) {
+	switch (opcode) {
+	case 0x00: case 0x01: case 0x02: case 0x0A:
+	case 0x3E: case 0x3F: case 0x40: case 0x41: case 0x43: case 0x4B:
+	case 0x62: case 0x63: case 0x64: case 0x65: case 0x66: case 0x67:
+	case 0x69: case 0x6E: case 0x6F:
+		return "s";
+	case 0x03: case 0x42: case 0x45:
+		return "sb";
+	case 0x09:
+		return "sbs";
+	case 0x0B: case 0x0D: case 0x51: case 0x52: case 0x54: case 0x5B:
+	case 0x5C: case 0x79:
+		return "w";
+	case 0x0C:
+		return "l";
+	case 0x0E: case 0x38: case 0x44: case 0x6C:
+		return "bb";
+	case 0x0F:
+		return "bw";
+	case 0x4E: case 0x4F:
+		return "wb";
+	case 0x11:
+		return "ww";
+	case 0x19: case 0x1A: case 0x1B: case 0x4C: case 0x4D: case 0x5A: case 0x74:
+		return "b";
+	case 0x57:
+		return "bbww";
+	case 0x58:
+		return "wwwbb";
+	case 0x70:
+		return "sbb";
+	case 0x75: case 0x76:
+		return "bbw";
+	default:
+		return "";
+	}
+}
+
+void UCDecodedClass::decode(uint32 offset) {
+	UCCodeReader cs(_code, _size);
+	cs.seek(offset);
+
+	UCInstruction ins;
+	ins.opcode = cs.readByte();
+	ins.intrinsic = nullptr;
+	memset(ins.op, 0, sizeof(ins.op));
+
+	int n = 0;
+	for (const char *type = getOperandTypes(ins.opcode); *type; type++) {
+		switch (*type) {
+		case 's':
+			ins.op[n++] = cs.readSByte();
+			break;
+		case 'b':
+			ins.op[n++] = cs.readByte();
+			break;
+		case 'w':
+			ins.op[n++] = cs.readUint16LE();
+			break;
+		default:
+			ins.op[n++] = cs.readUint32LE();
+			break;
+		}
+	}
+
+	if (ins.opcode == 0x0D) {
+		// 0D xx xx yy ... yy 00: the string, followed by its terminator
+		uint16 length = ins.op[0];
+		char *str = new char[length + 1];
+		cs.read(str, length);
+		str[length] = 0;
+
+		// WORKAROUND: German U8: When the candles are not in the right positions
+		// for a sorcery spell, the string does not match, causing a crash.
+		// Original bug: https://sourceforge.net/p/pentagram/bugs/196/
+		if (GAME_IS_U8 && _classId == 0x7C) {
+			if (!strcmp(str, " Irgendetwas stimmt nicht!")) {
+				str[25] = '.'; // ! to .
+			}
+		}
+
+		ins.op[1] = _strings.size();
+		_strings.push_back(str);
+		delete[] str;
+		ins.op[2] = cs.readByte();
+	} else if (ins.opcode == 0x5C) {
+		// 5C xx xx char[9]: the class name and its terminator
+		char name[10] = {0};
+		for (int x = 0; x < 9; x++)
+			name[x] = cs.readByte();
+
+		ins.op[1] = _strings.size();
+		_strings.push_back(name);
+	} else if (ins.opcode == 0x0F) {
+		uint16 func = ins.op[1];
+		if (func < _intrinsicCount)
+			ins.intrinsic = _intrinsics[func];
+	}
+
+	ins.next = cs.pos();
+
+	_instructions.push_back(ins);
+	assert(_instructions.size() <= 0xFFFF);
+	_index[offset] = _instructions.size();
+}
+
 UCMachine *UCMachine::_ucMachine = nullptr;
 
 UCMachine::UCMachine(const Intrinsic *iset, unsigned int icount) {
@@ -110,6 +329,9 @@ UCMachine::UCMachine(const Intrinsic *iset, unsigned int icount) {
 
 	_tracingEnabled = false;
 	_traceAll = false;
+
+	_profilingEnabled = false;
+	memset(_profileOpcodes, 0, sizeof(_profileOpcodes));
 }
 
 
@@ -121,11 +343,16 @@ UCMachine::~UCMachine() {
 	delete _convUse;
 	delete _listIDs;
 	delete _stringIDs;
+
+	clearDecodedClasses();
 }
 
 void UCMachine::reset() {
 	debug(1, "Resetting UCMachine");
 
+	// the usecode may be reloaded at the same address
+	clearDecodedClasses();
+
 	// clear _globals
 	_globals->setSize(0x1000);
 
@@ -147,15 +374,34 @@ void UCMachine::reset() {
 void UCMachine::loadIntrinsics(const Intrinsic *i, unsigned int icount) {
 	_intrinsics = i;
 	_intrinsicCount = icount;
+
+	// decoded intrinsic calls refer to the previous intrinsics
+	clearDecodedClasses();
+}
+
+UCDecodedClass *UCMachine::getDecodedClass(const UCProcess *p) {
+	uint32 base = p->_usecode->get_class_base_offset(p->_classId);
+	const uint8 *code = p->_usecode->get_class(p->_classId) + base;
+	uint32 size = p->_usecode->get_class_size(p->_classId) - base;
+
+	UCDecodedClass *&decoded = _decodedClasses[p->_classId];
+	if (!decoded || decoded->getCode() != code || decoded->getSize() != size) {
+		delete decoded;
+		decoded = new UCDecodedClass(code, size, p->_classId, _intrinsics, _intrinsicCount);
+	}
+	return decoded;
+}
+
+void UCMachine::clearDecodedClasses() {
+	for (auto &i : _decodedClasses)
+		delete i._value;
+	_decodedClasses.clear();
 }
 
 void UCMachine::execProcess(UCProcess *p) {
 	assert(p);
 
-	uint32 base = p->_usecode->get_class_base_offset(p->_classId);
-	Common::SeekableReadStream *cs = new Common::MemoryReadStream(p->_usecode->get_class(p->_classId) + base,
-																  p->_usecode->get_class_size(p->_classId) - base);
-	cs->seek(p->_ip);
+	UCDecodedClass *code = getDecodedClass(p);
 
 	bool trace = trace_show(p->_pid, p->_itemNum, p->_classId);
 	if (trace) {
@@ -171,7 +417,16 @@ void UCMachine::execProcess(UCProcess *p) {
 		//! guard against reading past end of class
 		//! guard against other error conditions
 
-		uint8 opcode = cs->readByte();
+		// The instruction is copied, as processes spawned by it run
+		// right away and may decode more of this class
+		const UCInstruction ins = code->getInstruction(p->_ip);
+		const uint8 opcode = ins.opcode;
+		uint32 nextIp = ins.next;
+
+		if (_profilingEnabled) {
+			_profileOpcodes[opcode]++;
+			_profileClasses[p->_classId]++;
+		}
 
 #ifdef DEBUG_USECODE
 		char op_info[32];
@@ -193,7 +448,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x00:
 			// 00 xx
 			// pop 16 bit int, and assign LS 8 bit int into bp+xx
-			si8a = cs->readSByte();
+			si8a = ins.op[0];
 			ui16a = p->_stack.pop2();
 			p->_stack.assign1(p->_bp + si8a, static_cast<uint8>(ui16a));
 			TRACE_OP("%s\tpop byte\t%s = %02Xh", op_info, print_bp(si8a), ui16a);
@@ -202,7 +457,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x01:
 			// 01 xx
 			// pop 16 bit int into bp+xx
-			si8a = cs->readSByte();
+			si8a = ins.op[0];
 			ui16a = p->_stack.pop2();
 			p->_stack.assign2(p->_bp + si8a, ui16a);
 			TRACE_OP("%s\tpop\t\t%s = %04Xh", op_info, print_bp(si8a), ui16a);
@@ -211,7 +466,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x02:
 			// 02 xx
 			// pop 32 bit int into bp+xx
-			si8a = cs->readSByte();
+			si8a = ins.op[0];
 			ui32a = p->_stack.pop4();
 			p->_stack.assign4(p->_bp + si8a, ui32a);
 			TRACE_OP("%s\tpop dword\t%s = %08Xh", op_info, print_bp(si8a), ui32a);
@@ -220,8 +475,8 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x03: {
 			// 03 xx yy
 			// pop yy bytes into bp+xx
-			si8a = cs->readSByte();
-			uint8 size = cs->readByte();
+			si8a = ins.op[0];
+			uint8 size = ins.op[1];
 			uint8 buf[256];
 			p->_stack.pop(buf, size);
 			p->_stack.assign(p->_bp + si8a, buf, size);
@@ -244,9 +499,9 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x09: {
 			// 09 xx yy zz
 			// pop yy bytes into an element of list bp+xx (or slist if zz set)
-			si8a = cs->readSByte();
-			ui32a = cs->readByte();
-			si8b = cs->readSByte();
+			si8a = ins.op[0];
+			ui32a = ins.op[1];
+			si8b = ins.op[2];
 			TRACE_OP("%s\tassign element\t%s (%02X) (slist==%02X)",
 				  op_info, print_bp(si8a), ui32a, si8b);
 			ui16a = p->_stack.pop2() - 1; // index
@@ -278,7 +533,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x0A:
 			// 0A xx
 			// push sign-extended 8 bit xx onto the stack as 16 bit
-			ui16a = cs->readSByte();
+			ui16a = ins.op[0];
 			p->_stack.push2(ui16a);
 			TRACE_OP("%s\tpush sbyte\t%04Xh", op_info, ui16a);
 			break;
@@ -286,7 +541,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x0B:
 			// 0B xx xx
 			// push 16 bit xxxx onto the stack
-			ui16a = cs->readUint16LE();
+			ui16a = ins.op[0];
 			p->_stack.push2(ui16a);
 			TRACE_OP("%s\tpush\t\t%04Xh", op_info, ui16a);
 			break;
@@ -294,7 +549,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x0C:
 			// 0C xx xx xx xx
 			// push 32 bit xxxxxxxx onto the stack
-			ui32a = cs->readUint32LE();
+			ui32a = ins.op[0];
 			p->_stack.push4(ui32a);
 			TRACE_OP("%s\tpush dword\t%08Xh", op_info, ui32a);
 			break;
@@ -302,28 +557,14 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x0D: {
 			// 0D xx xx yy ... yy 00
 			// push string (yy ... yy) of length xx xx onto the stack
-			ui16a = cs->readUint16LE();
-			char *str = new char[ui16a + 1];
-			cs->read(str, ui16a);
-			str[ui16a] = 0;
-
-			// WORKAROUND: German U8: When the candles are not in the right positions
-			// for a sorcery spell, the string does not match, causing a crash.
-			// Original bug: https://sourceforge.net/p/pentagram/bugs/196/
-			if (GAME_IS_U8 && p->_classId == 0x7C) {
-				if (!strcmp(str, " Irgendetwas stimmt nicht!")) {
-					str[25] = '.'; // ! to .
-				}
-			}
-
+			const char *str = code->getString(ins.op[1]);
 			TRACE_OP("%s\tpush string\t\"%s\"", op_info, str);
-			ui16b = cs->readByte();
+			ui16b = ins.op[2];
 			if (ui16b != 0) {
 				warning("Zero terminator missing in push string");
 				error = true;
 			}
 			p->_stack.push2(assignString(str));
-			delete[] str;
 			break;
 		}
 
@@ -331,8 +572,8 @@ void UCMachine::execProcess(UCProcess *p) {
 			// 0E xx yy
 			// pop yy values of size xx and push the resulting list
 			// (list is created in reverse order)
-			ui16a = cs->readByte();
-			ui16b = cs->readByte();
+			ui16a = ins.op[0];
+			ui16b = ins.op[1];
 			UCList *l = new UCList(ui16a, ui16b);
 			p->_stack.addSP(ui16a * (ui16b - 1));
 			for (unsigned int i = 0; i < ui16b; i++) {
@@ -352,26 +593,25 @@ void UCMachine::execProcess(UCProcess *p) {
 			// intrinsic call. xx is number of argument bytes
 			// (includes this pointer, if present)
 			// NB: do not actually pop these argument bytes
-			uint16 arg_bytes = cs->readByte();
-			uint16 func = cs->readUint16LE();
+			uint16 arg_bytes = ins.op[0];
+			uint16 func = ins.op[1];
 			TRACE_OP("%s\tcalli\t\t%04Xh (%02Xh arg bytes) %s",
 				  op_info, func, arg_bytes, _convUse->intrinsics()[func]);
 
 			// !constants
-			if (func >= _intrinsicCount || _intrinsics[func] == 0) {
+			if (!ins.intrinsic) {
 				Item *testItem = nullptr;
 				p->_temp32 = 0;
 
 				if (arg_bytes >= 4) {
 					// HACKHACKHACK to check what the argument is.
-					uint8 *argmem = new uint8[arg_bytes];
+					uint8 argmem[4];
 					uint8 *args = argmem;
 					p->_stack.pop(args, 4);
 					p->_stack.addSP(-4); // don't really pop the args
 					ARG_UC_PTR(iptr);
 					uint16 testItemId = ptrToObject(iptr);
 					testItem = getItem(testItemId);
-					delete [] argmem;
 				}
 
 				Common::String info;
@@ -388,17 +628,19 @@ void UCMachine::execProcess(UCProcess *p) {
 				}
 			} else {
 				//!! hackish
-				if (_intrinsics[func] == UCMachine::I_dummyProcess ||
-				        _intrinsics[func] == UCMachine::I_true) {
+				if (ins.intrinsic == UCMachine::I_dummyProcess ||
+				        ins.intrinsic == UCMachine::I_true) {
 					warning("Unhandled intrinsic %u \'%s\'? called", func, _convUse->intrinsics()[func]);
 				}
-				uint8 *argbuf = new uint8[arg_bytes];
+				// arg_bytes is read from a single byte
+				uint8 argbuf[256];
 				p->_stack.pop(argbuf, arg_bytes);
 				p->_stack.addSP(-arg_bytes); // don't really pop the args
 
-				p->_temp32 = _intrinsics[func](argbuf, arg_bytes);
+				if (_profilingEnabled)
+					_profileIntrinsics[func]++;
 
-				delete[] argbuf;
+				p->_temp32 = ins.intrinsic(argbuf, arg_bytes);
 			}
 
 			// WORKAROUND: In U8, the flag 'startedConvo' [0000 01] which acts
@@ -422,23 +664,20 @@ void UCMachine::execProcess(UCProcess *p) {
 			// call the function at offset yy yy of class xx xx
 			// Crusader:
 			// call function number yy yy of class xx xx
-			uint16 new_classid = cs->readUint16LE();
-			uint16 new_offset = cs->readUint16LE();
+			uint16 new_classid = ins.op[0];
+			uint16 new_offset = ins.op[1];
 			TRACE_OP("%s\tcall\t\t%04X:%04X", op_info, new_classid, new_offset);
 			if (GAME_IS_CRUSADER) {
 				new_offset = p->_usecode->get_class_event(new_classid,
 				             new_offset);
 			}
 
-			p->_ip = static_cast<uint16>(cs->pos());   // Truncates!!
+			p->_ip = static_cast<uint16>(nextIp);   // Truncates!!
 			p->call(new_classid, new_offset);
 
 			// Update the code segment
-			uint32 base_ = p->_usecode->get_class_base_offset(p->_classId);
-			delete cs;
-			cs = new Common::MemoryReadStream(p->_usecode->get_class(p->_classId) + base_,
-											  p->_usecode->get_class_size(p->_classId) - base_);
-			cs->seek(p->_ip);
+			code = getDecodedClass(p);
+			nextIp = p->_ip;
 
 			// Resume execution
 			break;
@@ -537,7 +776,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x19: {
 			// 19 02
 			// add two stringlists, removing duplicates
-			ui32a = cs->readByte();
+			ui32a = ins.op[0];
 			if (ui32a != 2) {
 				warning("Unhandled operand %u to union slist", ui32a);
 				error = true;
@@ -560,7 +799,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x1A: {
 			// 1A 02
 			// subtract string list
-			ui32a = cs->readByte(); // elementsize (always 02)
+			ui32a = ins.op[0]; // elementsize (always 02)
 			ui32a = 2;
 			ui16a = p->_stack.pop2();
 			ui16b = p->_stack.pop2();
@@ -582,7 +821,7 @@ void UCMachine::execProcess(UCProcess *p) {
 			// pop two lists from the stack of element size xx and
 			// remove the 2nd from the 1st
 			// (free the originals? order?)
-			ui32a = cs->readByte(); // elementsize
+			ui32a = ins.op[0]; // elementsize
 			ui16a = p->_stack.pop2();
 			ui16b = p->_stack.pop2();
 			UCList *srclist = getList(ui16a);
@@ -945,8 +1184,8 @@ void UCMachine::execProcess(UCProcess *p) {
 			// is element (size xx) in list? (or slist if yy is true)
 			// free list/slist afterwards
 
-			ui16a = cs->readByte();
-			ui32a = cs->readByte();
+			ui16a = ins.op[0];
+			ui32a = ins.op[1];
 			ui16b = p->_stack.pop2();
 			UCList *l = getList(ui16b);
 			if (!l) {
@@ -1034,7 +1273,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x3E:
 			// 3E xx
 			// push the value of the sign-extended 8 bit local var xx as 16 bit int
-			si8a = cs->readSByte();
+			si8a = ins.op[0];
 			ui16a = static_cast<uint16>(static_cast<int8>(p->_stack.access1(p->_bp + si8a)));
 			p->_stack.push2(ui16a);
 			TRACE_OP("%s\tpush byte\t%s = %02Xh", op_info, print_bp(si8a), ui16a);
@@ -1043,7 +1282,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x3F:
 			// 3F xx
 			// push the value of the 16 bit local var xx
-			si8a = cs->readSByte();
+			si8a = ins.op[0];
 			ui16a = p->_stack.access2(p->_bp + si8a);
 			p->_stack.push2(ui16a);
 			TRACE_OP("%s\tpush\t\t%s = %04Xh", op_info, print_bp(si8a), ui16a);
@@ -1052,7 +1291,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x40:
 			// 40 xx
 			// push the value of the 32 bit local var xx
-			si8a = cs->readSByte();
+			si8a = ins.op[0];
 			ui32a = p->_stack.access4(p->_bp + si8a);
 			p->_stack.push4(ui32a);
 			TRACE_OP("%s\tpush dword\t%s = %08Xh", op_info, print_bp(si8a), ui32a);
@@ -1062,7 +1301,7 @@ void UCMachine::execProcess(UCProcess *p) {
 			// 41 xx
 			// push the string local var xx
 			// duplicating the string?
-			si8a = cs->readSByte();
+			si8a = ins.op[0];
 			ui16a = p->_stack.access2(p->_bp + si8a);
 			p->_stack.push2(duplicateString(ui16a));
 			TRACE_OP("%s\tpush string\t%s", op_info, print_bp(si8a));
@@ -1072,8 +1311,8 @@ void UCMachine::execProcess(UCProcess *p) {
 			// 42 xx yy
 			// push the list (with yy size elements) at BP+xx
 			// duplicating the list?
-			si8a = cs->readSByte();
-			ui16a = cs->readByte();
+			si8a = ins.op[0];
+			ui16a = ins.op[1];
 			ui16b = p->_stack.access2(p->_bp + si8a);
 			UCList *l = new UCList(ui16a);
 			if (getList(ui16b)) {
@@ -1094,7 +1333,7 @@ void UCMachine::execProcess(UCProcess *p) {
 			// 43 xx
 			// push the stringlist local var xx
 			// duplicating the list, duplicating the strings in the list
-			si8a = cs->readSByte();
+			si8a = ins.op[0];
 			ui16a = 2;
 			ui16b = p->_stack.access2(p->_bp + si8a);
 			UCList *l = new UCList(ui16a);
@@ -1120,8 +1359,8 @@ void UCMachine::execProcess(UCProcess *p) {
 			// duplicate string if YY? yy = 1 only occurs
 			// in two places in U8: once it pops into temp afterwards,
 			// once it is indeed freed. So, guessing we should duplicate.
-			ui32a = cs->readByte();
-			ui32b = cs->readByte();
+			ui32a = ins.op[0];
+			ui32b = ins.op[1];
 			ui16a = p->_stack.pop2() - 1; // index
 			ui16b = p->_stack.pop2(); // list
 			UCList *l = getList(ui16b);
@@ -1149,8 +1388,8 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x45:
 			// 45 xx yy
 			// push huge of size yy from BP+xx
-			si8a = cs->readSByte();
-			ui16b = cs->readByte();
+			si8a = ins.op[0];
+			ui16b = ins.op[1];
 			p->_stack.push(p->_stack.access(p->_bp + si8a), ui16b);
 			TRACE_OP("%s\tpush huge\t%s %02X", op_info, print_bp(si8a), ui16b);
 			break;
@@ -1164,7 +1403,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x4B:
 			// 4B xx
 			// push 32 bit pointer address of BP+XX
-			si8a = cs->readSByte();
+			si8a = ins.op[0];
 			p->_stack.push4(stackToPtr(p->_pid, p->_bp + si8a));
 			TRACE_OP("%s\tpush addr\t%s", op_info, print_bp(si8a));
 			break;
@@ -1174,7 +1413,7 @@ void UCMachine::execProcess(UCProcess *p) {
 			// indirect push,
 			// pops a 32 bit pointer off the stack and pushes xx bytes
 			// from the location referenced by the pointer
-			ui16a = cs->readByte();
+			ui16a = ins.op[0];
 			ui32a = p->_stack.pop4();
 
 			p->_stack.addSP(-ui16a);
@@ -1195,7 +1434,7 @@ void UCMachine::execProcess(UCProcess *p) {
 			// indirect pop
 			// pops a 32 bit pointer off the stack and pushes xx bytes
 			// from the location referenced by the pointer
-			ui16a = cs->readByte();
+			ui16a = ins.op[0];
 			ui32a = p->_stack.pop4();
 
 			if (assignPointer(ui32a, p->_stack.access(), ui16a)) {
@@ -1211,8 +1450,8 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x4E:
 			// 4E xx xx yy
 			// push global xxxx size yy bits
-			ui16a = cs->readUint16LE();
-			ui16b = cs->readByte();
+			ui16a = ins.op[0];
+			ui16b = ins.op[1];
 			ui32a = _globals->getEntries(ui16a, ui16b);
 			p->_stack.push2(static_cast<uint16>(ui32a));
 			TRACE_OP("%s\tpush\t\tglobal [%04X %02X] = %02X", op_info, ui16a, ui16b, ui32a);
@@ -1221,8 +1460,8 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x4F:
 			// 4F xx xx yy
 			// pop value into global xxxx size yy bits
-			ui16a = cs->readUint16LE();	// pos
-			ui16b = cs->readByte();		// len
+			ui16a = ins.op[0];	// pos
+			ui16b = ins.op[1];		// len
 			ui32a = p->_stack.pop2();	// val
 			_globals->setEntries(ui16a, ui16b, ui32a);
 
@@ -1256,12 +1495,8 @@ void UCMachine::execProcess(UCProcess *p) {
 				// return value is stored in _temp32 register
 
 				// Update the code segment
-				uint32 base_ = p->_usecode->get_class_base_offset(p->_classId);
-
-				delete cs;
-				cs = new Common::MemoryReadStream(p->_usecode->get_class(p->_classId) + base_,
-												  p->_usecode->get_class_size(p->_classId) - base_);
-				cs->seek(p->_ip);
+				code = getDecodedClass(p);
+				nextIp = p->_ip;
 			}
 
 			// Resume execution
@@ -1270,24 +1505,24 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x51:
 			// 51 xx xx
 			// relative jump to xxxx if false
-			si16a = static_cast<int16>(cs->readUint16LE());
+			si16a = static_cast<int16>(ins.op[0]);
 			ui16b = p->_stack.pop2();
 			if (!ui16b) {
-				ui16a = cs->pos() + si16a;
-				cs->seek(ui16a);
-				TRACE_OP("%s\tjne\t\t%04hXh\t(to %04X) (taken)", op_info, si16a, cs->pos());
+				ui16a = nextIp + si16a;
+				nextIp = ui16a;
+				TRACE_OP("%s\tjne\t\t%04hXh\t(to %04X) (taken)", op_info, si16a, nextIp);
 			} else {
-				TRACE_OP("%s\tjne\t\t%04hXh\t(to %04X) (not taken)", op_info, si16a, cs->pos());
+				TRACE_OP("%s\tjne\t\t%04hXh\t(to %04X) (not taken)", op_info, si16a, nextIp);
 			}
 			break;
 
 		case 0x52:
 			// 52 xx xx
 			// relative jump to xxxx
-			si16a = static_cast<int16>(cs->readUint16LE());
-			ui16a = cs->pos() + si16a;
-			cs->seek(ui16a);
-			TRACE_OP("%s\tjmp\t\t%04hXh\t(to %04X)", op_info, si16a, cs->pos());
+			si16a = static_cast<int16>(ins.op[0]);
+			ui16a = nextIp + si16a;
+			nextIp = ui16a;
+			TRACE_OP("%s\tjmp\t\t%04hXh\t(to %04X)", op_info, si16a, nextIp);
 			break;
 
 		case 0x53:
@@ -1319,7 +1554,7 @@ void UCMachine::execProcess(UCProcess *p) {
 			// 0x6D (push process result) only seems to occur soon after
 			// an 'implies'
 
-			cs->readUint16LE(); // skip the 01 01
+			// the 01 01 operand is skipped
 			ui16a = p->_stack.pop2();
 			ui16b = p->_stack.pop2();
 			p->_stack.push2(ui16a); //!! which pid do we need to push!?
@@ -1362,10 +1597,10 @@ void UCMachine::execProcess(UCProcess *p) {
 			// tt = sizeof this pointer object
 			// only remove the this pointer from stack (4 bytes)
 			// put PID of spawned process in temp
-			int arg_bytes = cs->readByte();
-			int this_size = cs->readByte();
-			uint16 classid = cs->readUint16LE();
-			uint16 offset = cs->readUint16LE();
+			int arg_bytes = ins.op[0];
+			int this_size = ins.op[1];
+			uint16 classid = ins.op[2];
+			uint16 offset = ins.op[3];
 
 			uint32 thisptr = p->_stack.pop4();
 
@@ -1398,11 +1633,11 @@ void UCMachine::execProcess(UCProcess *p) {
 			// spawn inline process function yyyy in class xxxx at offset zzzz
 			// tt = size of this pointer
 			// uu = unknown (occurring values: 00, 02, 05) - seems unused in original
-			uint16 classid = cs->readUint16LE();
-			uint16 offset = cs->readUint16LE();
-			uint16 delta = cs->readUint16LE();
-			int this_size = cs->readByte();
-			int unknown = cs->readByte(); // ??
+			uint16 classid = ins.op[0];
+			uint16 offset = ins.op[1];
+			uint16 delta = ins.op[2];
+			int this_size = ins.op[3];
+			int unknown = ins.op[4]; // ??
 
 			// This only gets used in U8.  If it were used in Crusader it would
 			// need the offset translation done in 0x57.
@@ -1445,7 +1680,7 @@ void UCMachine::execProcess(UCProcess *p) {
 			// 5A xx
 			// init function. xx = local var size
 			// sets xx bytes on stack to 0, moving sp
-			ui16a = cs->readByte();
+			ui16a = ins.op[0];
 			TRACE_OP("%s\tinit\t\t%02X", op_info, ui16a);
 
 			if (ui16a & 1) ui16a++; // 16-bit align
@@ -1457,19 +1692,15 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x5B:
 			// 5B xx xx
 			// debug line no xx xx
-			ui16a = cs->readUint16LE(); // source line number
+			ui16a = ins.op[0]; // source line number
 			TRACE_OP("%s\tdebug\tline number %d", op_info, ui16a);
 			break;
 
 		case 0x5C: {
 			// 5C xx xx char[9]
 			// debug line no xx xx in class str
-			ui16a = cs->readUint16LE(); // source line number
-			char name[10] = {0};
-			for (int x = 0; x < 9; x++) {
-				// skip over class name and null terminator
-				name[x] = cs->readByte();
-			}
+			ui16a = ins.op[0]; // source line number
+			const char *name = code->getString(ins.op[1]);
 			TRACE_OP("%s\tdebug\tline number %d\t\"%s\"", op_info, ui16a, name);
 			debug(10, "name: \"%s\"", name); // Ensures that name variable is used when TRACE_OP is empty
 			break;
@@ -1518,7 +1749,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x62:
 			// 62 xx
 			// free the string in var BP+xx
-			si8a = cs->readSByte();
+			si8a = ins.op[0];
 			ui16a = p->_stack.access2(p->_bp + si8a);
 			freeString(ui16a);
 			TRACE_OP("%s\tfree string\t%s = %04X", op_info, print_bp(si8a), ui16a);
@@ -1527,7 +1758,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x63:
 			// 63 xx
 			// free the stringlist in var BP+xx
-			si8a = cs->readSByte();
+			si8a = ins.op[0];
 			ui16a = p->_stack.access2(p->_bp + si8a);
 			freeStringList(ui16a);
 			TRACE_OP("%s\tfree slist\t%s = %04X", op_info, print_bp(si8a), ui16a);
@@ -1536,7 +1767,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x64:
 			// 64 xx
 			// free the list in var BP+xx
-			si8a = cs->readSByte();
+			si8a = ins.op[0];
 			ui16a = p->_stack.access2(p->_bp + si8a);
 			freeList(ui16a);
 			TRACE_OP("%s\tfree list\t%s = %04X", op_info, print_bp(si8a), ui16a);
@@ -1547,7 +1778,7 @@ void UCMachine::execProcess(UCProcess *p) {
 			// free the string at SP+xx
 			// NB: sometimes there's a 32-bit string pointer at SP+xx
 			//     However, the low word of this is exactly the 16bit ref
-			si8a = cs->readSByte();
+			si8a = ins.op[0];
 			ui16a = p->_stack.access2(p->_stack.getSP() + si8a);
 			freeString(ui16a);
 			TRACE_OP("%s\tfree string\t%s = %04X", op_info, print_sp(si8a), ui16a);
@@ -1556,7 +1787,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x66:
 			// 66 xx
 			// free the list at SP+xx
-			si8a = cs->readSByte();
+			si8a = ins.op[0];
 			ui16a = p->_stack.access2(p->_stack.getSP() + si8a);
 			freeList(ui16a);
 			TRACE_OP("%s\tfree list\t%s = %04X", op_info, print_sp(si8a), ui16a);
@@ -1565,7 +1796,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x67:
 			// 67 xx
 			// free the string list at SP+xx
-			si8a = cs->readSByte();
+			si8a = ins.op[0];
 			ui16a = p->_stack.access2(p->_stack.getSP() + si8a);
 			freeStringList(ui16a);
 			TRACE_OP("%s\tfree slist\t%s = %04x", op_info, print_sp(si8a), ui16a);
@@ -1576,7 +1807,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x69:
 			// 69 xx
 			// push the string in var BP+xx as 32 bit pointer
-			si8a = cs->readSByte();
+			si8a = ins.op[0];
 			ui16a = p->_stack.access2(p->_bp + si8a);
 			p->_stack.push4(stringToPtr(ui16a));
 			TRACE_OP("%s\tstr to ptr\t%s", op_info, print_bp(si8a));
@@ -1597,8 +1828,8 @@ void UCMachine::execProcess(UCProcess *p) {
 			// yy = type (01 = string, 02 = slist, 03 = list)
 			// copy the (string/slist/list) in BP+xx to the current process,
 			// and add it to the "Free Me" list of the process
-			si8a = cs->readByte(); // index
-			ui8a = cs->readByte(); // type
+			si8a = ins.op[0]; // index
+			ui8a = ins.op[1]; // type
 			TRACE_OP("%s\tparam _pid chg\t%s, type=%u", op_info, print_bp(si8a), ui8a);
 
 			ui16a = p->_stack.access2(p->_bp + si8a);
@@ -1653,7 +1884,7 @@ void UCMachine::execProcess(UCProcess *p) {
 			// 6E xx
 			// subtract xx from stack pointer
 			// (effect on SP is the same as popping xx bytes)
-			si8a = cs->readSByte();
+			si8a = ins.op[0];
 			p->_stack.addSP(-si8a);
 			TRACE_OP("%s\tmove sp\t\t%s%02Xh", op_info, si8a < 0 ? "-" : "", si8a < 0 ? -si8a : si8a);
 			break;
@@ -1661,7 +1892,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x6F:
 			// 6F xx
 			// push 32 pointer address of SP-xx
-			si8a = cs->readSByte();
+			si8a = ins.op[0];
 			p->_stack.push4(stackToPtr(p->_pid, static_cast<uint16>(p->_stack.getSP() - si8a)));
 			TRACE_OP("%s\tpush addr\t%s", op_info, print_sp(-si8a));
 			break;
@@ -1682,9 +1913,9 @@ void UCMachine::execProcess(UCProcess *p) {
 			// loop something. Stores 'current object' in var xx
 			// yy == num bytes in string
 			// zz == type
-			si16a = cs->readSByte();
-			uint32 scriptsize = cs->readByte();
-			uint32 searchtype = cs->readByte();
+			si16a = ins.op[0];
+			uint32 scriptsize = ins.op[1];
+			uint32 searchtype = ins.op[2];
 
 			ui16a = p->_stack.pop2();
 			ui16b = p->_stack.pop2();
@@ -1862,7 +2093,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x74:
 			// 74 xx
 			// add xx to the current 'loopscript'
-			ui8a = cs->readByte();
+			ui8a = ins.op[0];
 			p->_stack.push1(ui8a);
 			TRACE_OP("%s\tloopscr\t\t%02X \"%c\"", op_info, ui8a, static_cast<char>(ui8a));
 			break;
@@ -1887,9 +2118,9 @@ void UCMachine::execProcess(UCProcess *p) {
 			// Strings are _not_ duplicated when putting them in the loopvar
 			// Lists _are_ freed afterwards
 
-			si8a = cs->readByte();  // loop variable
-			ui32a = cs->readByte(); // list size
-			si16a = cs->readUint16LE(); // jump offset
+			si8a = ins.op[0];  // loop variable
+			ui32a = ins.op[1]; // list size
+			si16a = ins.op[2]; // jump offset
 
 			ui16a = p->_stack.access2(p->_stack.getSP());     // Loop index
 			ui16b = p->_stack.access2(p->_stack.getSP() + 2); // Loop list
@@ -1923,8 +2154,8 @@ void UCMachine::execProcess(UCProcess *p) {
 				p->_stack.addSP(4);  // Pop list and counter
 
 				// jump out
-				ui16a = cs->pos() + si16a;
-				cs->seek(ui16a);
+				ui16a = nextIp + si16a;
+				nextIp = ui16a;
 			} else {
 				// loop iteration
 				// (not duplicating any strings)
@@ -1969,7 +2200,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		case 0x79:
 			// 79
 			// push address of global (Crusader only)
-			ui16a = cs->readUint16LE(); // global address
+			ui16a = ins.op[0]; // global address
 			ui32a = globalToPtr(ui16a);
 			p->_stack.push4(ui32a);
 			TRACE_OP("%s\tpush global 0x%x (value: %x)", op_info, ui16a, ui32a);
@@ -1993,15 +2224,13 @@ void UCMachine::execProcess(UCProcess *p) {
 
 		// write back IP (but preserve IP if there was an error)
 		if (!error)
-			p->_ip = static_cast<uint16>(cs->pos());   // TRUNCATES!
+			p->_ip = static_cast<uint16>(nextIp);   // TRUNCATES!
 
 		// check if we suspended ourselves
 		if ((p->_flags & Process::PROC_SUSPENDED) != 0 && !go_until_cede)
 			cede = true;
 	} // while(!cede && !error && !p->terminated && !p->terminate_deferred)
 
-	delete cs;
-
 	if (error) {
 		warning("Process %d caused an error at %04X:%04X (item %d). Killing process.",
 			p->_pid, p->_classId, p->_ip, p->_itemNum);
@@ -2285,6 +2514,76 @@ void UCMachine::usecodeStats() const {
 #endif
 }
 
+void UCMachine::startProfiling() {
+	memset(_profileOpcodes, 0, sizeof(_profileOpcodes));
+	_profileIntrinsics.clear();
+	_profileClasses.clear();
+	_profilingEnabled = true;
+}
+
+void UCMachine::stopProfiling() {
+	_profilingEnabled = false;
+}
+
+struct ProfileEntry {
+	uint16 _id;
+	uint32 _count;
+
+	bool operator<(const ProfileEntry &other) const {
+		return _count > other._count;
+	}
+};
+
+static const uint PROFILE_TOP_ENTRIES = 20;
+
+static void sortProfileEntries(Common::Array<ProfileEntry> &entries, const Common::HashMap<uint16, uint32> &counts) {
+	for (const auto &i : counts) {
+		ProfileEntry entry = { i._key, i._value };
+		entries.push_back(entry);
+	}
+	Common::sort(entries.begin(), entries.end());
+	if (entries.size() > PROFILE_TOP_ENTRIES)
+		entries.resize(PROFILE_TOP_ENTRIES);
+}
+
+void UCMachine::usecodeProfile() const {
+	Common::Array<ProfileEntry> entries;
+	uint32 total = 0;
+	for (uint i = 0; i < ARRAYSIZE(_profileOpcodes); i++) {
+		total += _profileOpcodes[i];
+		if (_profileOpcodes[i]) {
+			ProfileEntry entry = { static_cast<uint16>(i), _profileOpcodes[i] };
+			entries.push_back(entry);
+		}
+	}
+	Common::sort(entries.begin(), entries.end());
+	if (entries.size() > PROFILE_TOP_ENTRIES)
+		entries.resize(PROFILE_TOP_ENTRIES);
+
+	g_debugger->debugPrintf("Usecode Machine profile (%u opcodes run):\n", total);
+	g_debugger->debugPrintf("Opcodes:\n");
+	for (const auto &e : entries)
+		g_debugger->debugPrintf("  %02X: %u\n", e._id, e._count);
+
+	entries.clear();
+	sortProfileEntries(entries, _profileIntrinsics);
+	g_debugger->debugPrintf("Intrinsics:\n");
+	for (const auto &e : entries)
+		g_debugger->debugPrintf("  %04X %s: %u\n", e._id, _convUse->intrinsics()[e._id], e._count);
+
+	Usecode *uc = GameData::get_instance()->getMainUsecode();
+	entries.clear();
+	sortProfileEntries(entries, _profileClasses);
+	g_debugger->debugPrintf("Classes (opcodes run):\n");
+	for (const auto &e : entries)
+		g_debugger->debugPrintf("  %04X %s: %u\n", e._id, uc ? uc->get_class_name(e._id) : "", e._count);
+
+	uint32 instructions = 0;
+	for (const auto &i : _decodedClasses)
+		instructions += i._value->getNumInstructions();
+	g_debugger->debugPrintf("Decoded %u classes (%u instructions)\n", _decodedClasses.size(), instructions);
+}
+
 void UCMachine::saveGlobals(Common::WriteStream *ws) const {
 	_globals->save(ws);
 }
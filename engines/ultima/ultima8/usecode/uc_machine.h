@@ -37,6 +37,7 @@ class UCProcess;
 class ConvertUsecode;
 class GlobalStorage;
 class UCList;
+class UCDecodedClass;
 class idMan;
 
 class UCMachine {
@@ -64,6 +65,10 @@ public:
 
 	void usecodeStats() const;
 
+	void startProfiling();
+	void stopProfiling();
+	void usecodeProfile() const;
+
 	static uint32 listToPtr(uint16 l);
 	static uint32 stringToPtr(uint16 s);
 	static uint32 stackToPtr(uint16 pid, uint16 offset);
@@ -113,6 +118,12 @@ private:
 
 	static UCMachine *_ucMachine;
 
+	// usecode of the classes run so far, decoded into instructions
+	Common::HashMap<uint16, UCDecodedClass *> _decodedClasses;
+
+	UCDecodedClass *getDecodedClass(const UCProcess *p);
+	void clearDecodedClasses();
+
 	// tracing
 	bool _tracingEnabled;
 	bool _traceAll;
@@ -129,6 +140,11 @@ private:
 		return false;
 	}
 
+	// profiling
+	bool _profilingEnabled;
+	uint32 _profileOpcodes[256];
+	Common::HashMap<uint16, uint32> _profileIntrinsics;
+	Common::HashMap<uint16, uint32> _profileClasses;
 };
 
 } // End of namespace Ultima8
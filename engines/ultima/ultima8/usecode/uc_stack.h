@@ -23,6 +23,7 @@
 #define ULTIMA8_USECODE_UCSTACK_H
 
 #include "common/scummsys.h"
+#include "common/endian.h"
 
 namespace Common {
 class ReadStream;
@@ -77,15 +78,11 @@ public:
 
 	inline void push2(uint16 val) {
 		_bufPtr -= 2;
-		_bufPtr[0] = static_cast<uint8>(val     & 0xFF);
-		_bufPtr[1] = static_cast<uint8>((val >> 8) & 0xFF);
+		WRITE_LE_UINT16(_bufPtr, val);
 	}
 	inline void push4(uint32 val) {
 		_bufPtr -= 4;
-		_bufPtr[0] = static_cast<uint8>(val      & 0xFF);
-		_bufPtr[1] = static_cast<uint8>((val >> 8)  & 0xFF);
-		_bufPtr[2] = static_cast<uint8>((val >> 16) & 0xFF);
-		_bufPtr[3] = static_cast<uint8>((val >> 24) & 0xFF);
+		WRITE_LE_UINT32(_bufPtr, val);
 	}
 	// Push an arbitrary number of bytes of 0
 	inline void push0(const uint32 count) {
@@ -103,18 +100,14 @@ public:
 	//
 
 	inline uint16 pop2() {
-		uint8 b0, b1;
-		b0 = *_bufPtr++;
-		b1 = *_bufPtr++;
-		return (b0 | (b1 << 8));
+		uint16 val = READ_LE_UINT16(_bufPtr);
+		_bufPtr += 2;
+		return val;
 	}
 	inline uint32 pop4() {
-		uint8 b0, b1, b2, b3;
-		b0 = *_bufPtr++;
-		b1 = *_bufPtr++;
-		b2 = *_bufPtr++;
-		b3 = *_bufPtr++;
-		return (b0 | (b1 << 8) | (b2 << 16) | (b3 << 24));
+		uint32 val = READ_LE_UINT32(_bufPtr);
+		_bufPtr += 4;
+		return val;
 	}
 	inline void pop(uint8 *out, const uint32 count) {
 		memcpy(out, _bufPtr, count);
@@ -129,11 +122,10 @@ public:
 		return _buf[offset];
 	}
 	inline uint16 access2(const uint32 offset) const {
-		return (_buf[offset] | (_buf[offset + 1] << 8));
+		return READ_LE_UINT16(_buf + offset);
 	}
 	inline uint32 access4(const uint32 offset) const {
-		return _buf[offset] | (_buf[offset + 1] << 8) |
-		       (_buf[offset + 2] << 16) | (_buf[offset + 3] << 24);
+		return READ_LE_UINT32(_buf + offset);
 	}
 	inline uint8 *access(const uint32 offset) {
 		return _buf + offset;
@@ -150,14 +142,10 @@ public:
 		const_cast<uint8 *>(_buf)[offset]   = static_cast<uint8>(val     & 0xFF);
 	}
 	inline void assign2(const uint32 offset, const uint16 val) {
-		const_cast<uint8 *>(_buf)[offset]   = static_cast<uint8>(val     & 0xFF);
-		const_cast<uint8 *>(_buf)[offset + 1] = static_cast<uint8>((val >> 8) & 0xFF);
+		WRITE_LE_UINT16(const_cast<uint8 *>(_buf) + offset, val);
 	}
 	inline void assign4(const uint32 offset, const uint32 val) {
-		const_cast<uint8 *>(_buf)[offset]   = static_cast<uint8>(val      & 0xFF);
-		const_cast<uint8 *>(_buf)[offset + 1] = static_cast<uint8>((val >> 8)  & 0xFF);
-		const_cast<uint8 *>(_buf)[offset + 2] = static_cast<uint8>((val >> 16) & 0xFF);
-		const_cast<uint8 *>(_buf)[offset + 3] = static_cast<uint8>((val >> 24) & 0xFF);
+		WRITE_LE_UINT32(const_cast<uint8 *>(_buf) + offset, val);
 	}
 	inline void assign(const uint32 offset, const uint8 *in, const uint32 len) {
 		memcpy(const_cast<uint8 *>(_buf) + offset, in, len);
@@ -45,61 +45,11 @@ namespace Ultima8 {
 static const uint32 TRANSPARENT_COLOR = TEX32_PACK_RGBA(0x7F, 0x00, 0x00, 0x7F);
 static const uint32 HIGHLIGHT_COLOR = TEX32_PACK_RGBA(0xFF, 0xFF, 0x00, 0x1F);
 
-ItemSorter::ItemSorter(int capacity) :
-	_shapes(nullptr), _clipWindow(0, 0, 0, 0), _items(nullptr), _itemsTail(nullptr),
-	_itemsUnused(nullptr), _painted(nullptr), _camSx(0), _camSy(0),
-	_sortLimit(0), _sortLimitChanged(false) {
-	int i = capacity;
-	while (i--) {
-		SortItem *next = _itemsUnused;
-		_itemsUnused = new SortItem();
-		_itemsUnused->_next = next;
-	}
-}
-
-ItemSorter::~ItemSorter() {
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
-	}
-	_items = nullptr;
-	_itemsTail = nullptr;
-
-	while (_itemsUnused) {
-		SortItem *next = _itemsUnused->_next;
-		delete _itemsUnused;
-		_itemsUnused = next;
-	}
-}
-
 void ItemSorter::BeginDisplayList(const Common::Rect32 &clipWindow, const Point3 &cam) {
 	// Get the _shapes, if required
 	if (!_shapes) _shapes = GameData::get_instance()->getMainShapes();
 
-	// Set the clip window, and reset the item list
-	_clipWindow = clipWindow;
-
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
-	}
-
-	_items = nullptr;
-	_itemsTail = nullptr;
-	_painted = nullptr;
-
-	// Screenspace bounding box bottom x coord (RNB x coord)
-	int32 camSx = (cam.x - cam.y) / 4;
-	// Screenspace bounding box bottom extent  (RNB y coord)
-	int32 camSy = (cam.x + cam.y) / 8 - cam.z;
-
-	if (camSx != _camSx || camSy != _camSy) {
-		_camSx = camSx;
-		_camSy = camSy;
-
-		// Reset sort limit debugging on camera move
-		_sortLimit = 0;
-	}
+	ResetDisplayList(clipWindow, cam);
 }
 
 void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, uint32 flags, uint32 ext_flags, uint16 itemNum) {
@@ -179,94 +129,7 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 		si->_invitem = info->is_invitem();
 	}
 
-	si->_occluded = false;
-	si->_order = -1;
-
-	// We will clear all the vector memory
-	// Stictly speaking the vector will sort of leak memory, since they
-	// are never deleted
-	si->_depends.clear();
-
-	// Iterate the list and compare _shapes
-
-	// Ok,
-	SortItem *addpoint = nullptr;
-	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
-		// Get the insert point... which is before the first item that has higher z than us
-		if (!addpoint && si->listLessThan(*si2))
-			addpoint = si2;
-
-		if (si2->_occluded)
-			continue;
-
-#ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
-		// Find adjoining rects for better occlusion
-		if (si->_occl && si2->_occl && si->_z == si2->_z) {
-			// Does this share an edge?
-			if (si->_y == si2->_y && si->_yFar == si2->_yFar) {
-				if (si->_xLeft == si2->_x) {
-					si->_xAdjoin = si2;
-				} else if (si->_x == si2->_xLeft) {
-					si2->_xAdjoin = si;
-				}
-			}
-			else if (si->_x == si2->_x && si->_xLeft == si2->_xLeft) {
-				if (si->_yFar == si2->_y) {
-					si->_yAdjoin = si2;
-				} else if (si->_y == si2->_yFar) {
-					si2->_yAdjoin = si;
-				}
-			}
-		}
-#endif // SORTITEM_OCCLUSION_EXPERIMENTAL
-
-		// Attempt to find paint dependency order
-		if (si->overlap(*si2)) {
-			if (si->below(*si2)) {
-				if (si2->_occl && si2->occludes(*si)) {
-					// No need to do any more checks, this isn't visible
-					si->_occluded = true;
-					break;
-				} else {
-					// si1 is behind si2, so add it to si2's dependency list
-					si2->_depends.insert_sorted(si);
-				}
-			} else {
-				if (si->_occl && si->occludes(*si2)) {
-					// Occluded, but we can't remove it from the list
-					si2->_occluded = true;
-				} else {
-					// si2 is behind si1, so add it to si1's dependency list
-					si->_depends.insert_sorted(si2);
-				}
-			}
-		}
-	}
-
-	// Add it to the list
-	_itemsUnused = _itemsUnused->_next;
-
-	// have a position
-	//addpoint = 0;
-	if (addpoint) {
-		si->_next = addpoint;
-		si->_prev = addpoint->_prev;
-		addpoint->_prev = si;
-		if (si->_prev)
-			si->_prev->_next = si;
-		else
-			_items = si;
-	}
-	// Add it to the end of the list
-	else {
-		if (_itemsTail)
-			_itemsTail->_next = si;
-		if (!_items)
-			_items = si;
-		si->_next = nullptr;
-		si->_prev = _itemsTail;
-		_itemsTail = si;
-	}
+	InsertSortItem(si);
 }
 
 void ItemSorter::AddItem(const Item *add) {
@@ -22,8 +22,11 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "common/array.h"
 #include "common/rect.h"
 
+class U8ItemSorterTestSuite;
+
 namespace Ultima {
 namespace Ultima8 {
 
@@ -41,6 +44,13 @@ class ItemSorter {
 	SortItem    *_itemsTail;
 	SortItem    *_itemsUnused;
 	SortItem    *_painted;
+	SortItem    *_itemsMax;     // An item not below any other in list order
+
+	// Items are binned by screenspace rect so only the ones which may
+	// overlap are compared when adding an item
+	Common::Array<Common::Array<SortItem *> > _bins;
+	int32       _binCols, _binRows;
+	uint32      _binMark;
 
 	int32       _camSx, _camSy;
 	int32       _sortLimit;
@@ -70,6 +80,12 @@ public:
 	void IncSortLimit(int count);
 
 private:
+	friend class ::U8ItemSorterTestSuite;
+
+	void ResetDisplayList(const Common::Rect32 &clipWindow, const Point3 &cam);
+	// Inserts the first unused item, whose bounds and flags are set up
+	void InsertSortItem(SortItem *si);
+	void getBinRange(const Common::Rect32 &r, int32 &x0, int32 &y0, int32 &x1, int32 &y1) const;
 	bool PaintSortItem(RenderSurface *surf, SortItem *si, bool showFootpad, int gridlines);
 };
 
@@ -0,0 +1,246 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ultima/ultima8/misc/point3.h"
+#include "ultima/ultima8/world/item_sorter.h"
+#include "ultima/ultima8/world/sort_item.h"
+
+// Building the display list does not need the game data, unlike painting it,
+// so it is kept apart to be tested on its own
+
+namespace Ultima {
+namespace Ultima8 {
+
+// Size in pixels of the screenspace bins
+static const int32 BIN_SIZE = 64;
+
+ItemSorter::ItemSorter(int capacity) :
+	_shapes(nullptr), _clipWindow(0, 0, 0, 0), _items(nullptr), _itemsTail(nullptr),
+	_itemsUnused(nullptr), _painted(nullptr), _itemsMax(nullptr),
+	_binCols(0), _binRows(0), _binMark(0), _camSx(0), _camSy(0),
+	_sortLimit(0), _sortLimitChanged(false) {
+	int i = capacity;
+	while (i--) {
+		SortItem *next = _itemsUnused;
+		_itemsUnused = new SortItem();
+		_itemsUnused->_next = next;
+	}
+}
+
+ItemSorter::~ItemSorter() {
+	if (_itemsTail) {
+		_itemsTail->_next = _itemsUnused;
+		_itemsUnused = _items;
+	}
+	_items = nullptr;
+	_itemsTail = nullptr;
+
+	while (_itemsUnused) {
+		SortItem *next = _itemsUnused->_next;
+		delete _itemsUnused;
+		_itemsUnused = next;
+	}
+}
+
+void ItemSorter::ResetDisplayList(const Common::Rect32 &clipWindow, const Point3 &cam) {
+	// Set the clip window, and reset the item list
+	_clipWindow = clipWindow;
+
+	if (_itemsTail) {
+		_itemsTail->_next = _itemsUnused;
+		_itemsUnused = _items;
+	}
+
+	_items = nullptr;
+	_itemsTail = nullptr;
+	_painted = nullptr;
+	_itemsMax = nullptr;
+
+	// Reset the bins, keeping their storage
+	_binCols = MAX<int32>((clipWindow.width() + BIN_SIZE - 1) / BIN_SIZE, 1);
+	_binRows = MAX<int32>((clipWindow.height() + BIN_SIZE - 1) / BIN_SIZE, 1);
+	_bins.resize(_binCols * _binRows);
+	for (uint i = 0; i < _bins.size(); i++)
+		_bins[i].resize(0);
+	_binMark = 0;
+
+	// Screenspace bounding box bottom x coord (RNB x coord)
+	int32 camSx = (cam.x - cam.y) / 4;
+	// Screenspace bounding box bottom extent  (RNB y coord)
+	int32 camSy = (cam.x + cam.y) / 8 - cam.z;
+
+	if (camSx != _camSx || camSy != _camSy) {
+		_camSx = camSx;
+		_camSy = camSy;
+
+		// Reset sort limit debugging on camera move
+		_sortLimit = 0;
+	}
+}
+
+void ItemSorter::InsertSortItem(SortItem *si) {
+	assert(si == _itemsUnused);
+
+	si->_occluded = false;
+	si->_order = -1;
+
+	// We will clear all the vector memory
+	// Stictly speaking the vector will sort of leak memory, since they
+	// are never deleted
+	si->_depends.clear();
+
+	// Mark the items sharing a bin with us, only those can overlap
+	int32 binX0, binY0, binX1, binY1;
+	getBinRange(si->_sr, binX0, binY0, binX1, binY1);
+
+	uint32 mark = ++_binMark;
+	int candidates = 0;
+	for (int32 by = binY0; by <= binY1; by++) {
+		for (int32 bx = binX0; bx <= binX1; bx++) {
+			const Common::Array<SortItem *> &bin = _bins[by * _binCols + bx];
+			for (uint i = 0; i < bin.size(); i++) {
+				SortItem *si2 = bin[i];
+				if (si2->_binMark != mark && !si2->_occluded) {
+					si2->_binMark = mark;
+					candidates++;
+				}
+			}
+		}
+	}
+	si->_binMark = 0;
+
+	// Only look for the insert point if some item is above us
+	bool findAddpoint = _itemsMax && si->listLessThan(*_itemsMax);
+
+	// Iterate the list and compare _shapes
+
+	// Ok,
+	SortItem *addpoint = nullptr;
+	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
+#ifndef SORTITEM_OCCLUSION_EXPERIMENTAL
+		// Nothing left to compare and the insert point is known
+		if (!candidates && (addpoint || !findAddpoint))
+			break;
+#endif
+
+		// Get the insert point... which is before the first item that has higher z than us
+		if (!addpoint && si->listLessThan(*si2))
+			addpoint = si2;
+
+		if (si2->_occluded)
+			continue;
+
+#ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
+		// Find adjoining rects for better occlusion
+		if (si->_occl && si2->_occl && si->_z == si2->_z) {
+			// Does this share an edge?
+			if (si->_y == si2->_y && si->_yFar == si2->_yFar) {
+				if (si->_xLeft == si2->_x) {
+					si->_xAdjoin = si2;
+				} else if (si->_x == si2->_xLeft) {
+					si2->_xAdjoin = si;
+				}
+			}
+			else if (si->_x == si2->_x && si->_xLeft == si2->_xLeft) {
+				if (si->_yFar == si2->_y) {
+					si->_yAdjoin = si2;
+				} else if (si->_y == si2->_yFar) {
+					si2->_yAdjoin = si;
+				}
+			}
+		}
+#endif // SORTITEM_OCCLUSION_EXPERIMENTAL
+
+		if (si2->_binMark != mark)
+			continue;
+		candidates--;
+
+		// Attempt to find paint dependency order
+		if (si->overlap(*si2)) {
+			if (si->below(*si2)) {
+				if (si2->_occl && si2->occludes(*si)) {
+					// No need to do any more checks, this isn't visible
+					si->_occluded = true;
+					break;
+				} else {
+					// si1 is behind si2, so add it to si2's dependency list
+					si2->_depends.insert_sorted(si);
+				}
+			} else {
+				if (si->_occl && si->occludes(*si2)) {
+					// Occluded, but we can't remove it from the list
+					si2->_occluded = true;
+				} else {
+					// si2 is behind si1, so add it to si1's dependency list
+					si->_depends.insert_sorted(si2);
+				}
+			}
+		}
+	}
+
+	// Add it to the list
+	_itemsUnused = _itemsUnused->_next;
+
+	if (!_itemsMax || _itemsMax->listLessThan(*si))
+		_itemsMax = si;
+
+	// Occluded items are never compared again
+	if (!si->_occluded) {
+		for (int32 by = binY0; by <= binY1; by++) {
+			for (int32 bx = binX0; bx <= binX1; bx++)
+				_bins[by * _binCols + bx].push_back(si);
+		}
+	}
+
+	// have a position
+	//addpoint = 0;
+	if (addpoint) {
+		si->_next = addpoint;
+		si->_prev = addpoint->_prev;
+		addpoint->_prev = si;
+		if (si->_prev)
+			si->_prev->_next = si;
+		else
+			_items = si;
+	}
+	// Add it to the end of the list
+	else {
+		if (_itemsTail)
+			_itemsTail->_next = si;
+		if (!_items)
+			_items = si;
+		si->_next = nullptr;
+		si->_prev = _itemsTail;
+		_itemsTail = si;
+	}
+}
+
+void ItemSorter::getBinRange(const Common::Rect32 &r, int32 &x0, int32 &y0, int32 &x1, int32 &y1) const {
+	// Parts outside the clip window go to the edge bins, so any
+	// two intersecting rects still share a bin
+	x0 = CLIP<int32>((r.left - _clipWindow.left) / BIN_SIZE, 0, _binCols - 1);
+	y0 = CLIP<int32>((r.top - _clipWindow.top) / BIN_SIZE, 0, _binRows - 1);
+	x1 = CLIP<int32>((r.right - 1 - _clipWindow.left) / BIN_SIZE, 0, _binCols - 1);
+	y1 = CLIP<int32>((r.bottom - 1 - _clipWindow.top) / BIN_SIZE, 0, _binRows - 1);
+}
+
+} // End of namespace Ultima8
+} // End of namespace Ultima
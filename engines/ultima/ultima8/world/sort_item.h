@@ -41,7 +41,7 @@ class Shape;
  */
 struct SortItem {
 	SortItem() : _next(nullptr), _prev(nullptr), _itemNum(0),
-			_shape(nullptr), _order(-1), _depends(), _shapeNum(0),
+			_shape(nullptr), _order(-1), _binMark(0), _depends(), _shapeNum(0),
 			_frame(0), _flags(0), _extFlags(0), _sr(),
 			_x(0), _y(0), _z(0), _xLeft(0),
 			_yFar(0), _zTop(0), _sxLeft(0), _sxRight(0), _sxTop(0),
@@ -119,6 +119,8 @@ struct SortItem {
 
 	int32   _order;      // Rendering _order. -1 is not yet drawn
 
+	uint32  _binMark;    // Set when found in the bins of an item being added
+
 	// Note that PriorityQueue could be used here, BUT there is no guarantee that it's implementation
 	// will be friendly to insertions
 	// Alternatively i could use Common::List, BUT there is no guarantee that it will keep won't delete
@@ -52,7 +52,7 @@ BaseRenderer *makeOSystemRenderer(BaseGame *inGame) {
 //////////////////////////////////////////////////////////////////////////
 BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 	_renderSurface = new Graphics::ManagedSurface();
-	_lastFrameIter = _renderQueue.end();
+	_lastFrameIndex = -1;
 	_needsFlip = true;
 	_skipThisFrame = false;
 
@@ -69,12 +69,7 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 //////////////////////////////////////////////////////////////////////////
 BaseRenderOSystem::~BaseRenderOSystem() {
-	RenderQueueIterator it = _renderQueue.begin();
-	while (it != _renderQueue.end()) {
-		RenderTicket *ticket = *it;
-		it = _renderQueue.erase(it);
-		delete ticket;
-	}
+	clearRenderQueue();
 
 	delete _dirtyRect;
 
@@ -156,10 +151,9 @@ bool BaseRenderOSystem::flip() {
 		_needsFlip = false;
 
 		// Reset ticketing state
-		_lastFrameIter = _renderQueue.end();
-		RenderQueueIterator it;
-		for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
-			(*it)->_wantsDraw = false;
+		_lastFrameIndex = -1;
+		for (uint i = 0; i < _renderQueue.size(); i++) {
+			_renderQueue[i]->_wantsDraw = false;
 		}
 
 		addDirtyRect(_renderRect);
@@ -169,17 +163,17 @@ bool BaseRenderOSystem::flip() {
 		drawTickets();
 	} else {
 		// Clear the scale-buffered tickets that wasn't reused.
-		RenderQueueIterator it = _renderQueue.begin();
-		while (it != _renderQueue.end()) {
-			if ((*it)->_wantsDraw == false) {
-				RenderTicket *ticket = *it;
-				it = _renderQueue.erase(it);
+		uint kept = 0;
+		for (uint i = 0; i < _renderQueue.size(); i++) {
+			RenderTicket *ticket = _renderQueue[i];
+			if (ticket->_wantsDraw == false) {
 				delete ticket;
 			} else {
-				(*it)->_wantsDraw = false;
-				++it;
+				ticket->_wantsDraw = false;
+				_renderQueue[kept++] = ticket;
 			}
 		}
+		_renderQueue.resize(kept);
 	}
 
 	int oldScreenChangeID = _lastScreenChangeID;
@@ -194,7 +188,7 @@ bool BaseRenderOSystem::flip() {
 		_dirtyRect = nullptr;
 		_needsFlip = false;
 	}
-	_lastFrameIter = _renderQueue.end();
+	_lastFrameIndex = -1;
 
 	g_system->updateScreen();
 
@@ -260,7 +254,7 @@ Graphics::PixelFormat BaseRenderOSystem::getPixelFormat() const {
 void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::Surface *surf,
                                     Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform) {
 	if (_disableDirtyRects) {
-		RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
+		RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform, &_transformCache);
 		ticket->_wantsDraw = true;
 		_renderQueue.push_back(ticket);
 		drawFromSurface(ticket);
@@ -274,25 +268,23 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 
 	if (owner) { // Fade-tickets are owner-less
 		RenderTicket compare(owner, nullptr, srcRect, dstRect, transform);
-		RenderQueueIterator it = _lastFrameIter;
-		++it;
-		// Avoid calling end() and operator* every time, when potentially going through
+		// Avoid calling size() every time, when potentially going through
 		// LOTS of tickets.
-		RenderQueueIterator endIterator = _renderQueue.end();
-		RenderTicket *compareTicket = nullptr;
-		for (; it != endIterator; ++it) {
-			compareTicket = *it;
+		const uint queueSize = _renderQueue.size();
+		RenderTicket *const *queue = _renderQueue.data();
+		for (uint i = _lastFrameIndex + 1; i < queueSize; ++i) {
+			RenderTicket *compareTicket = queue[i];
 			if (*(compareTicket) == compare && compareTicket->_isValid) {
 				if (_disableDirtyRects) {
 					drawFromSurface(compareTicket);
 				} else {
-					drawFromQueuedTicket(it);
+					drawFromQueuedTicket(i);
 				}
 				return;
 			}
 		}
 	}
-	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
+	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform, &_transformCache);
 	if (!_disableDirtyRects) {
 		drawFromTicket(ticket);
 	} else {
@@ -309,47 +301,44 @@ void BaseRenderOSystem::invalidateTicket(RenderTicket *renderTicket) {
 }
 
 void BaseRenderOSystem::invalidateTicketsFromSurface(BaseSurfaceOSystem *surf) {
-	RenderQueueIterator it;
-	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
-		if ((*it)->_owner == surf) {
-			invalidateTicket(*it);
+	for (uint i = 0; i < _renderQueue.size(); i++) {
+		if (_renderQueue[i]->_owner == surf) {
+			invalidateTicket(_renderQueue[i]);
+		}
+	}
+}
+
+void BaseRenderOSystem::detachTicketsFromSurface(BaseSurfaceOSystem *surf) {
+	for (uint i = 0; i < _renderQueue.size(); i++) {
+		if (_renderQueue[i]->_owner == surf) {
+			_renderQueue[i]->detachSurface();
 		}
 	}
+	_transformCache.invalidateSurface(surf);
 }
 
 void BaseRenderOSystem::drawFromTicket(RenderTicket *renderTicket) {
 	renderTicket->_wantsDraw = true;
 
-	++_lastFrameIter;
-	// In-order
-	if (_renderQueue.empty() || _lastFrameIter == _renderQueue.end()) {
-		_lastFrameIter--;
-		_renderQueue.push_back(renderTicket);
-		++_lastFrameIter;
-		addDirtyRect(renderTicket->_dstRect);
-	} else {
-		// Before something
-		RenderQueueIterator pos = _lastFrameIter;
-		_renderQueue.insert(pos, renderTicket);
-		--_lastFrameIter;
-		addDirtyRect(renderTicket->_dstRect);
-	}
+	++_lastFrameIndex;
+	// In-order, or before something
+	_renderQueue.insert_at(_lastFrameIndex, renderTicket);
+	addDirtyRect(renderTicket->_dstRect);
 }
 
-void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket) {
-	RenderTicket *renderTicket = *ticket;
+void BaseRenderOSystem::drawFromQueuedTicket(uint index) {
+	RenderTicket *renderTicket = _renderQueue[index];
 	assert(!renderTicket->_wantsDraw);
 	renderTicket->_wantsDraw = true;
 
-	++_lastFrameIter;
 	// Not in the same order?
-	if (*_lastFrameIter != renderTicket) {
-		--_lastFrameIter;
-		// Remove the ticket from the list
-		assert(*_lastFrameIter != renderTicket);
-		_renderQueue.erase(ticket);
+	if ((int)index != _lastFrameIndex + 1) {
+		// Remove the ticket from the queue
+		_renderQueue.remove_at(index);
 		// Is not in order, so readd it as if it was a new ticket
 		drawFromTicket(renderTicket);
+	} else {
+		++_lastFrameIndex;
 	}
 }
 
@@ -363,49 +352,57 @@ void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
 }
 
 void BaseRenderOSystem::drawTickets() {
-	RenderQueueIterator it = _renderQueue.begin();
 	// Clean out the old tickets
 	// Note: We draw invalid tickets too, otherwise we wouldn't be honoring
 	// the draw request they obviously made BEFORE becoming invalid, either way
-	// we have a copy of their data, so their invalidness won't affect us.
-	while (it != _renderQueue.end()) {
-		if ((*it)->_wantsDraw == false) {
-			RenderTicket *ticket = *it;
-			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
+	// they were detached from their surface before it changed, so their
+	// invalidness won't affect us.
+	uint kept = 0;
+	for (uint i = 0; i < _renderQueue.size(); i++) {
+		RenderTicket *ticket = _renderQueue[i];
+		if (ticket->_wantsDraw == false) {
+			addDirtyRect(ticket->_dstRect);
 			delete ticket;
 		} else {
-			++it;
+			_renderQueue[kept++] = ticket;
 		}
 	}
+	_renderQueue.resize(kept);
+
 	if (!_dirtyRect || _dirtyRect->width() == 0 || _dirtyRect->height() == 0) {
-		it = _renderQueue.begin();
-		while (it != _renderQueue.end()) {
-			RenderTicket *ticket = *it;
-			ticket->_wantsDraw = false;
-			++it;
+		for (uint i = 0; i < _renderQueue.size(); i++) {
+			_renderQueue[i]->_wantsDraw = false;
 		}
 		return;
 	}
 
-	it = _renderQueue.begin();
-	_lastFrameIter = _renderQueue.end();
-	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
-	// the background color. Typical use-case: Fullscreen FMVs.
-	// Caveat: The FPS-counter will invalidate this.
-	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
-		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
-			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+	_lastFrameIndex = -1;
+	// Nothing below an opaque ticket covering the whole dirty rect can show
+	// through, so start drawing from the topmost one of those, and skip
+	// filling the background color. Typical use-cases: Fullscreen FMVs and
+	// scene backgrounds.
+	uint first = 0;
+	for (uint i = _renderQueue.size(); i > 0; i--) {
+		RenderTicket *ticket = _renderQueue[i - 1];
+		if (ticket->_dstRect.contains(*_dirtyRect) && ticket->isOpaque()) {
+			first = i;
+			break;
 		}
+	}
+
+	if (first) {
 		// Otherwise Do NOT fill.
+		for (uint i = 0; i < first - 1; i++) {
+			_renderQueue[i]->_wantsDraw = false;
+		}
+		first--;
 	} else {
 		// Apply the clear-color to the dirty rect.
 		_renderSurface->fillRect(*_dirtyRect, _clearColor);
 	}
-	for (; it != _renderQueue.end(); ++it) {
-		RenderTicket *ticket = *it;
+
+	for (uint i = first; i < _renderQueue.size(); i++) {
+		RenderTicket *ticket = _renderQueue[i];
 		if (ticket->_dstRect.intersects(*_dirtyRect)) {
 			// dstClip is the area we want redrawn.
 			Common::Rect dstClip(ticket->_dstRect);
@@ -426,19 +423,26 @@ void BaseRenderOSystem::drawTickets() {
 	}
 	g_system->copyRectToScreen(_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
 
-	it = _renderQueue.begin();
 	// Clean out the old tickets
-	while (it != _renderQueue.end()) {
-		if ((*it)->_isValid == false) {
-			RenderTicket *ticket = *it;
-			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
+	kept = 0;
+	for (uint i = 0; i < _renderQueue.size(); i++) {
+		RenderTicket *ticket = _renderQueue[i];
+		if (ticket->_isValid == false) {
+			addDirtyRect(ticket->_dstRect);
 			delete ticket;
 		} else {
-			++it;
+			_renderQueue[kept++] = ticket;
 		}
 	}
+	_renderQueue.resize(kept);
+}
 
+void BaseRenderOSystem::clearRenderQueue() {
+	for (uint i = 0; i < _renderQueue.size(); i++) {
+		delete _renderQueue[i];
+	}
+	_renderQueue.clear();
+	_lastFrameIndex = -1;
 }
 
 // Replacement for SDL2's SDL_RenderCopy
@@ -555,16 +559,11 @@ void BaseRenderOSystem::endSaveLoad() {
 	BaseRenderer::endSaveLoad();
 
 	// Clear the scale-buffered tickets as we just loaded.
-	RenderQueueIterator it = _renderQueue.begin();
-	while (it != _renderQueue.end()) {
-		RenderTicket *ticket = *it;
-		it = _renderQueue.erase(it);
-		delete ticket;
-	}
+	clearRenderQueue();
+	_transformCache.clear();
 	// HACK: After a save the buffer will be drawn before the scripts get to update it,
 	// so just skip this single frame.
 	_skipThisFrame = true;
-	_lastFrameIter = _renderQueue.end();
 
 	_renderSurface->fillRect(Common::Rect(0, 0, _renderSurface->w, _renderSurface->h), _renderSurface->format.ARGBToColor(255, 0, 0, 0));
 	g_system->fillScreen(Common::Rect(0, 0, _renderSurface->w, _renderSurface->h), _renderSurface->format.ARGBToColor(255, 0, 0, 0));
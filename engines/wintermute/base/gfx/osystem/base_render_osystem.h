@@ -30,15 +30,16 @@
 
 #include "engines/wintermute/base/gfx/base_renderer.h"
 
+#include "common/array.h"
 #include "common/rect.h"
-#include "common/list.h"
 
 #include "graphics/managed_surface.h"
 #include "graphics/transform_struct.h"
 
+#include "engines/wintermute/base/gfx/osystem/render_ticket.h"
+
 namespace Wintermute {
 class BaseSurfaceOSystem;
-class RenderTicket;
 /**
  * A 2D-renderer implementation for WME.
  * This renderer makes use of a "ticket"-system, where all draw-calls
@@ -63,8 +64,6 @@ public:
 	BaseRenderOSystem(BaseGame *inGame);
 	~BaseRenderOSystem() override;
 
-	typedef Common::List<RenderTicket *>::iterator RenderQueueIterator;
-
 	Common::String getName() const override;
 
 	bool initRenderer(int width, int height, bool windowed) override;
@@ -85,6 +84,12 @@ public:
 
 	void invalidateTicket(RenderTicket *renderTicket);
 	void invalidateTicketsFromSurface(BaseSurfaceOSystem *surf);
+	/**
+	 * Make the tickets from a surface stop referring to its pixels,
+	 * to be called before the surface changes or frees them.
+	 * @param surf the surface about to change.
+	 */
+	void detachTicketsFromSurface(BaseSurfaceOSystem *surf);
 	/**
 	 * Insert a new ticket into the queue, adding a dirty rect
 	 * @param renderTicket the ticket to be added.
@@ -93,9 +98,9 @@ public:
 	/**
 	 * Re-insert an existing ticket into the queue, adding a dirty rect
 	 * out-of-order from last draw from the ticket.
-	 * @param ticket iterator pointing to the ticket to be added.
+	 * @param index position of the ticket in the queue.
 	 */
-	void drawFromQueuedTicket(const RenderQueueIterator &ticket);
+	void drawFromQueuedTicket(uint index);
 
 	bool setViewport(int left, int top, int right, int bottom) override;
 	bool setViewport(Common::Rect32 *rect) override { return BaseRenderer::setViewport(rect); }
@@ -128,11 +133,15 @@ private:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
+	void clearRenderQueue();
 	Common::Rect *_dirtyRect;
-	Common::List<RenderTicket *> _renderQueue;
+	// Tickets in draw order. _lastFrameIndex is the position of the last
+	// ticket drawn this frame, or -1 before the first one.
+	Common::Array<RenderTicket *> _renderQueue;
+	TransformCache _transformCache;
 
 	bool _needsFlip;
-	RenderQueueIterator _lastFrameIter;
+	int _lastFrameIndex;
 	Common::Rect _renderRect;
 	Graphics::ManagedSurface *_renderSurface;
 
@@ -59,6 +59,8 @@ BaseSurfaceOSystem::BaseSurfaceOSystem(BaseGame *inGame) : BaseSurface(inGame) {
 
 //////////////////////////////////////////////////////////////////////////
 BaseSurfaceOSystem::~BaseSurfaceOSystem() {
+	detachTickets();
+
 	if (_surface) {
 		if (_valid)
 			_game->addMem(-_width * _height * 4);
@@ -129,6 +131,8 @@ bool BaseSurfaceOSystem::loadImage() {
 	}
 
 	if (_surface) {
+		detachTickets();
+
 		if (_valid)
 			_game->addMem(-_width * _height * 4);
 		_surface->free();
@@ -226,6 +230,8 @@ bool BaseSurfaceOSystem::loadImage() {
 
 //////////////////////////////////////////////////////////////////////////
 bool BaseSurfaceOSystem::create(int width, int height) {
+	detachTickets();
+
 	if (_valid)
 		_game->addMem(-_width * _height * 4);
 	_surface->free();
@@ -248,6 +254,8 @@ bool BaseSurfaceOSystem::invalidate() {
 	}
 
 	if (_valid) {
+		detachTickets();
+
 		_game->addMem(-_width * _height * 4);
 		_surface->free();
 		_valid = false;
@@ -410,6 +418,8 @@ bool BaseSurfaceOSystem::drawSprite(int x, int y, Common::Rect32 *rect, Common::
 }
 
 bool BaseSurfaceOSystem::putSurface(const Graphics::Surface &surface, bool hasAlpha) {
+	detachTickets();
+
 	_surface->copyRectToSurface(surface, 0, 0, Common::Rect(surface.w, surface.h));
 	writeAlpha(_surface, _alphaMask);
 
@@ -424,6 +434,12 @@ bool BaseSurfaceOSystem::putSurface(const Graphics::Surface &surface, bool hasAl
 	return STATUS_OK;
 }
 
+//////////////////////////////////////////////////////////////////////////
+void BaseSurfaceOSystem::detachTickets() {
+	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_game->_renderer);
+	renderer->detachTicketsFromSurface(this);
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool BaseSurfaceOSystem::setAlphaImage(const char *filename) {
 	BaseImage *alphaImage = new BaseImage();
@@ -70,6 +70,9 @@ public:
 			return STATUS_FAILED;
 		}
 		if (_surface) {
+			// Tickets still drawing the old pixels need their own copy
+			if (!_surfaceModified)
+				detachTickets();
 			_surface->setPixel(x, y, _surface->format.ARGBToColor(a, r, g, b));
 			_surfaceModified = true;
 			return STATUS_OK;
@@ -91,6 +94,7 @@ public:
 private:
 	Graphics::Surface *_surface;
 	bool loadImage();
+	void detachTickets();
 	bool drawSprite(int x, int y, Common::Rect32 *rect, Common::Rect32 *newRect, Graphics::TransformStruct transformStruct);
 	void writeAlpha(Graphics::Surface *surface, const Graphics::Surface *mask);
 
@@ -36,21 +36,127 @@
 
 namespace Wintermute {
 
+TransformCache::TransformCache() : _size(0), _maxSize(16 * 1024 * 1024), _useCounter(0) {
+}
+
+TransformCache::~TransformCache() {
+	clear();
+}
+
+bool TransformCache::Key::operator==(const Key &other) const {
+	return owner == other.owner && srcRect == other.srcRect &&
+		width == other.width && height == other.height &&
+		angle == other.angle && zoom == other.zoom && hotspot == other.hotspot &&
+		flip == other.flip && filtering == other.filtering;
+}
+
+uint TransformCache::KeyHash::operator()(const Key &key) const {
+	uint hash = (uint)(size_t)key.owner;
+	hash = hash * 31 + (uint16)key.srcRect.left + ((uint16)key.srcRect.top << 16);
+	hash = hash * 31 + (uint16)key.srcRect.right + ((uint16)key.srcRect.bottom << 16);
+	hash = hash * 31 + (uint16)key.width + ((uint16)key.height << 16);
+	hash = hash * 31 + (uint)key.angle;
+	hash = hash * 31 + (uint16)key.zoom.x + ((uint16)key.zoom.y << 16);
+	hash = hash * 31 + (uint16)key.hotspot.x + ((uint16)key.hotspot.y << 16);
+	hash = hash * 31 + key.flip + (key.filtering << 8);
+	return hash;
+}
+
+Common::SharedPtr<Graphics::Surface> TransformCache::getTransformedSurface(const BaseSurfaceOSystem *owner, const Graphics::Surface &src,
+		const Common::Rect &srcRect, const Common::Rect &dstRect, const Graphics::TransformStruct &transform, bool filtering) {
+	Key key;
+	key.owner = owner;
+	key.srcRect = srcRect;
+	key.filtering = filtering;
+
+	// Only keep what the transform in use actually depends on
+	if (transform._angle != Graphics::kDefaultAngle) {
+		key.width = key.height = 0;
+		key.angle = transform._angle;
+		key.zoom = transform._zoom;
+		key.hotspot = transform._hotspot;
+		key.flip = transform._flip;
+	} else {
+		key.width = dstRect.width();
+		key.height = dstRect.height();
+		key.angle = 0;
+		key.flip = 0;
+	}
+
+	EntryMap::iterator it = _entries.find(key);
+	if (it != _entries.end()) {
+		it->_value.lastUse = ++_useCounter;
+		return it->_value.surface;
+	}
+
+	Graphics::Surface *surface;
+	if (transform._angle != Graphics::kDefaultAngle)
+		surface = src.rotoscale(transform, filtering);
+	else
+		surface = src.scale(dstRect.width(), dstRect.height(), filtering);
+
+	Entry &entry = _entries[key];
+	entry.surface = Common::SharedPtr<Graphics::Surface>(surface, Graphics::SurfaceDeleter());
+	entry.size = surface->pitch * surface->h;
+	entry.lastUse = ++_useCounter;
+	_size += entry.size;
+
+	// Tickets keep their own reference, so the new entry can go right away
+	// if it does not fit
+	Common::SharedPtr<Graphics::Surface> result = entry.surface;
+	trim();
+
+	return result;
+}
+
+void TransformCache::invalidateSurface(const BaseSurfaceOSystem *owner) {
+	for (EntryMap::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		if (it->_key.owner == owner) {
+			_size -= it->_value.size;
+			_entries.erase(it);
+		}
+	}
+}
+
+void TransformCache::clear() {
+	_entries.clear();
+	_size = 0;
+}
+
+void TransformCache::setMaxSize(uint32 maxSize) {
+	_maxSize = maxSize;
+	trim();
+}
+
+void TransformCache::trim() {
+	while (_size > _maxSize && !_entries.empty()) {
+		EntryMap::iterator oldest = _entries.begin();
+		for (EntryMap::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+			if (it->_value.lastUse < oldest->_value.lastUse)
+				oldest = it;
+		}
+
+		_size -= oldest->_value.size;
+		_entries.erase(oldest);
+	}
+}
+
 RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf,
-                           Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct transform) :
+                           Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct transform, TransformCache *cache) :
 	        _owner(owner),
 	        _srcRect(*srcRect),
 	        _dstRect(*dstRect),
 	        _isValid(true),
 	        _wantsDraw(true),
-	        _transform(transform) {
+	        _transform(transform),
+	        _hasSurface(false) {
 	if (surf) {
 		assert(surf->format.bytesPerPixel == 4);
 
 		// Get a clipped view of the surface
 		const Graphics::Surface temp = surf->getSubArea(*srcRect);
 
-		// Then copy and scale it as necessary
+		// Then scale it as necessary, or draw straight from the owner surface
 		//
 		// NB: The numTimesX/numTimesY properties don't yet mix well with
 		// scaling and rotation, but there is no need for that functionality at
@@ -58,26 +164,49 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 		// NB: Mirroring and rotation are probably done in the wrong order.
 		// (Mirroring should most likely be done before rotation. See also
 		// TransformTools.)
-		if (_transform._angle != Graphics::kDefaultAngle) {
-			_surface = temp.rotoscale(transform, owner->_game->getBilinearFiltering());
-		} else if ((dstRect->width() != srcRect->width() ||
-			    dstRect->height() != srcRect->height()) &&
-			    _transform._numTimesX * _transform._numTimesY == 1) {
-			_surface = temp.scale(dstRect->width(), dstRect->height(), owner->_game->getBilinearFiltering());
+		const bool filtering = owner->_game->getBilinearFiltering();
+		if (_transform._angle != Graphics::kDefaultAngle ||
+			((dstRect->width() != srcRect->width() ||
+			  dstRect->height() != srcRect->height()) &&
+			  _transform._numTimesX * _transform._numTimesY == 1)) {
+			if (cache) {
+				_ownSurface = cache->getTransformedSurface(owner, temp, *srcRect, *dstRect, transform, filtering);
+			} else if (_transform._angle != Graphics::kDefaultAngle) {
+				_ownSurface = Common::SharedPtr<Graphics::Surface>(temp.rotoscale(transform, filtering), Graphics::SurfaceDeleter());
+			} else {
+				_ownSurface = Common::SharedPtr<Graphics::Surface>(temp.scale(dstRect->width(), dstRect->height(), filtering), Graphics::SurfaceDeleter());
+			}
 		} else {
-			_surface = new Graphics::Surface();
-			_surface->copyFrom(temp);
+			_surfaceView = temp;
+			_hasSurface = true;
 		}
-	} else {
-		_surface = nullptr;
 	}
 }
 
 RenderTicket::~RenderTicket() {
-	if (_surface) {
-		_surface->free();
-		delete _surface;
-	}
+}
+
+void RenderTicket::detachSurface() {
+	if (!_hasSurface)
+		return;
+
+	Graphics::Surface *copy = new Graphics::Surface();
+	copy->copyFrom(_surfaceView);
+	_ownSurface = Common::SharedPtr<Graphics::Surface>(copy, Graphics::SurfaceDeleter());
+	_surfaceView = Graphics::Surface();
+	_hasSurface = false;
+}
+
+bool RenderTicket::isOpaque() const {
+	if (!_transform._alphaDisable || _transform._blendMode != Graphics::BLEND_NORMAL)
+		return false;
+
+	// Fills are only made opaque when their color is
+	if (!getSurface())
+		return true;
+
+	return _transform._numTimesX * _transform._numTimesY == 1 && _transform._rgbaMod == Graphics::kDefaultRgbaMod &&
+		getSurface()->w >= _dstRect.width() && getSurface()->h >= _dstRect.height();
 }
 
 bool RenderTicket::operator==(const RenderTicket &t) const {
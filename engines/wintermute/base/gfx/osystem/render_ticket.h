@@ -30,11 +30,81 @@
 
 #include "graphics/managed_surface.h"
 
+#include "common/hashmap.h"
+#include "common/ptr.h"
 #include "common/rect.h"
 
 namespace Wintermute {
 
 class BaseSurfaceOSystem;
+
+/**
+ * A cache of the scaled and rotated versions of sprite surfaces.
+ * Zooming characters and rotating sprites tend to be drawn with the same
+ * transform frame after frame, so the result of a transform is kept around
+ * and shared by all the tickets asking for it. Entries are dropped in least
+ * recently used order once the cache grows beyond its limit, and all the
+ * entries of a surface go away as soon as that surface changes.
+ */
+class TransformCache {
+public:
+	TransformCache();
+	~TransformCache();
+
+	/**
+	 * Look up the transformed version of a part of a surface, creating it
+	 * if it is not in the cache.
+	 * @param owner the surface the pixels belong to
+	 * @param src the part of the surface to transform
+	 * @param srcRect the position of src inside the owner surface
+	 * @param dstRect where the transformed surface will be drawn
+	 * @param transform the transform to apply
+	 * @param filtering whether to use bilinear filtering
+	 */
+	Common::SharedPtr<Graphics::Surface> getTransformedSurface(const BaseSurfaceOSystem *owner, const Graphics::Surface &src,
+		const Common::Rect &srcRect, const Common::Rect &dstRect, const Graphics::TransformStruct &transform, bool filtering);
+
+	void invalidateSurface(const BaseSurfaceOSystem *owner);
+	void clear();
+
+	void setMaxSize(uint32 maxSize);
+	uint32 getSize() const { return _size; }
+
+private:
+	struct Key {
+		const BaseSurfaceOSystem *owner;
+		Common::Rect srcRect;
+		int16 width;
+		int16 height;
+		int32 angle;
+		Common::Point zoom;
+		Common::Point hotspot;
+		byte flip;
+		bool filtering;
+
+		bool operator==(const Key &other) const;
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const;
+	};
+
+	struct Entry {
+		Common::SharedPtr<Graphics::Surface> surface;
+		uint32 size;
+		uint32 lastUse;
+	};
+
+	typedef Common::HashMap<Key, Entry, KeyHash> EntryMap;
+
+	void trim();
+
+	EntryMap _entries;
+	uint32 _size;
+	uint32 _maxSize;
+	uint32 _useCounter;
+};
+
 /**
  * A single RenderTicket.
  * A render ticket is a collection of the data and draw specifications made
@@ -43,17 +113,31 @@ class BaseSurfaceOSystem;
  * the same call is done in the following frame. Thus allowing us to potentially
  * skip drawing the same region again, unless anything has changed. Since a surface
  * can have a potentially large amount of draw-calls made to it, at varying rotation,
- * zoom, and crop-levels we also need to hold a copy of the necessary data.
- * (Video-surfaces may even change their data). The promise that is made when a ticket
- * is created is that what the state was of the surface at THAT point, is what will end
- * up on screen at flip() time.
+ * zoom, and crop-levels the ticket refers to the pixels it needs: straight into the
+ * owner surface when no transform is applied, or to a transformed copy shared through
+ * the TransformCache otherwise. (Video-surfaces may even change their data). The
+ * promise that is made when a ticket is created is that what the state was of the
+ * surface at THAT point, is what will end up on screen at flip() time, so the owner
+ * has to call detachSurface() on its tickets before it changes or frees its pixels.
  */
 class RenderTicket {
 public:
-	RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRest, Graphics::TransformStruct transform);
-	RenderTicket() : _isValid(true), _wantsDraw(false), _transform(Graphics::TransformStruct()) {}
+	RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRest, Graphics::TransformStruct transform, TransformCache *cache = nullptr);
+	RenderTicket() : _isValid(true), _wantsDraw(false), _transform(Graphics::TransformStruct()), _hasSurface(false) {}
 	~RenderTicket();
-	const Graphics::Surface *getSurface() const { return _surface; }
+	const Graphics::Surface *getSurface() const {
+		if (_ownSurface)
+			return _ownSurface.get();
+		return _hasSurface ? &_surfaceView : nullptr;
+	}
+	/**
+	 * Make a private copy of the pixels if they are still borrowed from the owner.
+	 */
+	void detachSurface();
+	/**
+	 * Whether drawing the ticket completely hides what lies below its destination rect.
+	 */
+	bool isOpaque() const;
 	// Non-dirty-rects:
 	void drawToSurface(Graphics::ManagedSurface *_targetSurface) const;
 	// Dirty-rects:
@@ -70,7 +154,9 @@ public:
 	bool operator==(const RenderTicket &a) const;
 	const Common::Rect *getSrcRect() const { return &_srcRect; }
 private:
-	Graphics::Surface *_surface;
+	Common::SharedPtr<Graphics::Surface> _ownSurface;
+	Graphics::Surface _surfaceView;
+	bool _hasSurface;
 	Common::Rect _srcRect;
 };
 
@@ -115,27 +115,33 @@ ScValue *ScStack::getAt(int index) {
 void ScStack::correctParams(uint32 expectedParams) {
 	uint32 numParams = (uint32)pop()->getInt();
 
+	// Values are moved around rather than deleted and created again,
+	// the slots above the stack pointer are reused by the next pushes
 	if (expectedParams < numParams) { // too many params
 		while (expectedParams < numParams) {
 			//pop();
-			delete _values[_sP - expectedParams];
+			ScValue *val = _values[_sP - expectedParams];
 			_values.removeAt(_sP - expectedParams);
+			val->cleanup();
+			_values.add(val);
 			numParams--;
 			_sP--;
 		}
 	} else if (expectedParams > numParams) { // need more params
 		while (expectedParams > numParams) {
 			//push(nullVal);
-			ScValue *nullVal = new ScValue(_game);
+			ScValue *nullVal;
+			if (_values.getSize() > _sP + 1) {
+				nullVal = _values[_values.getSize() - 1];
+				_values.removeAt(_values.getSize() - 1);
+				nullVal->cleanup();
+			} else {
+				nullVal = new ScValue(_game);
+			}
 			nullVal->setNULL();
 			_values.insertAt(_sP - numParams + 1, nullVal);
 			numParams++;
 			_sP++;
-
-			if (_values.getSize() > _sP + 1) {
-				delete _values[_values.getSize() - 1];
-				_values.removeAt(_values.getSize() - 1);
-			}
 		}
 	}
 }
@@ -39,7 +39,7 @@ namespace Wintermute {
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
-IMPLEMENT_PERSISTENT(ScValue, false)
+IMPLEMENT_PERSISTENT_POOLED(ScValue, false)
 
 //////////////////////////////////////////////////////////////////////////
 ScValue::ScValue(BaseGame *inGame) : BaseClass(inGame) {
@@ -121,8 +121,12 @@ ScValue::ScValue(BaseGame *inGame, const char *val) : BaseClass(inGame) {
 void ScValue::cleanup(bool ignoreNatives) {
 	deleteProps();
 
-	if (_valString) {
-		delete[] _valString;
+	// Small string buffers are kept for the next string stored in this
+	// value, as stack slots and temporaries get cleaned up all the time
+	if (_stringBufferSize > kMaxSpareStringSize) {
+		delete[] _stringBuffer;
+		_stringBuffer = nullptr;
+		_stringBufferSize = 0;
 	}
 
 	if (!ignoreNatives) {
@@ -151,6 +155,8 @@ void ScValue::cleanup(bool ignoreNatives) {
 //////////////////////////////////////////////////////////////////////////
 ScValue::~ScValue() {
 	cleanup();
+
+	delete[] _stringBuffer;
 }
 
 
@@ -446,16 +452,22 @@ void ScValue::setString(const Common::String &val) {
 
 //////////////////////////////////////////////////////////////////////////
 void ScValue::setStringVal(const char *val) {
-	delete[] _valString;
-
 	if (val == nullptr) {
 		_valString = nullptr;
 		return;
 	}
 
-	size_t valSize = strlen(val) + 1;
-	_valString = new char[valSize];
-	Common::strcpy_s(_valString, valSize, val);
+	uint32 valSize = strlen(val) + 1;
+	if (valSize > _stringBufferSize) {
+		char *buffer = new char[valSize];
+		memcpy(buffer, val, valSize);
+		delete[] _stringBuffer;
+		_stringBuffer = buffer;
+		_stringBufferSize = valSize;
+	} else if (val != _stringBuffer) {
+		memmove(_stringBuffer, val, valSize);
+	}
+	_valString = _stringBuffer;
 }
 
 
@@ -819,14 +831,20 @@ bool ScValue::persist(BasePersistenceManager *persistMgr) {
 	persistMgr->transferPtr(TMEMBER_PTR(_valRef));
 	persistMgr->transferCharPtr(TMEMBER(_valString));
 
+	if (!persistMgr->getIsSaving()) {
+		// Values are loaded into freshly built instances, which have no
+		// string buffer yet: the loaded string becomes the string buffer
+		_stringBuffer = _valString;
+		_stringBufferSize = _valString ? strlen(_valString) + 1 : 0;
+	}
+
 	if (!persistMgr->getIsSaving() && !persistMgr->checkVersion(1,2,2)) {
 		// Savegames prior to 1.2.2 stored empty strings as NULL.
 		// We disambiguate those by turning NULL strings into empty
 		// strings if _type is VAL_STRING instead of VAL_NULL.
 
 		if (_type == VAL_STRING && !_valString) {
-			_valString = new char[1];
-			_valString[0] = '\0';
+			setStringVal("");
 		}
 	}
 	/*
@@ -103,6 +103,14 @@ public:
 	bool setProperty(const char *propName, double value);
 	bool setProperty(const char *propName, bool value);
 	bool setProperty(const char *propName);
+
+private:
+	static const uint32 kMaxSpareStringSize = 256;
+
+	// Initialized here, so that the dynamic constructor used to load saved
+	// games sets them as well: pooled instances reuse the memory of deleted ones
+	char *_stringBuffer = nullptr;
+	uint32 _stringBufferSize = 0;
 };
 
 } // End of namespace Wintermute
@@ -125,6 +125,7 @@ MODULE_OBJS := \
 	system/sys_class.o \
 	system/sys_class_registry.o \
 	system/sys_instance.o \
+	system/sys_pool.o \
 	ui/ui_button.o \
 	ui/ui_edit.o \
 	ui/ui_entity.o \
@@ -39,6 +39,7 @@ typedef void(*SYS_INSTANCE_CALLBACK)(void *instance, void *data);
 } // End of namespace Wintermute
 
 #include "engines/wintermute/system/sys_class_registry.h"
+#include "engines/wintermute/system/sys_pool.h"
 namespace Wintermute {
 
 
@@ -53,11 +54,8 @@ namespace Wintermute {
 	void operator delete(void* p);\
 
 
-#define IMPLEMENT_PERSISTENT(className, persistentClass)\
+#define IMPLEMENT_PERSISTENT_COMMON(className)\
 	const char className::_className[] = #className;\
-	void* className::persistBuild() {\
-		return ::new className(DYNAMIC_CONSTRUCTOR, DYNAMIC_CONSTRUCTOR);\
-	}\
 	\
 	bool className::persistLoad(void *Instance, BasePersistenceManager *persistMgr) {\
 		return ((className*)Instance)->persist(persistMgr);\
@@ -68,6 +66,14 @@ namespace Wintermute {
 	}\
 	\
 	/*SystemClass Register##class_name(class_name::_className, class_name::PersistBuild, class_name::PersistLoad, persistent_class);*/\
+
+
+#define IMPLEMENT_PERSISTENT(className, persistentClass)\
+	IMPLEMENT_PERSISTENT_COMMON(className)\
+	\
+	void* className::persistBuild() {\
+		return ::new className(DYNAMIC_CONSTRUCTOR, DYNAMIC_CONSTRUCTOR);\
+	}\
 	\
 	void* className::operator new(size_t size) {\
 		void* ret = ::operator new(size);\
@@ -80,6 +86,29 @@ namespace Wintermute {
 		::operator delete(p);\
 	}\
 
+
+// Same as IMPLEMENT_PERSISTENT, for classes with lots of short-lived
+// instances: their memory comes from a SystemPool instead of the heap.
+#define IMPLEMENT_PERSISTENT_POOLED(className, persistentClass)\
+	IMPLEMENT_PERSISTENT_COMMON(className)\
+	\
+	static SystemPool className##Pool;\
+	\
+	void* className::persistBuild() {\
+		return ::new (className##Pool.allocate(sizeof(className))) className(DYNAMIC_CONSTRUCTOR, DYNAMIC_CONSTRUCTOR);\
+	}\
+	\
+	void* className::operator new(size_t size) {\
+		void* ret = className##Pool.allocate(size);\
+		SystemClassRegistry::getInstance()->registerInstance(#className, ret);\
+		return ret;\
+	}\
+	\
+	void className::operator delete(void *p) {\
+		SystemClassRegistry::getInstance()->unregisterInstance(#className, p);\
+		className##Pool.release(p);\
+	}\
+
 #define TMEMBER(memberName) #memberName, &memberName
 #define TMEMBER_PTR(memberName) #memberName, &memberName
 #define TMEMBER_INT(memberName) #memberName, (int32 *)&memberName
@@ -0,0 +1,90 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * This file is based on WME Lite.
+ * http://dead-code.org/redir.php?target=wmelite
+ * Copyright (c) 2011 Jan Nedoma
+ */
+
+#include "engines/wintermute/system/sys_pool.h"
+
+#include "common/textconsole.h"
+#include "common/util.h"
+
+namespace Wintermute {
+
+//////////////////////////////////////////////////////////////////////////
+void *SystemPool::allocate(size_t size) {
+	if (!_objectSize) {
+		// Free objects hold the free list link, and objects stay aligned
+		// like anything returned by malloc()
+		_objectSize = MAX(size, sizeof(void *));
+		_objectSize = (_objectSize + sizeof(double) - 1) & ~(sizeof(double) - 1);
+	}
+	assert(size <= _objectSize);
+
+	if (!_freeList) {
+		// The first slot of every block links it to the next block
+		byte *block = (byte *)malloc((kObjectsPerBlock + 1) * _objectSize);
+		if (!block) {
+			error("SystemPool: Out of memory");
+		}
+
+		*(void **)block = _blocks;
+		_blocks = block;
+
+		for (uint32 i = kObjectsPerBlock; i > 0; i--) {
+			void *object = block + i * _objectSize;
+			*(void **)object = _freeList;
+			_freeList = object;
+		}
+	}
+
+	void *object = _freeList;
+	_freeList = *(void **)object;
+	_numObjects++;
+
+	return object;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SystemPool::release(void *ptr) {
+	if (!ptr) {
+		return;
+	}
+
+	*(void **)ptr = _freeList;
+	_freeList = ptr;
+
+	if (--_numObjects) {
+		return;
+	}
+
+	while (_blocks) {
+		void *next = *(void **)_blocks;
+		free(_blocks);
+		_blocks = next;
+	}
+	_freeList = nullptr;
+}
+
+} // End of namespace Wintermute
@@ -0,0 +1,61 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * This file is based on WME Lite.
+ * http://dead-code.org/redir.php?target=wmelite
+ * Copyright (c) 2011 Jan Nedoma
+ */
+
+#ifndef WINTERMUTE_SYSPOOL_H
+#define WINTERMUTE_SYSPOOL_H
+
+#include "common/scummsys.h"
+
+namespace Wintermute {
+
+/**
+ * Free list allocator for objects of a single class.
+ * Memory is taken from the heap in blocks of kObjectsPerBlock objects,
+ * and returned once every object of the pool is gone. Pools are meant to
+ * be static: they need no constructor, so they are usable at any time.
+ */
+class SystemPool {
+public:
+	void *allocate(size_t size);
+	void release(void *ptr);
+
+	uint32 getNumObjects() const {
+		return _numObjects;
+	}
+
+private:
+	static const uint32 kObjectsPerBlock = 256;
+
+	void *_freeList = nullptr;
+	void *_blocks = nullptr;
+	size_t _objectSize = 0;
+	uint32 _numObjects = 0;
+};
+
+} // End of namespace Wintermute
+
+#endif
@@ -0,0 +1,101 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "zvision/graphics/render_table.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace ZVision {
+
+// Interpolates one RGB555 channel of four pixels. The taps are weighted and
+// summed in the same order as the scalar path, so the results are identical.
+static FORCEINLINE __m128i bilinearChannel(__m128i tl, __m128i tr, __m128i bl, __m128i br,
+		__m128 fTL, __m128 fTR, __m128 fBL, __m128 fBR, __m128i mask) {
+	__m128 sum = _mm_add_ps(_mm_mul_ps(fTL, _mm_cvtepi32_ps(_mm_and_si128(tl, mask))),
+	                        _mm_mul_ps(fTR, _mm_cvtepi32_ps(_mm_and_si128(tr, mask))));
+	sum = _mm_add_ps(sum, _mm_mul_ps(fBL, _mm_cvtepi32_ps(_mm_and_si128(bl, mask))));
+	sum = _mm_add_ps(sum, _mm_mul_ps(fBR, _mm_cvtepi32_ps(_mm_and_si128(br, mask))));
+	return _mm_cvttps_epi32(sum);
+}
+
+int mutateRowBilinearSSE2(const FilterPixel *row, const uint16 *src, uint16 *dst, int y, int width, int pitch) {
+	const __m128i maskR = _mm_set1_epi32(0x001f);
+	const __m128i maskG = _mm_set1_epi32(0x03e0);
+	const __m128i maskB = _mm_set1_epi32(0x7c00);
+
+	int x = 0;
+	for (; x + 4 <= width; x += 4) {
+		int32 tl[4], tr[4], bl[4], br[4];
+		for (int i = 0; i < 4; i++) {
+			const FilterPixel &p = row[x + i];
+			const uint16 *srcT = src + (y + p._src.top) * pitch + x + i;
+			const uint16 *srcB = src + (y + p._src.bottom) * pitch + x + i;
+			tl[i] = srcT[p._src.left];
+			tr[i] = srcT[p._src.right];
+			bl[i] = srcB[p._src.left];
+			br[i] = srcB[p._src.right];
+		}
+
+		const __m128i vTL = _mm_setr_epi32(tl[0], tl[1], tl[2], tl[3]);
+		const __m128i vTR = _mm_setr_epi32(tr[0], tr[1], tr[2], tr[3]);
+		const __m128i vBL = _mm_setr_epi32(bl[0], bl[1], bl[2], bl[3]);
+		const __m128i vBR = _mm_setr_epi32(br[0], br[1], br[2], br[3]);
+		const __m128 fTL = _mm_setr_ps(row[x]._fTL, row[x + 1]._fTL, row[x + 2]._fTL, row[x + 3]._fTL);
+		const __m128 fTR = _mm_setr_ps(row[x]._fTR, row[x + 1]._fTR, row[x + 2]._fTR, row[x + 3]._fTR);
+		const __m128 fBL = _mm_setr_ps(row[x]._fBL, row[x + 1]._fBL, row[x + 2]._fBL, row[x + 3]._fBL);
+		const __m128 fBR = _mm_setr_ps(row[x]._fBR, row[x + 1]._fBR, row[x + 2]._fBR, row[x + 3]._fBR);
+
+		const __m128i r = bilinearChannel(vTL, vTR, vBL, vBR, fTL, fTR, fBL, fBR, maskR);
+		const __m128i g = bilinearChannel(vTL, vTR, vBL, vBR, fTL, fTR, fBL, fBR, maskG);
+		const __m128i b = bilinearChannel(vTL, vTR, vBL, vBR, fTL, fTR, fBL, fBR, maskB);
+
+		// Same as RenderTable::mergeColor(); the merged colors fit in 15 bits
+		const __m128i color = _mm_or_si128(r, _mm_or_si128(_mm_and_si128(g, maskG), _mm_and_si128(b, maskB)));
+		_mm_storel_epi64((__m128i *)(dst + x), _mm_packs_epi32(color, color));
+	}
+
+	return x;
+}
+
+} // End of namespace ZVision
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
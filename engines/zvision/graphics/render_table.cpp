@@ -45,6 +45,12 @@ RenderTable::RenderTable(ZVision *engine, uint16 numColumns, uint16 numRows, con
 	_halfColumns = floor((_numColumns - 1) / 2);
 	_halfWidth = (float)_numColumns / 2.0f - 0.5f;
 	_halfHeight = (float)_numRows / 2.0f - 0.5f;
+
+#ifdef SCUMMVM_SSE2
+	_useSSE2 = _system->hasFeature(OSystem::kFeatureCpuSSE2);
+#else
+	_useSSE2 = false;
+#endif
 }
 
 RenderTable::~RenderTable() {
@@ -143,7 +149,14 @@ void RenderTable::mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcB
 		// Apply bilinear interpolation
 		for (int16 y = 0; y < srcBuf->h; ++y) {
 			sourceOffset = y * _numColumns;
-			for (int16 x = 0; x < srcBuf->w; ++x) {
+			int16 x = 0;
+#ifdef SCUMMVM_SSE2
+			if (_useSSE2) {
+				x = mutateRowBilinearSSE2(&_internalBuffer[sourceOffset], sourceBuffer, destBuffer + destOffset, y, srcBuf->w, _numColumns);
+				destOffset += x;
+			}
+#endif
+			for (; x < srcBuf->w; ++x) {
 				const FilterPixel &curP = _internalBuffer[sourceOffset + x];
 				const uint32 srcIndexYT = y + curP._src.top;
 				const uint32 srcIndexYB = y + curP._src.bottom;
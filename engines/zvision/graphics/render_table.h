@@ -89,6 +89,7 @@ private:
 	FilterPixel *_internalBuffer;
 	RenderState _renderState;
 	bool _highQuality = false;
+	bool _useSSE2;
 	const Graphics::PixelFormat _pixelFormat;
 
 	inline void splitColor(uint16 &color, uint32 &r, uint32 &g, uint32 &b) const {
@@ -164,6 +165,11 @@ private:
 	void generateTiltLookupTable();
 };
 
+#ifdef SCUMMVM_SSE2
+// Bilinear warp of one row, four pixels at a time; returns the number of pixels done
+int mutateRowBilinearSSE2(const FilterPixel *row, const uint16 *src, uint16 *dst, int y, int width, int pitch);
+#endif
+
 } // End of namespace ZVision
 
 #endif
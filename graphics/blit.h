@@ -30,6 +30,7 @@ struct Point;
 }
 
 class BlendBlitUnfilteredTestSuite;
+class BlitBenchmarkTestSuite;
 
 namespace Graphics {
 
@@ -366,6 +367,7 @@ private:
 	static FillFunc fillFunc;
 
 	friend class ::BlendBlitUnfilteredTestSuite;
+	friend class ::BlitBenchmarkTestSuite;
 	friend class BlendBlitImpl_Default;
 	friend class BlendBlitImpl_NEON;
 	friend class BlendBlitImpl_SSE2;
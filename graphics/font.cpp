@@ -97,6 +97,9 @@ Common::Rect getBoundingBoxImpl(const Font &font, const StringType &str, int x,
 
 template<class StringType>
 int getStringWidthImpl(const Font &font, const StringType &str) {
+	if (const TextRun *run = font.getTextRun(str))
+		return run->width;
+
 	int space = 0;
 	typename StringType::unsigned_type last = 0;
 
@@ -109,6 +112,26 @@ int getStringWidthImpl(const Font &font, const StringType &str) {
 	return space;
 }
 
+bool drawTextRunImpl(const Font &font, Surface *dst, const TextRun &run, int x, int y, int leftX, int rightX, uint32 color, bool alpha, bool allowCharClipping) {
+	return font.drawTextRun(dst, run, x, y, leftX, rightX, color, alpha, allowCharClipping, nullptr, nullptr);
+}
+
+bool drawTextRunImpl(const Font &font, ManagedSurface *dst, const TextRun &run, int x, int y, int leftX, int rightX, uint32 color, bool alpha, bool allowCharClipping) {
+	// Match what drawChar and drawAlphaChar do for managed surfaces
+	uint32 transColor = 0;
+	const bool useTransColor = !alpha && dst->hasTransparentColor();
+	if (useTransColor)
+		transColor = dst->getTransparentColor();
+
+	Common::Rect drawnBox;
+	if (!font.drawTextRun(dst->surfacePtr(), run, x, y, leftX, rightX, color, alpha, allowCharClipping, useTransColor ? &transColor : nullptr, &drawnBox))
+		return false;
+
+	if (!drawnBox.isEmpty())
+		dst->addDirtyRect(drawnBox);
+	return true;
+}
+
 template<class SurfaceType, class StringType>
 void drawStringImpl(const Font &font, SurfaceType *dst, const StringType &str, int x, int y, int w, uint32 color, TextAlign align, int deltax, bool alpha, bool allowCharClipping) {
 	// The logic in getBoundingImpl is the same as we use here. In case we
@@ -116,7 +139,8 @@ void drawStringImpl(const Font &font, SurfaceType *dst, const StringType &str, i
 	assert(dst != 0);
 
 	const int leftX = MAX<int>(x, 0), rightX = x + w + 1;
-	int width = font.getStringWidth(str);
+	const TextRun *run = font.getTextRun(str);
+	int width = run ? run->width : font.getStringWidth(str);
 
 	if (align == kTextAlignCenter)
 		x = x + (w - width)/2;
@@ -124,6 +148,9 @@ void drawStringImpl(const Font &font, SurfaceType *dst, const StringType &str, i
 		x = x + w - width;
 	x += deltax;
 
+	if (run && drawTextRunImpl(font, dst, *run, x, y, leftX, rightX, color, alpha, allowCharClipping))
+		return;
+
 	typename StringType::unsigned_type last = 0;
 	for (typename StringType::const_iterator i = str.begin(), end = str.end(); i != end; ++i) {
 		const typename StringType::unsigned_type cur = *i;
@@ -74,6 +74,20 @@ enum WordWrapMode {
  */
 TextAlign convertTextAlignH(TextAlign alignH, bool rtl);
 
+/**
+ * Layout of a string, as computed by Font::getTextRun().
+ */
+struct TextRun {
+	struct Char {
+		uint32 chr; ///< The character.
+		int x;      ///< Pen position of the character, relative to the start of the run.
+	};
+
+	const Char *chars; ///< The characters of the string, in drawing order.
+	uint size;         ///< Number of characters.
+	int width;         ///< Logical width of the string, as returned by Font::getStringWidth().
+};
+
 /**
  * Instances of this class represent a distinct font, with a built-in renderer.
  *
@@ -191,6 +205,47 @@ public:
 	/** @overload */
 	Common::Rect getBoundingBox(const Common::U32String &str, int x = 0, int _y = 0, const int w = 0, TextAlign align = kTextAlignLeft, int deltax = 0, bool useEllipsis = false, bool allowCharClipping = false) const;
 
+	/**
+	 * Return the layout of a string, with the kerning between characters
+	 * already applied.
+	 *
+	 * Fonts that cache laid out strings implement this to avoid querying
+	 * every character for each string drawn. The returned run is owned by
+	 * the font and stays valid until the next call to a method of the font.
+	 *
+	 * @param str  The string to lay out.
+	 *
+	 * @return The layout of the string, or nullptr if it is not available, in
+	 *         which case the string is laid out character by character.
+	 */
+	virtual const TextRun *getTextRun(const Common::String &str) const { return nullptr; }
+	/** @overload */
+	virtual const TextRun *getTextRun(const Common::U32String &str) const { return nullptr; }
+
+	/**
+	 * Draw a run returned by getTextRun() in one go.
+	 *
+	 * Characters ending left of @p leftX are skipped and drawing stops at the
+	 * first character ending right of @p rightX, unless @p allowCharClipping
+	 * is set.
+	 *
+	 * @param dst               The surface to draw on.
+	 * @param run               The run to draw. It must come from this font.
+	 * @param x                 The x coordinate of the start of the run.
+	 * @param y                 The y coordinate of the start of the run.
+	 * @param leftX             Left boundary of the text area.
+	 * @param rightX            Right boundary of the text area.
+	 * @param color             The color of the characters.
+	 * @param alpha             Whether to store the alpha channel, as drawAlphaChar() does.
+	 * @param allowCharClipping Allows characters to extend beyond the right boundary.
+	 * @param transparentColor  Color of @p dst to treat as transparent. Can be nullptr.
+	 * @param drawnBox          If not nullptr, receives the area covered by the drawn characters.
+	 *
+	 * @return False if the font can not draw runs. Nothing is drawn then.
+	 */
+	virtual bool drawTextRun(Surface *dst, const TextRun &run, int x, int y, int leftX, int rightX, uint32 color, bool alpha,
+	                         bool allowCharClipping, const uint32 *transparentColor, Common::Rect *drawnBox) const { return false; }
+
 	/**
 	 * Draw a character at a specific point on the surface.
 	 *
@@ -37,6 +37,7 @@
 #include "common/singleton.h"
 #include "common/stream.h"
 #include "common/memstream.h"
+#include "common/md5.h"
 #include "common/hashmap.h"
 #include "common/ptr.h"
 #include "common/compression/unzip.h"
@@ -79,6 +80,9 @@ namespace Graphics {
 
 namespace {
 
+// How much of the start of a font file is hashed to identify its face in the glyph atlas
+static const uint32 kAtlasFaceHashSize = 64 * 1024;
+
 static inline int ftFloor26_6(FT_Pos x) {
 	return (x) / 64;
 }
@@ -112,8 +116,232 @@ private:
 	static unsigned long readCallback(FT_Stream stream, unsigned long offset, unsigned char *buffer, unsigned long count);
 };
 
+/**
+ * Glyph images shared by all fonts using the same face with the same size and
+ * rendering settings. The images of a face are packed into atlas pages, so
+ * loading the same font several times renders every glyph only once.
+ */
+class TTFGlyphAtlas : public Common::Singleton<TTFGlyphAtlas> {
+public:
+	struct Glyph {
+		Surface image; ///< View into an atlas page
+		int xOffset, yOffset;
+		int advance;
+	};
+
+	class Face {
+	public:
+		Face();
+		~Face();
+
+		const Glyph *findGlyph(FT_UInt slot) const;
+		const Glyph *addGlyph(FT_UInt slot, const Surface &image, int xOffset, int yOffset, int advance);
+
+		bool findKerning(FT_UInt left, FT_UInt right, int &offset) const;
+		void addKerning(FT_UInt left, FT_UInt right, int offset);
+
+		/**
+		 * Return the memory used by the atlas pages of this face.
+		 */
+		uint32 getMemoryUsage() const { return _memoryUsage; }
+
+	private:
+		friend class TTFGlyphAtlas;
+
+		static const int kPageSize = 256;
+		static const uint kMaxKerningPairs = 4096;
+
+		Surface *newPage(int w, int h);
+		Surface *allocate(int w, int h, int &x, int &y);
+
+		Common::Array<Surface *> _pages;
+		Surface *_shelfPage;
+		int _shelfX, _shelfY, _shelfHeight;
+
+		typedef Common::HashMap<FT_UInt, Glyph> GlyphMap;
+		GlyphMap _glyphs;
+		typedef Common::HashMap<uint64, int> KerningMap;
+		KerningMap _kerning;
+
+		uint32 _memoryUsage;
+		uint32 _lastUse;
+	};
+
+	typedef Common::SharedPtr<Face> FacePtr;
+
+	TTFGlyphAtlas();
+
+	/**
+	 * Return the glyphs for the face described by @p key, creating an empty
+	 * set if no font used it so far.
+	 */
+	FacePtr getFace(const Common::String &key);
+
+	void setMemoryLimit(uint32 bytes);
+	uint32 getMemoryUsage() const;
+
+private:
+	static const uint32 kDefaultMemoryLimit = 4 * 1024 * 1024;
+
+	/**
+	 * Discard faces no font uses anymore, least recently requested first,
+	 * until the memory limit is respected.
+	 */
+	void trim();
+
+	typedef Common::HashMap<Common::String, FacePtr> FaceMap;
+	FaceMap _faces;
+	uint32 _memoryLimit;
+	uint32 _useCounter;
+};
+
+TTFGlyphAtlas::Face::Face()
+	: _shelfPage(nullptr), _shelfX(0), _shelfY(0), _shelfHeight(0), _memoryUsage(0), _lastUse(0) {
+}
+
+TTFGlyphAtlas::Face::~Face() {
+	for (uint i = 0; i < _pages.size(); ++i) {
+		_pages[i]->free();
+		delete _pages[i];
+	}
+}
+
+const TTFGlyphAtlas::Glyph *TTFGlyphAtlas::Face::findGlyph(FT_UInt slot) const {
+	GlyphMap::const_iterator i = _glyphs.find(slot);
+	return (i != _glyphs.end()) ? &i->_value : nullptr;
+}
+
+const TTFGlyphAtlas::Glyph *TTFGlyphAtlas::Face::addGlyph(FT_UInt slot, const Surface &image, int xOffset, int yOffset, int advance) {
+	Glyph &glyph = _glyphs[slot];
+	glyph.xOffset = xOffset;
+	glyph.yOffset = yOffset;
+	glyph.advance = advance;
+
+	if (image.w <= 0 || image.h <= 0) {
+		glyph.image.init(image.w, image.h, 0, nullptr, image.format);
+		return &glyph;
+	}
+
+	int x, y;
+	Surface *page = allocate(image.w, image.h, x, y);
+	page->copyRectToSurface(image, x, y, Common::Rect(image.w, image.h));
+	glyph.image = page->getSubArea(Common::Rect(x, y, x + image.w, y + image.h));
+	return &glyph;
+}
+
+bool TTFGlyphAtlas::Face::findKerning(FT_UInt left, FT_UInt right, int &offset) const {
+	KerningMap::const_iterator i = _kerning.find(((uint64)left << 32) | right);
+	if (i == _kerning.end())
+		return false;
+
+	offset = i->_value;
+	return true;
+}
+
+void TTFGlyphAtlas::Face::addKerning(FT_UInt left, FT_UInt right, int offset) {
+	if (_kerning.size() >= kMaxKerningPairs)
+		_kerning.clear();
+
+	_kerning[((uint64)left << 32) | right] = offset;
+}
+
+Surface *TTFGlyphAtlas::Face::newPage(int w, int h) {
+	Surface *page = new Surface();
+	page->create(w, h, PixelFormat::createFormatCLUT8());
+	_pages.push_back(page);
+	_memoryUsage += page->pitch * page->h;
+	return page;
+}
+
+Surface *TTFGlyphAtlas::Face::allocate(int w, int h, int &x, int &y) {
+	// Glyphs which do not fit into a regular page get a page of their own
+	if (w > kPageSize || h > kPageSize) {
+		x = y = 0;
+		return newPage(w, h);
+	}
+
+	// Glyphs are put next to each other on shelves as high as the
+	// highest glyph they hold
+	if (_shelfPage && _shelfX + w > kPageSize) {
+		_shelfY += _shelfHeight;
+		_shelfX = 0;
+		_shelfHeight = 0;
+	}
+
+	if (!_shelfPage || _shelfY + h > kPageSize) {
+		_shelfPage = newPage(kPageSize, kPageSize);
+		_shelfX = _shelfY = _shelfHeight = 0;
+	}
+
+	x = _shelfX;
+	y = _shelfY;
+	_shelfX += w;
+	_shelfHeight = MAX(_shelfHeight, h);
+	return _shelfPage;
+}
+
+TTFGlyphAtlas::TTFGlyphAtlas() : _memoryLimit(kDefaultMemoryLimit), _useCounter(0) {
+}
+
+TTFGlyphAtlas::FacePtr TTFGlyphAtlas::getFace(const Common::String &key) {
+	FaceMap::iterator i = _faces.find(key);
+	if (i != _faces.end()) {
+		i->_value->_lastUse = ++_useCounter;
+		return i->_value;
+	}
+
+	trim();
+
+	FacePtr face(new Face());
+	face->_lastUse = ++_useCounter;
+	_faces[key] = face;
+	return face;
+}
+
+void TTFGlyphAtlas::setMemoryLimit(uint32 bytes) {
+	_memoryLimit = bytes;
+	trim();
+}
+
+uint32 TTFGlyphAtlas::getMemoryUsage() const {
+	uint32 usage = 0;
+	for (FaceMap::const_iterator i = _faces.begin(); i != _faces.end(); ++i)
+		usage += i->_value->getMemoryUsage();
+	return usage;
+}
+
+void TTFGlyphAtlas::trim() {
+	uint32 usage = getMemoryUsage();
+
+	while (usage > _memoryLimit) {
+		FaceMap::iterator oldest = _faces.end();
+		for (FaceMap::iterator i = _faces.begin(); i != _faces.end(); ++i) {
+			// Faces still referenced by a font are never discarded
+			if (i->_value.refCount() > 1)
+				continue;
+			if (oldest == _faces.end() || i->_value->_lastUse < oldest->_value->_lastUse)
+				oldest = i;
+		}
+
+		if (oldest == _faces.end())
+			break;
+
+		usage -= oldest->_value->getMemoryUsage();
+		_faces.erase(oldest);
+	}
+}
+
+void setTTFGlyphAtlasLimit(uint32 bytes) {
+	TTFGlyphAtlas::instance().setMemoryLimit(bytes);
+}
+
+uint32 getTTFGlyphAtlasSize() {
+	return TTFGlyphAtlas::instance().getMemoryUsage();
+}
+
 void shutdownTTF() {
 	TTFLibrary::destroy();
+	TTFGlyphAtlas::destroy();
 }
 
 #define g_ttf ::Graphics::TTFLibrary::instance()
@@ -186,6 +414,11 @@ public:
 	void drawAlphaChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const override;
 	void drawAlphaChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const override;
 
+	const TextRun *getTextRun(const Common::String &str) const override;
+	const TextRun *getTextRun(const Common::U32String &str) const override;
+	bool drawTextRun(Surface *dst, const TextRun &run, int x, int y, int leftX, int rightX, uint32 color, bool alpha,
+	                 bool allowCharClipping, const uint32 *transparentColor, Common::Rect *drawnBox) const override;
+
 private:
 	bool _initialized;
 	FT_StreamRec_ _stream;
@@ -198,18 +431,36 @@ private:
 	int _ascent, _descent;
 
 	struct Glyph {
-		Surface image;
+		Surface image; ///< View into the glyph atlas
 		int xOffset, yOffset;
 		int advance;
 		FT_UInt slot;
 	};
 
 	bool cacheGlyph(Glyph &glyph, uint32 chr) const;
+	const TTFGlyphAtlas::Glyph *rasterizeGlyph(FT_UInt slot) const;
 	typedef Common::HashMap<uint32, Glyph> GlyphCache;
 	mutable GlyphCache _glyphs;
 	bool _allowLateCaching;
 	void assureCached(uint32 chr) const;
 
+	TTFGlyphAtlas::FacePtr _atlasFace;
+
+	static const uint kMaxTextRuns = 128;
+	static const uint kMaxTextRunLength = 256;
+
+	struct CachedTextRun : public TextRun {
+		Common::Array<TextRun::Char> charStorage;
+		Common::Array<const Glyph *> glyphs;
+		uint32 lastUse;
+	};
+
+	template<class StringType>
+	const TextRun *getTextRunImpl(Common::HashMap<StringType, CachedTextRun> &cache, const StringType &str) const;
+	mutable Common::HashMap<Common::String, CachedTextRun> _textRuns;
+	mutable Common::HashMap<Common::U32String, CachedTextRun> _u32TextRuns;
+	mutable uint32 _textRunUse;
+
 	Common::SeekableReadStream *readTTFTable(FT_ULong tag) const;
 
 	int computePointSize(int size, TTFSizeMode sizeMode) const;
@@ -217,6 +468,8 @@ private:
 	int computePointSizeFromHeaders(int height) const;
 	void drawCharIntern(Surface *dst, uint32 chr, int x, int y, uint32 color,
 		const uint32 *transparentColor, bool alpha) const;
+	void drawGlyphIntern(Surface *dst, const Glyph &glyph, int x, int y, uint32 color,
+		const uint32 *transparentColor, bool alpha) const;
 
 	FT_Int32 _loadFlags;
 	FT_Render_Mode _renderMode;
@@ -230,7 +483,7 @@ TTFFont::TTFFont()
 	: _initialized(false), _stream(), _face(), _ttfFile(0), _width(0), _height(0), _ascent(0),
 	  _descent(0), _glyphs(), _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
 	  _hasKerning(false), _allowLateCaching(false), _fakeBold(false), _fakeItalic(false),
-	  _disposeAfterUse(DisposeAfterUse::NO) {
+	  _disposeAfterUse(DisposeAfterUse::NO), _textRunUse(0) {
 }
 
 TTFFont::~TTFFont() {
@@ -241,9 +494,6 @@ TTFFont::~TTFFont() {
 			delete _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
-
 		_initialized = false;
 	}
 }
@@ -380,6 +630,19 @@ bool TTFFont::load(Common::SeekableReadStream *ttfFile, DisposeAfterUse::Flag di
 		_loadFlags |= FT_LOAD_NO_BITMAP;
 	}
 
+	// Fonts with the same face and settings share their rendered glyphs. The
+	// face is identified by the start of the font file and its metrics, as
+	// different files may well carry the same names and number of glyphs.
+	// Hashing the whole file would make loading large CJK fonts slow.
+	_ttfFile->seek(0);
+	const Common::String fileHash = Common::computeStreamMD5AsString(*_ttfFile, kAtlasFaceHashSize);
+	_atlasFace = TTFGlyphAtlas::instance().getFace(Common::String::format("%s|%d|%ld|%ld|%d|%d|%d|%d|%ld|%ld|%ld|%ld|%ld|%ld|%d|%d|%d|%d|%d|%d|%d",
+		fileHash.c_str(), (int)_ttfFile->size(), (long)_face->face_index, (long)_face->num_glyphs,
+		(int)_face->units_per_EM, (int)_face->ascender, (int)_face->descender, (int)_face->max_advance_width,
+		(long)_face->bbox.xMin, (long)_face->bbox.yMin, (long)_face->bbox.xMax, (long)_face->bbox.yMax,
+		(long)_face->size->metrics.x_scale, (long)_face->size->metrics.y_scale, _ascent,
+		(int)_loadFlags, (int)_renderMode, _fakeBold, _fakeItalic, stemDarkening, computePointSize(size, sizeMode)));
+
 	if (!mapping) {
 		// Allow loading of all unicode characters.
 		_allowLateCaching = true;
@@ -601,9 +864,15 @@ int TTFFont::getKerningOffset(uint32 left, uint32 right) const {
 	if (!leftGlyph || !rightGlyph)
 		return 0;
 
+	int offset;
+	if (_atlasFace->findKerning(leftGlyph, rightGlyph, offset))
+		return offset;
+
 	FT_Vector kerningVector;
 	FT_Get_Kerning(_face, leftGlyph, rightGlyph, FT_KERNING_DEFAULT, &kerningVector);
-	return (kerningVector.x / 64);
+	offset = kerningVector.x / 64;
+	_atlasFace->addKerning(leftGlyph, rightGlyph, offset);
+	return offset;
 }
 
 Common::Rect TTFFont::getBoundingBox(uint32 chr) const {
@@ -726,8 +995,11 @@ void TTFFont::drawCharIntern(Surface * dst, uint32 chr, int x, int y, uint32 col
 	if (glyphEntry == _glyphs.end())
 		return;
 
-	const Glyph &glyph = glyphEntry->_value;
+	drawGlyphIntern(dst, glyphEntry->_value, x, y, color, transparentColor, alpha);
+}
 
+void TTFFont::drawGlyphIntern(Surface *dst, const Glyph &glyph, int x, int y, uint32 color,
+		const uint32 *transparentColor, bool alpha) const {
 	x += glyph.xOffset;
 	y += glyph.yOffset;
 
@@ -812,22 +1084,37 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 
 	glyph.slot = slot;
 
+	const TTFGlyphAtlas::Glyph *shared = _atlasFace->findGlyph(slot);
+	if (!shared) {
+		shared = rasterizeGlyph(slot);
+		if (!shared)
+			return false;
+	}
+
+	glyph.image = shared->image;
+	glyph.xOffset = shared->xOffset;
+	glyph.yOffset = shared->yOffset;
+	glyph.advance = shared->advance;
+	return true;
+}
+
+const TTFGlyphAtlas::Glyph *TTFFont::rasterizeGlyph(FT_UInt slot) const {
 	// We use the light target and render mode to improve the looks of the
 	// glyphs. It is most noticeable in FreeSansBold.ttf, where otherwise the
 	// 't' glyph looks like it is cut off on the right side.
 	if (FT_Load_Glyph(_face, slot, _loadFlags))
-		return false;
+		return nullptr;
 
 	if (FT_Render_Glyph(_face->glyph, _renderMode))
-		return false;
+		return nullptr;
 
 	if (_face->glyph->format != FT_GLYPH_FORMAT_BITMAP)
-		return false;
+		return nullptr;
 
-	glyph.xOffset = _face->glyph->bitmap_left;
-	glyph.yOffset = _ascent - _face->glyph->bitmap_top;
+	const int xOffset = _face->glyph->bitmap_left;
+	const int yOffset = _ascent - _face->glyph->bitmap_top;
 
-	glyph.advance = ftCeil26_6(_face->glyph->advance.x);
+	int advance = ftCeil26_6(_face->glyph->advance.x);
 
 	const FT_Bitmap *bitmap;
 #if FAKE_BOLD == 1
@@ -837,28 +1124,28 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	if (_fakeBold) {
 #if FAKE_BOLD >= 2
 		// Embolden by 1 pixel in x and 0 in y
-		glyph.advance += 1;
+		advance += 1;
 
 		if (FT_GlyphSlot_Own_Bitmap(_face->glyph))
-			return false;
+			return nullptr;
 
 		// That's 26.6 fixed-point units
 		if (FT_Bitmap_Embolden(_face->glyph->library, &_face->glyph->bitmap, 1 << 6, 0))
-			return false;
+			return nullptr;
 
 		bitmap = &_face->glyph->bitmap;
 #elif FAKE_BOLD >= 1
 		FT_Bitmap_New(&ownBitmap);
 
 		if (FT_Bitmap_Copy(_face->glyph->library, &_face->glyph->bitmap, &ownBitmap))
-			return false;
+			return nullptr;
 
 		// Embolden by 1 pixel in x and 0 in y
-		glyph.advance += 1;
+		advance += 1;
 
 		// That's 26.6 fixed-point units
 		if (FT_Bitmap_Embolden(_face->glyph->library, &ownBitmap, 1 << 6, 0))
-			return false;
+			return nullptr;
 
 		bitmap = &ownBitmap;
 #else
@@ -870,7 +1157,8 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	}
 
 
-	glyph.image.create(bitmap->width, bitmap->rows, PixelFormat::createFormatCLUT8());
+	Surface image;
+	image.create(bitmap->width, bitmap->rows, PixelFormat::createFormatCLUT8());
 
 	const uint8 *src = bitmap->buffer;
 	int srcPitch = bitmap->pitch;
@@ -879,7 +1167,7 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 		srcPitch = -srcPitch;
 	}
 
-	uint8 *dst = (uint8 *)glyph.image.getPixels();
+	uint8 *dst = (uint8 *)image.getPixels();
 
 	switch (bitmap->pixel_mode) {
 	case FT_PIXEL_MODE_MONO:
@@ -905,15 +1193,15 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	case FT_PIXEL_MODE_GRAY:
 		for (int y = 0; y < (int)bitmap->rows; ++y) {
 			memcpy(dst, src, bitmap->width);
-			dst += glyph.image.pitch;
+			dst += image.pitch;
 			src += srcPitch;
 		}
 		break;
 
 	default:
-		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
-		glyph.image.free();
-		return false;
+		warning("TTFFont::rasterizeGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
+		image.free();
+		return nullptr;
 	}
 
 #if FAKE_BOLD == 1
@@ -922,7 +1210,9 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	}
 #endif
 
-	return true;
+	const TTFGlyphAtlas::Glyph *glyph = _atlasFace->addGlyph(slot, image, xOffset, yOffset, advance);
+	image.free();
+	return glyph;
 }
 
 void TTFFont::assureCached(uint32 chr) const {
@@ -936,6 +1226,98 @@ void TTFFont::assureCached(uint32 chr) const {
 	}
 }
 
+const TextRun *TTFFont::getTextRun(const Common::String &str) const {
+	return getTextRunImpl(_textRuns, str);
+}
+
+const TextRun *TTFFont::getTextRun(const Common::U32String &str) const {
+	return getTextRunImpl(_u32TextRuns, str);
+}
+
+template<class StringType>
+const TextRun *TTFFont::getTextRunImpl(Common::HashMap<StringType, CachedTextRun> &cache, const StringType &str) const {
+	// Long texts are usually only drawn once or are word wrapped first
+	if (str.empty() || str.size() > kMaxTextRunLength)
+		return nullptr;
+
+	++_textRunUse;
+
+	typename Common::HashMap<StringType, CachedTextRun>::iterator entry = cache.find(str);
+	if (entry != cache.end()) {
+		entry->_value.lastUse = _textRunUse;
+		return &entry->_value;
+	}
+
+	if (cache.size() >= kMaxTextRuns) {
+		typename Common::HashMap<StringType, CachedTextRun>::iterator oldest = cache.begin();
+		for (entry = cache.begin(); entry != cache.end(); ++entry) {
+			if (entry->_value.lastUse < oldest->_value.lastUse)
+				oldest = entry;
+		}
+		cache.erase(oldest);
+	}
+
+	CachedTextRun &run = cache[str];
+	run.lastUse = _textRunUse;
+	run.charStorage.resize(str.size());
+	run.glyphs.resize(str.size());
+
+	int x = 0;
+	typename StringType::unsigned_type last = 0;
+	for (uint i = 0; i < str.size(); ++i) {
+		const typename StringType::unsigned_type cur = str[i];
+		x += getKerningOffset(last, cur);
+		last = cur;
+
+		run.charStorage[i].chr = cur;
+		run.charStorage[i].x = x;
+
+		// getCharWidth makes sure the glyph is cached
+		x += getCharWidth(cur);
+
+		GlyphCache::const_iterator glyphEntry = _glyphs.find(cur);
+		run.glyphs[i] = (glyphEntry != _glyphs.end()) ? &glyphEntry->_value : nullptr;
+	}
+
+	run.chars = run.charStorage.data();
+	run.size = run.charStorage.size();
+	run.width = x;
+	return &run;
+}
+
+bool TTFFont::drawTextRun(Surface *dst, const TextRun &run, int x, int y, int leftX, int rightX, uint32 color, bool alpha,
+                          bool allowCharClipping, const uint32 *transparentColor, Common::Rect *drawnBox) const {
+	const CachedTextRun &cachedRun = static_cast<const CachedTextRun &>(run);
+
+	for (uint i = 0; i < run.size; ++i) {
+		const Glyph *glyph = cachedRun.glyphs[i];
+		const int charX = x + run.chars[i].x;
+
+		// Characters without a glyph have an empty bounding box
+		Common::Rect charBox;
+		if (glyph)
+			charBox = Common::Rect(glyph->xOffset, glyph->yOffset, glyph->xOffset + glyph->image.w, glyph->yOffset + glyph->image.h);
+
+		if (!allowCharClipping && charX + charBox.right > rightX)
+			break;
+
+		if (!glyph || charX + charBox.right < leftX)
+			continue;
+
+		drawGlyphIntern(dst, *glyph, charX, y, color, transparentColor, alpha);
+
+		if (drawnBox && !charBox.isEmpty()) {
+			charBox.translate(charX, y);
+			if (drawnBox->isEmpty())
+				*drawnBox = charBox;
+			else
+				drawnBox->extend(charBox);
+		}
+	}
+
+	return true;
+}
+
 Font *loadTTFFont(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, int size, TTFSizeMode sizeMode, uint xdpi, uint ydpi, TTFRenderMode renderMode, const uint32 *mapping, bool stemDarkening) {
 	TTFFont *font = new TTFFont();
 
@@ -1156,6 +1538,7 @@ Font *findTTFace(const Common::Array<Common::Path> &files, const Common::U32Stri
 
 namespace Common {
 DECLARE_SINGLETON(Graphics::TTFLibrary);
+DECLARE_SINGLETON(Graphics::TTFGlyphAtlas);
 } // End of namespace Common
 
 #endif
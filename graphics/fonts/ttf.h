@@ -148,6 +148,23 @@ Font *loadTTFFontFromArchive(const Common::String &filename, int size, TTFSizeMo
  */
 Font *findTTFace(const Common::Array<Common::Path> &files, const Common::U32String &faceName, bool bold, bool italic, int size, uint xdpi = 0, uint ydpi = 0,TTFRenderMode renderMode = kTTFRenderModeLight, const uint32 *mapping = 0);
 
+/**
+ * Limit the memory used by the glyph atlas shared by all TTF fonts.
+ *
+ * Glyphs of faces no font uses anymore are kept in the atlas so that loading
+ * the same font again does not render them again. Once the atlas grows beyond
+ * the limit, such faces are discarded, least recently used first. Faces in
+ * use are never discarded, so the limit can be exceeded.
+ *
+ * @param bytes  The memory limit, in bytes.
+ */
+void setTTFGlyphAtlasLimit(uint32 bytes);
+
+/**
+ * Return the memory used by the glyph atlas shared by all TTF fonts, in bytes.
+ */
+uint32 getTTFGlyphAtlasSize();
+
 void shutdownTTF();
 
 } // End of namespace Graphics
@@ -168,6 +168,11 @@ MODULE_OBJS += \
 	tinygl/ztriangle.o \
 	tinygl/zblit.o \
 	tinygl/zdirtyrect.o
+
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	tinygl/zblit-sse2.o
+endif
 endif
 
 ifdef USE_ASPECT
@@ -39,9 +39,11 @@
 namespace TinyGL {
 
 void GLContext::glopArrayElement(GLParam *param) {
+	gl_array_element(param[1].i, client_states);
+}
+
+void GLContext::gl_array_element(int idx, int states) {
 	int offset;
-	int states = client_states;
-	int idx = param[1].i;
 
 	if (states & COLOR_ARRAY) {
 		GLParam p[5];
@@ -238,43 +240,81 @@ void GLContext::glopArrayElement(GLParam *param) {
 }
 
 void GLContext::glopDrawArrays(GLParam *p) {
-	GLParam array_element[2];
 	GLParam begin[2];
 
 	begin[1].i = p[1].i;
 	glopBegin(begin);
 	for (int i = 0; i < p[3].i; i++) {
-		array_element[1].i = p[2].i + i;
-		glopArrayElement(array_element);
+		gl_array_element(p[2].i + i, client_states);
 	}
 	glopEnd(nullptr);
 }
 
+static inline int getElementIndex(const void *indices, int type, int i) {
+	switch (type) {
+	case TGL_UNSIGNED_BYTE:
+		return ((const TGLbyte *)indices)[i];
+	case TGL_UNSIGNED_SHORT:
+		return ((const TGLshort *)indices)[i];
+	case TGL_UNSIGNED_INT:
+		return ((const TGLint *)indices)[i];
+	default:
+		assert(0);
+		return 0;
+	}
+}
+
 void GLContext::glopDrawElements(GLParam *p) {
-	GLParam array_element[2];
-	void *indices;
 	GLParam begin[2];
+	const void *indices = p[4].p;
+	int count = p[2].i;
+	int type = p[3].i;
 
-	indices = (char *)p[4].p;
-	begin[1].i = p[1].i;
+	// Indexed meshes share most of their vertices between primitives. A vertex only
+	// depends on its array element and on state that does not change inside a draw
+	// call, so each element is transformed and lit once and then copied.
+	int maxIndex = -1;
+	if (client_states & VERTEX_ARRAY) {
+		for (int i = 0; i < count; i++) {
+			int idx = getElementIndex(indices, type, i);
+			if (idx < 0 || idx >= VERTEX_CACHE_MAX_SIZE) {
+				maxIndex = -1;
+				break;
+			}
+			maxIndex = MAX(maxIndex, idx);
+		}
+	}
 
+	if (maxIndex >= vertex_cache_size) {
+		vertex_cache_size = maxIndex + 1;
+		vertex_cache = (int *)gl_realloc(vertex_cache, vertex_cache_size * sizeof(int));
+		if (!vertex_cache) {
+			error("unable to allocate vertex cache.");
+		}
+	}
+	for (int i = 0; i <= maxIndex; i++) {
+		vertex_cache[i] = -1;
+	}
+
+	begin[1].i = p[1].i;
 	glopBegin(begin);
-	for (int i = 0; i < p[2].i; i++) {
-		switch (p[3].i) {
-		case TGL_UNSIGNED_BYTE:
-			array_element[1].i = ((TGLbyte *)indices)[i];
-			break;
-		case TGL_UNSIGNED_SHORT:
-			array_element[1].i = ((TGLshort *)indices)[i];
-			break;
-		case TGL_UNSIGNED_INT:
-			array_element[1].i = ((TGLint *)indices)[i];
-			break;
-		default:
-			assert(0);
-			break;
+	int lastCached = -1;
+	for (int i = 0; i < count; i++) {
+		int idx = getElementIndex(indices, type, i);
+		if (maxIndex < 0) {
+			gl_array_element(idx, client_states);
+		} else if (vertex_cache[idx] < 0) {
+			gl_array_element(idx, client_states);
+			vertex_cache[idx] = vertex_n - 1;
+			lastCached = -1;
+		} else {
+			gl_copy_vertex(vertex_cache[idx]);
+			lastCached = idx;
 		}
-		glopArrayElement(array_element);
+	}
+	// Leave the current color, normal and texture coordinates as if the last element was sent
+	if (lastCached >= 0) {
+		gl_array_element(lastCached, client_states & ~VERTEX_ARRAY);
 	}
 	glopEnd(nullptr);
 }
@@ -317,21 +357,21 @@ void GLContext::gl_ColorPointer(GLParam *p) {
 	switch (color_array_type) {
 	case TGL_BYTE:
 	case TGL_UNSIGNED_BYTE:
-		color_array_stride = p[3].i != 0 ? p[3].i : color_array_stride * sizeof(TGLbyte);
+		color_array_stride = p[3].i != 0 ? p[3].i : color_array_size * sizeof(TGLbyte);
 		break;
 	case TGL_SHORT:
 	case TGL_UNSIGNED_SHORT:
-		color_array_stride = p[3].i != 0 ? p[3].i : color_array_stride * sizeof(TGLshort);
+		color_array_stride = p[3].i != 0 ? p[3].i : color_array_size * sizeof(TGLshort);
 		break;
 	case TGL_INT:
 	case TGL_UNSIGNED_INT:
-		color_array_stride = p[3].i != 0 ? p[3].i : color_array_stride * sizeof(TGLint);
+		color_array_stride = p[3].i != 0 ? p[3].i : color_array_size * sizeof(TGLint);
 		break;
 	case TGL_FLOAT:
-		color_array_stride = p[3].i != 0 ? p[3].i : color_array_stride * sizeof(TGLfloat);
+		color_array_stride = p[3].i != 0 ? p[3].i : color_array_size * sizeof(TGLfloat);
 		break;
 	case TGL_DOUBLE:
-		color_array_stride = p[3].i != 0 ? p[3].i : color_array_stride * sizeof(TGLdouble);
+		color_array_stride = p[3].i != 0 ? p[3].i : color_array_size * sizeof(TGLdouble);
 		break;
 	default:
 		assert(0);
@@ -166,6 +166,8 @@ void GLContext::init(int screenW, int screenH, Graphics::PixelFormat pixelFormat
 	// allocate GLVertex array
 	vertex_max = POLYGON_MAX_VERTEX;
 	vertex = (GLVertex *)gl_malloc(POLYGON_MAX_VERTEX * sizeof(GLVertex));
+	vertex_cache = nullptr;
+	vertex_cache_size = 0;
 
 	// viewport
 	v = &viewport;
@@ -237,7 +239,9 @@ void GLContext::init(int screenW, int screenH, Graphics::PixelFormat pixelFormat
 	current_texture = default_texture = alloc_texture(0);
 	maxTextureName = 0;
 	texture_mag_filter = TGL_LINEAR;
-	texture_min_filter = TGL_NEAREST_MIPMAP_LINEAR;
+	// OpenGL defaults to TGL_NEAREST_MIPMAP_LINEAR, which TinyGL rendered as
+	// TGL_NEAREST before it had mipmaps: only build them when asked for
+	texture_min_filter = TGL_NEAREST;
 	colorAssociationList.push_back({Graphics::PixelFormat::createFormatRGBA32(),        TGL_RGBA, TGL_UNSIGNED_BYTE});
 	colorAssociationList.push_back({Graphics::PixelFormat::createFormatRGB24(),         TGL_RGB,  TGL_UNSIGNED_BYTE});
 	colorAssociationList.push_back({Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),  TGL_RGB,  TGL_UNSIGNED_SHORT_5_6_5});
@@ -371,6 +375,7 @@ void GLContext::deinit() {
 	free_texture(default_texture);
 	endSharedState();
 	gl_free(vertex);
+	gl_free(vertex_cache);
 	delete fb;
 }
 
@@ -25,6 +25,7 @@
  * It also has modifications by the ResidualVM-team, which are covered under the GPLv2 (or later).
  */
 
+#include "common/hashmap.h"
 #include "common/streamdebug.h"
 
 #include "graphics/tinygl/zgl.h"
@@ -52,6 +53,14 @@ static const int op_table_size[] = {
 #include "graphics/tinygl/opinfo.h"
 };
 
+static void free_op_buffers(GLParamBuffer *pb) {
+	while (pb) {
+		GLParamBuffer *pb1 = pb->next;
+		gl_free(pb);
+		pb = pb1;
+	}
+}
+
 GLList *GLContext::find_list(uint list) {
 	return shared_state.lists[list];
 }
@@ -61,12 +70,7 @@ void GLContext::delete_list(int list) {
 	assert(l);
 
 	// free param buffer
-	GLParamBuffer *pb = l->first_op_buffer;
-	while (pb) {
-		GLParamBuffer *pb1 = pb->next;
-		gl_free(pb);
-		pb = pb1;
-	}
+	free_op_buffers(l->first_op_buffer);
 
 	gl_free(l);
 	shared_state.lists[list] = nullptr;
@@ -185,6 +189,148 @@ void GLContext::glopCallList(GLParam *p) {
 	}
 }
 
+// Returns the number of vertices of each primitive for the modes whose
+// consecutive glBegin/glEnd blocks can be joined, or 0 for the others
+static int get_mergeable_primitive_size(int type) {
+	switch (type) {
+	case TGL_POINTS:
+		return 1;
+	case TGL_LINES:
+		return 2;
+	case TGL_TRIANGLES:
+		return 3;
+	case TGL_QUADS:
+		return 4;
+	default:
+		return 0;
+	}
+}
+
+// Returns a key identifying the state set by an op, or 0 if the op does not
+// only set some state which can be compared with its parameters
+static uint32 get_state_key(const GLParam *p) {
+	int op = p[0].op;
+	switch (op) {
+	case OP_EnableDisable:
+	case OP_Hint:
+		return ((op + 1) << 16) | (p[1].ui & 0xffff);
+	case OP_MatrixMode:
+	case OP_BindTexture:
+	case OP_ShadeModel:
+	case OP_CullFace:
+	case OP_FrontFace:
+	case OP_PolygonMode:
+	case OP_ColorMask:
+	case OP_DepthMask:
+	case OP_StencilMask:
+	case OP_BlendFunc:
+	case OP_AlphaFunc:
+	case OP_DepthFunc:
+	case OP_StencilFunc:
+	case OP_StencilOp:
+	case OP_ColorMaterial:
+	case OP_PolygonOffset:
+		return (op + 1) << 16;
+	default:
+		return 0;
+	}
+}
+
+static bool same_params(const GLParam *p1, const GLParam *p2) {
+	for (int i = 1; i < op_table_size[p1[0].op]; i++) {
+		if (p1[i].ui != p2[i].ui)
+			return false;
+	}
+	return true;
+}
+
+// Rewrites a compiled list, so that replaying it skips state changes which
+// set the value already set earlier in the list and joins consecutive
+// glBegin/glEnd blocks of the same primitives into a single draw call
+void GLContext::optimize_list(GLList *l) {
+	Common::HashMap<uint32, GLParam *> states;
+	GLParamBuffer *old_buffer = l->first_op_buffer;
+	GLParam *p = old_buffer->ops;
+	GLParam *pending_end = nullptr;
+	int begin_size = 0, begin_vertex_cnt = 0;
+
+	GLParamBuffer *ob = (GLParamBuffer *)gl_zalloc(sizeof(GLParamBuffer));
+	ob->next = nullptr;
+	l->first_op_buffer = ob;
+	current_op_buffer = ob;
+	current_op_buffer_index = 0;
+
+	while (1) {
+		int op = p[0].op;
+		if (op == OP_EndList)
+			break;
+		if (op == OP_NextBuffer) {
+			p = (GLParam *)p[1].p;
+			continue;
+		}
+
+		uint32 key = get_state_key(p);
+		if (key != 0) {
+			if (states.contains(key) && same_params(states[key], p)) {
+				p += op_table_size[op];
+				continue;
+			}
+			states[key] = p;
+		}
+
+		bool keep_pending_end = false;
+		switch (op) {
+		case OP_Color:
+		case OP_TexCoord:
+		case OP_Normal:
+		case OP_EdgeFlag:
+			// These only set the current vertex attributes, which is the
+			// same inside and outside of glBegin/glEnd
+			keep_pending_end = true;
+			break;
+		case OP_Vertex:
+			begin_vertex_cnt++;
+			break;
+		case OP_Begin:
+			if (pending_end && begin_size == get_mergeable_primitive_size(p[1].i)) {
+				pending_end = nullptr;
+				p += op_table_size[op];
+				continue;
+			}
+			begin_size = get_mergeable_primitive_size(p[1].i);
+			begin_vertex_cnt = 0;
+			break;
+		case OP_End:
+			if (begin_size != 0 && begin_vertex_cnt % begin_size == 0) {
+				pending_end = p;
+				p += op_table_size[op];
+				continue;
+			}
+			break;
+		default:
+			// The number of vertices sent by glArrayElement is not known here
+			begin_size = 0;
+			if (op == OP_CallList)
+				states.clear();
+			break;
+		}
+
+		if (pending_end && !keep_pending_end) {
+			gl_compile_op(pending_end);
+			pending_end = nullptr;
+		}
+
+		gl_compile_op(p);
+		p += op_table_size[op];
+	}
+
+	if (pending_end)
+		gl_compile_op(pending_end);
+	gl_compile_op(p);
+
+	free_op_buffers(old_buffer);
+}
+
 void GLContext::gl_NewList(TGLuint list, TGLenum mode) {
 	assert(mode == TGL_COMPILE || mode == TGL_COMPILE_AND_EXECUTE);
 	assert(compile_flag == 0);
@@ -194,6 +340,7 @@ void GLContext::gl_NewList(TGLuint list, TGLenum mode) {
 		delete_list(list);
 	l = alloc_list(list);
 
+	current_list = l;
 	current_op_buffer = l->first_op_buffer;
 	current_op_buffer_index = 0;
 
@@ -210,6 +357,9 @@ void GLContext::gl_EndList() {
 	p[0].op = OP_EndList;
 	gl_compile_op(p);
 
+	optimize_list(current_list);
+	current_list = nullptr;
+
 	compile_flag = 0;
 	exec_flag = 1;
 }
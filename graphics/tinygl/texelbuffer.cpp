@@ -38,11 +38,85 @@ TexelBuffer::TexelBuffer(uint width, uint height, uint textureSize, int internal
 
 	_width = width;
 	_height = height;
+	_textureSize = textureSize;
 	_fracTextureUnit = textureSize << ZB_POINT_ST_FRAC_BITS;
 	_fracTextureMask = _fracTextureUnit - 1;
 	_widthRatio = (float) width / textureSize;
 	_heightRatio = (float) height / textureSize;
 	_internalformat = internalformat;
+	_mipmapMode = kMipmapNone;
+	_mipmap = nullptr;
+}
+
+void TexelBuffer::setMipmapMode(MipmapMode mode) {
+	if (mode == _mipmapMode)
+		return;
+	_mipmapMode = mode;
+	delete _mipmap;
+	_mipmap = nullptr;
+}
+
+// Attaches the smaller levels of the texture to this base level, each one an
+// RGBA copy of the previous level halved with a 2x2 box filter
+void TexelBuffer::buildMipmaps() const {
+	const Graphics::PixelFormat pf = Graphics::PixelFormat::createFormatRGBA32();
+	uint width = _width;
+	uint height = _height;
+	uint32 *src = (uint32 *)gl_malloc(width * height * 4);
+	for (uint y = 0; y < height; y++) {
+		for (uint x = 0; x < width; x++) {
+			uint8 a, r, g, b;
+			getTexel(x, y, a, r, g, b);
+			src[y * width + x] = pf.ARGBToColor(a, r, g, b);
+		}
+	}
+
+	const TexelBuffer *parent = this;
+	while (width > 1 || height > 1) {
+		const uint levelWidth = MAX<uint>(width / 2, 1);
+		const uint levelHeight = MAX<uint>(height / 2, 1);
+		const byte *srcBytes = (const byte *)src;
+		uint32 *dst = (uint32 *)gl_malloc(levelWidth * levelHeight * 4);
+		byte *out = (byte *)dst;
+		for (uint y = 0; y < levelHeight; y++) {
+			const byte *row0 = srcBytes + MIN(y * 2, height - 1) * width * 4;
+			const byte *row1 = srcBytes + MIN(y * 2 + 1, height - 1) * width * 4;
+			for (uint x = 0; x < levelWidth; x++) {
+				const uint x0 = MIN(x * 2, width - 1) * 4;
+				const uint x1 = MIN(x * 2 + 1, width - 1) * 4;
+				for (int c = 0; c < 4; c++)
+					*out++ = (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) >> 2;
+			}
+		}
+
+		TexelBuffer *level;
+		if (_mipmapMode == kMipmapBilinear)
+			level = createBilinearTexelBuffer((byte *)dst, pf, TGL_RGBA, TGL_UNSIGNED_BYTE, levelWidth, levelHeight, _textureSize, _internalformat);
+		else
+			level = createNearestTexelBuffer((byte *)dst, pf, TGL_RGBA, TGL_UNSIGNED_BYTE, levelWidth, levelHeight, _textureSize, _internalformat);
+		parent->_mipmap = level;
+		parent = level;
+
+		gl_free(src);
+		src = dst;
+		width = levelWidth;
+		height = levelHeight;
+	}
+	gl_free(src);
+}
+
+const TexelBuffer *TexelBuffer::getMipmap(int dsdx, int dtdx, int dsdy, int dtdy) const {
+	const float ds = MAX(ABS(dsdx), ABS(dsdy)) / (float)ZB_POINT_ST_UNIT;
+	const float dt = MAX(ABS(dtdx), ABS(dtdy)) / (float)ZB_POINT_ST_UNIT;
+
+	// Use the nearest level: switch once a pixel covers at least sqrt(2) texels
+	const TexelBuffer *level = this;
+	if (!_mipmap && _mipmapMode != kMipmapNone && MAX(ds * _widthRatio, dt * _heightRatio) >= 1.4142135f)
+		buildMipmaps();
+	while (level->_mipmap && MAX(ds * level->_widthRatio, dt * level->_heightRatio) >= 1.4142135f) {
+		level = level->_mipmap;
+	}
+	return level;
 }
 
 static inline uint wrap(uint wrap_mode, int coord, uint _fracTextureUnit, uint _fracTextureMask) {
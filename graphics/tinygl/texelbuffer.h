@@ -29,9 +29,31 @@ namespace TinyGL {
 class TexelBuffer {
 public:
 	TexelBuffer(uint width, uint height, uint textureSize, int internalformat);
-	virtual ~TexelBuffer() {};
+	virtual ~TexelBuffer() { delete _mipmap; };
 
 	inline int internalformat() const { return _internalformat; }
+	inline uint width() const { return _width; }
+	inline uint height() const { return _height; }
+
+	// The unfiltered color of a texel of this level
+	void getTexel(uint x, uint y, uint8 &a, uint8 &r, uint8 &g, uint8 &b) const {
+		getARGBAt(x + y * _width, 0, 0, a, r, g, b);
+	}
+
+	enum MipmapMode {
+		kMipmapNone,
+		kMipmapNearest,
+		kMipmapBilinear
+	};
+
+	// Whether the texture is minified through its smaller levels, and how they
+	// are filtered. The levels are only built once a triangle is minified, so
+	// textures re-uploaded every frame do not pay for them until they are used.
+	void setMipmapMode(MipmapMode mode);
+	inline bool hasMipmaps() const { return _mipmapMode != kMipmapNone; }
+	inline bool hasBuiltMipmaps() const { return _mipmap != nullptr; }
+	// Selects the level with about one texel per pixel for the given texture coordinate derivatives
+	const TexelBuffer *getMipmap(int dsdx, int dtdx, int dsdy, int dtdy) const;
 
 	void getARGBAt(
 		uint wrap_s, uint wrap_t,
@@ -45,9 +67,13 @@ protected:
 		uint ds, uint dt,
 		uint8 &a, uint8 &r, uint8 &g, uint8 &b
 	) const = 0;
-	uint _width, _height, _fracTextureUnit, _fracTextureMask;
+	void buildMipmaps() const;
+	uint _width, _height, _textureSize, _fracTextureUnit, _fracTextureMask;
 	float _widthRatio, _heightRatio;
 	int _internalformat;
+	MipmapMode _mipmapMode;
+	// The next smaller level of the texture, which this buffer owns; built on first use
+	mutable TexelBuffer *_mipmap;
 };
 
 TexelBuffer *createNearestTexelBuffer(const byte *buf, const Graphics::PixelFormat &pf, uint format, uint type, uint width, uint height, uint textureSize, int internalformat);
@@ -106,6 +106,24 @@ void GLContext::glopBindTexture(GLParam *p) {
 	current_texture = t;
 }
 
+// Sets how an uploaded texture uses its smaller levels for its minification filter.
+// Only the *_MIPMAP_* filters use them; the base level is not touched.
+static void updateMipmaps(GLImage *im, int minFilter) {
+	switch (minFilter) {
+	case TGL_NEAREST_MIPMAP_NEAREST:
+	case TGL_NEAREST_MIPMAP_LINEAR:
+		im->pixmap->setMipmapMode(TexelBuffer::kMipmapNearest);
+		break;
+	case TGL_LINEAR_MIPMAP_NEAREST:
+	case TGL_LINEAR_MIPMAP_LINEAR:
+		im->pixmap->setMipmapMode(TexelBuffer::kMipmapBilinear);
+		break;
+	default:
+		im->pixmap->setMipmapMode(TexelBuffer::kMipmapNone);
+		break;
+	}
+}
+
 void GLContext::glopTexImage2D(GLParam *p) {
 	int target = p[1].i;
 	int level = p[2].i;
@@ -179,6 +197,12 @@ void GLContext::glopTexImage2D(GLParam *p) {
 			);
 			break;
 		}
+
+		// The smaller levels are generated from the base level the first time the
+		// texture is minified, and selected per pixel span while rasterizing, so
+		// that minified textures do not alias
+		if (level == 0)
+			updateMipmaps(im, texture_min_filter);
 	}
 }
 
@@ -322,6 +346,15 @@ error:
 		default:
 			goto error;
 		}
+		// Whether the bound texture is linearly filtered is still decided by
+		// its upload, but its smaller levels follow the new filter
+		if (current_texture->images[0].pixmap)
+			updateMipmaps(&current_texture->images[0], param);
+		break;
+	case TGL_TEXTURE_MAX_LEVEL:
+		// Only a maximum level of 0, which turns the mipmaps off, is supported
+		if (param == 0 && current_texture->images[0].pixmap)
+			updateMipmaps(&current_texture->images[0], TGL_NEAREST);
 		break;
 	default:
 		;
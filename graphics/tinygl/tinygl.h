@@ -39,6 +39,12 @@ void destroyContext(ContextHandle *handle);
 void setContext(ContextHandle *handle);
 void presentBuffer();
 void presentBuffer(Common::List<Common::Rect> &dirtyAreas);
+// The most memory used by the draw calls of a frame, to tune drawCallMemorySize
+uint32 getDrawCallMemoryHighWaterMark();
+// The number of draw calls queued since the last presentBuffer
+uint32 getQueuedDrawCallCount();
+// The number of triangles the last presentBuffer skipped as hidden by the z buffer
+uint32 getOccludedTriangleCount();
 void getSurfaceRef(Graphics::Surface &surface);
 Graphics::Surface *copyFromFrameBuffer(const Graphics::PixelFormat &dstFormat);
 
@@ -194,27 +194,41 @@ void GLContext::gl_vertex_transform(GLVertex *v) {
 	v->clip_code = gl_clipcode(v->pc.X, v->pc.Y, v->pc.Z, v->pc.W);
 }
 
+void GLContext::gl_reserve_vertex() {
+	// quick fix to avoid crashes on large polygons
+	if (vertex_n >= vertex_max) {
+		GLVertex *newarray;
+		vertex_max <<= 1;    // just double size
+		newarray = (GLVertex *)gl_realloc(vertex, sizeof(GLVertex) * vertex_max);
+		if (!newarray) {
+			error("unable to allocate GLVertex array.");
+		}
+		vertex = newarray;
+	}
+}
+
+void GLContext::gl_copy_vertex(int index) {
+	assert(in_begin != 0);
+
+	gl_reserve_vertex();
+	vertex[vertex_n] = vertex[index];
+	vertex_n++;
+	vertex_cnt++;
+}
+
 void GLContext::glopVertex(GLParam *p) {
 	GLVertex *v;
 	int n, cnt;
 
 	assert(in_begin != 0);
 
+	gl_reserve_vertex();
+
 	n = vertex_n;
 	cnt = vertex_cnt;
 	cnt++;
 	vertex_cnt = cnt;
 
-	// quick fix to avoid crashes on large polygons
-	if (n >= vertex_max) {
-		GLVertex *newarray;
-		vertex_max <<= 1;    // just double size
-		newarray = (GLVertex *)gl_realloc(vertex, sizeof(GLVertex) * vertex_max);
-		if (!newarray) {
-			error("unable to allocate GLVertex array.");
-		}
-		vertex = newarray;
-	}
 	// new vertex entry
 	v = &vertex[n];
 	n++;
@@ -257,7 +271,13 @@ void GLContext::glopVertex(GLParam *p) {
 void GLContext::glopEnd(GLParam *) {
 	assert(in_begin == 1);
 
-	if (vertex_cnt > 0) {
+	// Primitives whose vertices are all outside of the same clip plane draw nothing
+	int clip_code = vertex_cnt > 0 ? 0x3f : 0;
+	for (int i = 0; i < vertex_cnt && clip_code; i++) {
+		clip_code &= vertex[i].clip_code;
+	}
+
+	if (vertex_cnt > 0 && !clip_code) {
 		issueDrawCall(new RasterizationDrawCall());
 	}
 
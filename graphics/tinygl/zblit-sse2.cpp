@@ -0,0 +1,127 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/tinygl/zbuffer.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace TinyGL {
+
+static FORCEINLINE __m128i getChannel(__m128i pixels, int shift) {
+	return _mm_and_si128(_mm_srl_epi32(pixels, _mm_cvtsi32_si128(shift)), _mm_set1_epi32(0xFF));
+}
+
+// Matches the conversion of the tinted channel to a byte in FrameBuffer::writePixel
+static FORCEINLINE __m128i tintChannel(__m128i channel, __m128 tint) {
+	return _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(channel), tint)), _mm_set1_epi32(0xFF));
+}
+
+static FORCEINLINE __m128i setChannel(__m128i channel, int shift) {
+	return _mm_sll_epi32(channel, _mm_cvtsi32_si128(shift));
+}
+
+int writePixelRowSSE2(uint32 *dst, const uint32 *src, int count, const Graphics::PixelFormat &dstFormat,
+                      const Graphics::PixelFormat &srcFormat, bool blend, float aTint, float rTint, float gTint, float bTint,
+                      bool copyOpaque) {
+	const __m128i mask = _mm_set1_epi32(0xFF);
+	const __m128 aTints = _mm_set1_ps(aTint);
+	const __m128 rTints = _mm_set1_ps(rTint);
+	const __m128 gTints = _mm_set1_ps(gTint);
+	const __m128 bTints = _mm_set1_ps(bTint);
+
+	// Blending always writes an opaque pixel, like RGBToColor
+	const __m128i dstAlpha = _mm_set1_epi32(dstFormat.aBits() == 0 ? 0 : 0xFF << dstFormat.aShift);
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128i srcPixels = _mm_loadu_si128((const __m128i *)(src + i));
+		__m128i a = srcFormat.aBits() == 0 ? mask : getChannel(srcPixels, srcFormat.aShift);
+		__m128i r = getChannel(srcPixels, srcFormat.rShift);
+		__m128i g = getChannel(srcPixels, srcFormat.gShift);
+		__m128i b = getChannel(srcPixels, srcFormat.bShift);
+
+		a = tintChannel(a, aTints);
+		r = tintChannel(r, rTints);
+		g = tintChannel(g, gTints);
+		b = tintChannel(b, bTints);
+
+		__m128i result;
+		if (blend) {
+			// The channels and factors are below 256, so their 16 bits products are exact.
+			// The sum of the two products can not overflow either.
+			__m128i dstPixels = _mm_loadu_si128((const __m128i *)(dst + i));
+			__m128i invA = _mm_sub_epi32(mask, a);
+			__m128i rBlend = _mm_add_epi32(_mm_srli_epi32(_mm_mullo_epi16(r, a), 8),
+			                               _mm_srli_epi32(_mm_mullo_epi16(getChannel(dstPixels, dstFormat.rShift), invA), 8));
+			__m128i gBlend = _mm_add_epi32(_mm_srli_epi32(_mm_mullo_epi16(g, a), 8),
+			                               _mm_srli_epi32(_mm_mullo_epi16(getChannel(dstPixels, dstFormat.gShift), invA), 8));
+			__m128i bBlend = _mm_add_epi32(_mm_srli_epi32(_mm_mullo_epi16(b, a), 8),
+			                               _mm_srli_epi32(_mm_mullo_epi16(getChannel(dstPixels, dstFormat.bShift), invA), 8));
+			if (copyOpaque) {
+				// Keep the channels of the opaque pixels as they are
+				__m128i opaque = _mm_cmpeq_epi32(a, mask);
+				r = _mm_or_si128(_mm_and_si128(opaque, r), _mm_andnot_si128(opaque, rBlend));
+				g = _mm_or_si128(_mm_and_si128(opaque, g), _mm_andnot_si128(opaque, gBlend));
+				b = _mm_or_si128(_mm_and_si128(opaque, b), _mm_andnot_si128(opaque, bBlend));
+			} else {
+				r = rBlend;
+				g = gBlend;
+				b = bBlend;
+			}
+			result = dstAlpha;
+		} else if (dstFormat.aBits() != 0) {
+			result = setChannel(a, dstFormat.aShift);
+		} else {
+			result = _mm_setzero_si128();
+		}
+
+		result = _mm_or_si128(result, setChannel(r, dstFormat.rShift));
+		result = _mm_or_si128(result, setChannel(g, dstFormat.gShift));
+		result = _mm_or_si128(result, setChannel(b, dstFormat.bShift));
+		_mm_storeu_si128((__m128i *)(dst + i), result);
+	}
+	return i;
+}
+
+} // end of namespace TinyGL
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
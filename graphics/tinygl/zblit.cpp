@@ -240,6 +240,7 @@ public:
 			dstBuf.shiftBy(fbWidth);
 			srcBuf.shiftBy(_surface.w);
 		}
+		c->fb->invalidateDepthTiles(dstX, dstY, dstX + clampWidth - 1, dstY + clampHeight - 1);
 	}
 
 	void tglBlitOpaque(int dstX, int dstY, int srcX, int srcY, int srcWidth, int srcHeight);
@@ -403,11 +404,8 @@ void BlitImage::tglBlitRLE(int dstX, int dstY, int srcX, int srcY, int srcWidth,
 				memcpy(dstBuf.getRawBuffer(y * fbWidth),
 					srcBuf.getRawBuffer(y * _surface.w), clampWidth * kBytesPerPixel);
 			} else {
-				for(int x = 0; x < clampWidth; x++) {
-					byte aDst, rDst, gDst, bDst;
-					srcBuf.getARGBAt(y * _surface.w + x, aDst, rDst, gDst, bDst);
-					c->fb->writePixel((dstX + x) + (dstY + y) * fbWidth, aDst * aTint, rDst * rTint, gDst * gTint, bDst * bTint);
-				}
+				c->fb->writePixelRow(dstX + (dstY + y) * fbWidth, srcBuf.getRawBuffer(y * _surface.w),
+					_surface.format, clampWidth, aTint, rTint, gTint, bTint);
 			}
 		}
 	} else if (_binaryTransparent || (kDisableBlending || !kEnableAlphaBlending)) { // If bitmap is binary transparent or if  we need complex forms of blending (not just alpha) we need to use writePixel, which is slower
@@ -424,11 +422,8 @@ void BlitImage::tglBlitRLE(int dstX, int dstY, int srcX, int srcY, int srcWidth,
 					memcpy(dstBuf.getRawBuffer((l._y - srcY) * fbWidth + xStart),
 						l._pixels + skipStart * kBytesPerPixel, length * kBytesPerPixel);
 				} else {
-					for(int x = xStart; x < xStart + length; x++) {
-						byte aDst, rDst, gDst, bDst;
-						srcBuf.getARGBAt((l._y - srcY) * _surface.w + x, aDst, rDst, gDst, bDst);
-						c->fb->writePixel((dstX + x) + (dstY + (l._y - srcY)) * fbWidth, aDst * aTint, rDst * rTint, gDst * gTint, bDst * bTint);
-					}
+					c->fb->writePixelRow((dstX + xStart) + (dstY + (l._y - srcY)) * fbWidth, srcBuf.getRawBuffer((l._y - srcY) * _surface.w + xStart),
+						_surface.format, length, aTint, rTint, gTint, bTint);
 				}
 			}
 			lineIndex++;
@@ -446,20 +441,13 @@ void BlitImage::tglBlitRLE(int dstX, int dstY, int srcX, int srcY, int srcWidth,
 				if (kDisableColoring && (kEnableAlphaBlending == false || kDisableBlending)) {
 					memcpy(dstBuf.getRawBuffer((l._y - srcY) * fbWidth + xStart),
 						l._pixels + skipStart * kBytesPerPixel, length * kBytesPerPixel);
+				} else if (kDisableColoring) {
+					// Opaque pixels are copied, the others blended
+					c->fb->writePixelRow((dstX + xStart) + (dstY + (l._y - srcY)) * fbWidth, srcBuf.getRawBuffer((l._y - srcY) * _surface.w + xStart),
+						_surface.format, length, 1.0f, 1.0f, 1.0f, 1.0f, true);
 				} else {
-					for(int x = xStart; x < xStart + length; x++) {
-						byte aDst, rDst, gDst, bDst;
-						srcBuf.getARGBAt((l._y - srcY) * _surface.w + x, aDst, rDst, gDst, bDst);
-						if (kDisableColoring) {
-							if (aDst != 0xFF) {
-								c->fb->writePixel((dstX + x) + (dstY + (l._y - srcY)) * fbWidth, aDst, rDst, gDst, bDst);
-							} else {
-								dstBuf.setPixelAt(x + (l._y - srcY) * fbWidth, aDst, rDst, gDst, bDst);
-							}
-						} else {
-							c->fb->writePixel((dstX + x) + (dstY + (l._y - srcY)) * fbWidth, aDst * aTint, rDst * rTint, gDst * gTint, bDst * bTint);
-						}
-					}
+					c->fb->writePixelRow((dstX + xStart) + (dstY + (l._y - srcY)) * fbWidth, srcBuf.getRawBuffer((l._y - srcY) * _surface.w + xStart),
+						_surface.format, length, aTint, rTint, gTint, bTint);
 				}
 			}
 			lineIndex++;
@@ -537,24 +525,47 @@ void BlitImage::tglBlitScale(int dstX, int dstY, int width, int height, int srcX
 	Graphics::PixelBuffer dstBuf(c->fb->getPixelFormat(), c->fb->getPixelBuffer());
 	int fbWidth = c->fb->getPixelBufferWidth();
 
+	if (clampWidth <= 0 || clampHeight <= 0)
+		return;
+
+	// The source column of a pixel is (xSource * srcWidth) / width. Instead of dividing
+	// for every pixel, the quotient and remainder are stepped from one column to the next.
+	int xStep = srcWidth / width;
+	int xStepRemainder = srcWidth % width;
+	int xSourceStart = kFlipHorizontal ? clampWidth - 1 : 0;
+
 	for (int y = 0; y < clampHeight; y++) {
+		int ySource;
+		if (kFlipVertical) {
+			ySource = clampHeight - y - 1;
+		} else {
+			ySource = y;
+		}
+
+		int srcLine = ((ySource * srcHeight) / height) * _surface.w;
+		int xColumn = (xSourceStart * srcWidth) / width;
+		int xRemainder = (xSourceStart * srcWidth) % width;
+
 		for (int x = 0; x < clampWidth; ++x) {
 			byte aDst, rDst, gDst, bDst;
-			int xSource, ySource;
-			if (kFlipVertical) {
-				ySource = clampHeight - y - 1;
-			} else {
-				ySource = y;
-			}
+			srcBuf.getARGBAt(srcLine + xColumn, aDst, rDst, gDst, bDst);
 
 			if (kFlipHorizontal) {
-				xSource = clampWidth - x - 1;
+				xColumn -= xStep;
+				xRemainder -= xStepRemainder;
+				if (xRemainder < 0) {
+					xRemainder += width;
+					xColumn--;
+				}
 			} else {
-				xSource = x;
+				xColumn += xStep;
+				xRemainder += xStepRemainder;
+				if (xRemainder >= width) {
+					xRemainder -= width;
+					xColumn++;
+				}
 			}
 
-			srcBuf.getARGBAt(((ySource * srcHeight) / height) * _surface.w + ((xSource * srcWidth) / width), aDst, rDst, gDst, bDst);
-
 			if (kDisableColoring) {
 				if (kDisableBlending && aDst != 0) {
 					dstBuf.setPixelAt((dstX + x) + (dstY + y) * fbWidth, aDst, rDst, gDst, bDst);
@@ -30,9 +30,11 @@
 #include "common/scummsys.h"
 #include "common/endian.h"
 #include "common/memory.h"
+#include "common/system.h"
 
 #include "graphics/tinygl/zbuffer.h"
 #include "graphics/tinygl/zgl.h"
+#include "graphics/tinygl/pixelbuffer.h"
 
 namespace TinyGL {
 
@@ -53,9 +55,23 @@ FrameBuffer::FrameBuffer(int width, int height, const Graphics::PixelFormat &for
 	_offscreenBuffer.pbuf = _pbuf;
 	_offscreenBuffer.zbuf = _zbuf;
 
+	_depthTilesWidth = (_pbufWidth + (1 << ZB_DEPTH_TILE_BITS) - 1) >> ZB_DEPTH_TILE_BITS;
+	_depthTilesHeight = (_pbufHeight + (1 << ZB_DEPTH_TILE_BITS) - 1) >> ZB_DEPTH_TILE_BITS;
+	_depthTileMin = (uint *)gl_zalloc(_depthTilesWidth * _depthTilesHeight * sizeof(uint));
+	_depthTileDirty = (byte *)gl_malloc(_depthTilesWidth * _depthTilesHeight);
+	memset(_depthTileDirty, 1, _depthTilesWidth * _depthTilesHeight);
+	_occludedTriangleCount = 0;
+
 	_currentTexture = nullptr;
 
 	_clippingEnabled = false;
+
+	// A context may be created without a backend, like in the unit tests
+#ifdef SCUMMVM_SSE2
+	_useSSE2 = g_system && g_system->hasFeature(OSystem::kFeatureCpuSSE2);
+#else
+	_useSSE2 = false;
+#endif
 }
 
 FrameBuffer::~FrameBuffer() {
@@ -63,6 +79,8 @@ FrameBuffer::~FrameBuffer() {
 	gl_free(_zbuf);
 	if (_sbuf)
 		gl_free(_sbuf);
+	gl_free(_depthTileMin);
+	gl_free(_depthTileDirty);
 }
 
 Buffer *FrameBuffer::genOffscreenBuffer() {
@@ -97,6 +115,8 @@ void FrameBuffer::clear(int clearZ, int z, int clearColor, int r, int g, int b,
 			// Cannot use memset, use a variant working on integers (possibly slower)
 			Common::memset32((uint32 *)_zbuf, z, _pbufWidth * _pbufHeight);
 		}
+		Common::memset32((uint32 *)_depthTileMin, z, _depthTilesWidth * _depthTilesHeight);
+		memset(_depthTileDirty, 0, _depthTilesWidth * _depthTilesHeight);
 	}
 	if (clearColor) {
 		byte *pp = _pbuf;
@@ -147,6 +167,7 @@ void FrameBuffer::clearRegion(int x, int y, int w, int h, bool clearZ, int z,
 				zbuf += _pbufWidth;
 			}
 		}
+		invalidateDepthTiles(x, y, x + w - 1, y + h - 1);
 	}
 	if (clearColor) {
 		int height = h;
@@ -246,6 +267,7 @@ void FrameBuffer::blitOffscreenBuffer(Buffer *buf) {
 		case 0x1: blitPixel(0x0, from_z, to_z, sizeof(int), from, to, pixel_bytes); // fall through
 		case 0x0: break;
 		}
+		invalidateDepthTiles(0, 0, _pbufWidth - 1, _pbufHeight - 1);
 	}
 #undef UNROLL_COUNT
 }
@@ -259,12 +281,105 @@ void FrameBuffer::selectOffscreenBuffer(Buffer *buf) {
 		_pbuf = _offscreenBuffer.pbuf;
 		_zbuf = _offscreenBuffer.zbuf;
 	}
+	invalidateDepthTiles(0, 0, _pbufWidth - 1, _pbufHeight - 1);
 }
 
 void FrameBuffer::clearOffscreenBuffer(Buffer *buf) {
 	memset(buf->pbuf, 0, _pbufHeight * _pbufPitch);
 	memset(buf->zbuf, 0, _pbufHeight * _pbufWidth * sizeof(uint));
 	buf->used = false;
+	if (buf->zbuf == _zbuf)
+		invalidateDepthTiles(0, 0, _pbufWidth - 1, _pbufHeight - 1);
+}
+
+void FrameBuffer::invalidateDepthTiles(int x1, int y1, int x2, int y2) {
+	x1 = MAX(x1, 0) >> ZB_DEPTH_TILE_BITS;
+	y1 = MAX(y1, 0) >> ZB_DEPTH_TILE_BITS;
+	x2 = MIN(x2, _pbufWidth - 1) >> ZB_DEPTH_TILE_BITS;
+	y2 = MIN(y2, _pbufHeight - 1) >> ZB_DEPTH_TILE_BITS;
+	if (x1 > x2)
+		return;
+	for (int y = y1; y <= y2; y++)
+		memset(_depthTileDirty + y * _depthTilesWidth + x1, 1, x2 - x1 + 1);
+}
+
+uint FrameBuffer::getDepthTileMin(int tileX, int tileY) {
+	const int tile = tileY * _depthTilesWidth + tileX;
+	if (_depthTileDirty[tile]) {
+		const int x1 = tileX << ZB_DEPTH_TILE_BITS, y1 = tileY << ZB_DEPTH_TILE_BITS;
+		const int x2 = MIN(x1 + (1 << ZB_DEPTH_TILE_BITS), _pbufWidth);
+		const int y2 = MIN(y1 + (1 << ZB_DEPTH_TILE_BITS), _pbufHeight);
+		uint minZ = 0xFFFFFFFF;
+		for (int y = y1; y < y2; y++) {
+			const uint *pz = _zbuf + y * _pbufWidth;
+			for (int x = x1; x < x2; x++)
+				minZ = MIN(minZ, pz[x]);
+		}
+		_depthTileMin[tile] = minZ;
+		_depthTileDirty[tile] = 0;
+	}
+	return _depthTileMin[tile];
+}
+
+bool FrameBuffer::isTriangleOccluded(const ZBufferPoint *p0, const ZBufferPoint *p1, const ZBufferPoint *p2) {
+	const int x1 = MAX(MIN(MIN(p0->x, p1->x), p2->x), 0);
+	const int y1 = MAX(MIN(MIN(p0->y, p1->y), p2->y), 0);
+	const int x2 = MIN(MAX(MAX(p0->x, p1->x), p2->x), _pbufWidth - 1);
+	const int y2 = MIN(MAX(MAX(p0->y, p1->y), p2->y), _pbufHeight - 1);
+
+	// Small triangles are drawn faster than their tiles are checked
+	if ((x2 - x1 + 1) * (y2 - y1 + 1) < (4 << (ZB_DEPTH_TILE_BITS * 2)))
+		return false;
+	if (p0->z < 0 || p1->z < 0 || p2->z < 0)
+		return false;
+
+	// The depth is interpolated incrementally, so that it may drift from the
+	// range of the vertices by about one unit per pixel
+	const uint maxZ = MAX(MAX(p0->z, p1->z), p2->z) + 2 * ((x2 - x1) + (y2 - y1)) + 2;
+
+	// With TGL_LESS and TGL_LEQUAL, a pixel is only drawn if its depth is
+	// above the one in the z buffer
+	for (int tileY = y1 >> ZB_DEPTH_TILE_BITS; tileY <= y2 >> ZB_DEPTH_TILE_BITS; tileY++) {
+		for (int tileX = x1 >> ZB_DEPTH_TILE_BITS; tileX <= x2 >> ZB_DEPTH_TILE_BITS; tileX++) {
+			if (maxZ >= getDepthTileMin(tileX, tileY))
+				return false;
+		}
+	}
+	_occludedTriangleCount++;
+	return true;
+}
+
+static bool is8BitsPerChannel(const Graphics::PixelFormat &format) {
+	return format.bytesPerPixel == 4 && format.rBits() == 8 && format.gBits() == 8 && format.bBits() == 8 &&
+	       (format.aBits() == 8 || format.aBits() == 0);
+}
+
+void FrameBuffer::writePixelRow(int pixel, const byte *src, const Graphics::PixelFormat &srcFormat, int count,
+                                float aTint, float rTint, float gTint, float bTint, bool copyOpaque) {
+	int done = 0;
+#ifdef SCUMMVM_SSE2
+	if (_useSSE2 && !_alphaTestEnabled && is8BitsPerChannel(_pbufFormat) && is8BitsPerChannel(srcFormat)) {
+		bool alphaBlending = _sourceBlendingFactor == TGL_SRC_ALPHA && _destinationBlendingFactor == TGL_ONE_MINUS_SRC_ALPHA;
+		if (!_blendingEnabled || alphaBlending) {
+			done = writePixelRowSSE2((uint32 *)_pbuf + pixel, (const uint32 *)src, count, _pbufFormat, srcFormat,
+			                         _blendingEnabled, aTint, rTint, gTint, bTint, copyOpaque);
+		}
+	}
+#endif
+
+	Graphics::PixelBuffer srcBuf(srcFormat, const_cast<byte *>(src));
+	for (int i = done; i < count; i++) {
+		byte a, r, g, b;
+		srcBuf.getARGBAt(i, a, r, g, b);
+		a = a * aTint;
+		r = r * rTint;
+		g = g * gTint;
+		b = b * bTint;
+		if (copyOpaque && a == 0xFF)
+			setPixelAt(pixel + i, _pbufFormat.ARGBToColor(a, r, g, b));
+		else
+			writePixel(pixel + i, a, r, g, b);
+	}
 }
 
 void getSurfaceRef(Graphics::Surface &surface) {
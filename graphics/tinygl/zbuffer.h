@@ -35,6 +35,8 @@
 #include "common/rect.h"
 #include "common/textconsole.h"
 
+class TinyGLDepthTestSuite;
+
 namespace TinyGL {
 
 // Z buffer
@@ -46,6 +48,9 @@ namespace TinyGL {
 
 #define ZB_POINT_Z_FRAC_BITS 14
 
+// the z buffer is divided in tiles of (1 << ZB_DEPTH_TILE_BITS)^2 pixels for occlusion tests
+#define ZB_DEPTH_TILE_BITS 3
+
 #define ZB_POINT_ST_FRAC_BITS 14
 #define ZB_POINT_ST_FRAC_SHIFT     (ZB_POINT_ST_FRAC_BITS - 1)
 #define ZB_POINT_ST_MAX            ( (_textureSize << ZB_POINT_ST_FRAC_BITS) - 1 )
@@ -581,6 +586,25 @@ public:
 	void clearRegion(int x, int y, int w, int h, bool clearZ, int z,
 	                 bool clearColor, int r, int g, int b, bool clearStencil, int stencilValue);
 
+	// Must be called for every area of the z buffer which is written without
+	// going through the functions of this class, like blits to the z buffer
+	void invalidateDepthTiles(int x1, int y1, int x2, int y2);
+
+	// The number of triangles skipped as hidden in all of their tiles
+	uint32 getOccludedTriangleCount() const {
+		return _occludedTriangleCount;
+	}
+
+	void resetOccludedTriangleCount() {
+		_occludedTriangleCount = 0;
+	}
+
+	// Writes a row of count pixels read from src, which is in srcFormat, multiplied
+	// by the tint. The result is the same as calling writePixel for every pixel.
+	// With copyOpaque, pixels left opaque by the tint are set without blending.
+	void writePixelRow(int pixel, const byte *src, const Graphics::PixelFormat &srcFormat, int count,
+	                   float aTint, float rTint, float gTint, float bTint, bool copyOpaque = false);
+
 	const Common::Rect &getClippingRectangle() const {
 		return _clipRectangle;
 	}
@@ -713,6 +737,7 @@ public:
 	}
 
 private:
+	friend class ::TinyGLDepthTestSuite;
 
 	/**
 	* Blit the buffer to the screen buffer, checking the depth of the pixels.
@@ -803,6 +828,9 @@ private:
 	template <bool kInterpRGB, bool kInterpZ, bool kDepthWrite>
 	void drawLine(const ZBufferPoint *p1, const ZBufferPoint *p2);
 
+	uint getDepthTileMin(int tileX, int tileY);
+	bool isTriangleOccluded(const ZBufferPoint *p0, const ZBufferPoint *p1, const ZBufferPoint *p2);
+
 	template <bool kInterpRGB, bool kInterpZ, bool kDepthWrite, bool kEnableScissor>
 	void drawLine(const ZBufferPoint *p1, const ZBufferPoint *p2);
 
@@ -827,6 +855,13 @@ private:
 	uint *_zbuf;
 	byte *_sbuf;
 
+	// The lowest depth of each tile of the z buffer, valid unless the tile is marked as dirty
+	uint *_depthTileMin;
+	byte *_depthTileDirty;
+	int _depthTilesWidth;
+	int _depthTilesHeight;
+	uint32 _occludedTriangleCount;
+
 	bool _enableStencil;
 	int _textureSize;
 	int _textureSizeMask;
@@ -834,6 +869,8 @@ private:
 	Common::Rect _clipRectangle;
 	bool _clippingEnabled;
 
+	bool _useSSE2;
+
 	const TexelBuffer *_currentTexture;
 	const GLTextureEnv *_textureEnv;
 	uint _wrapS, _wrapT;
@@ -868,6 +905,15 @@ private:
 	float _fogColorB;
 };
 
+#ifdef SCUMMVM_SSE2
+// Tints a row of 32 bits pixels with 8 bits channels and writes it to dst, without
+// blending or blended with TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA. Only whole groups
+// of four pixels are written, the number of which is returned.
+int writePixelRowSSE2(uint32 *dst, const uint32 *src, int count, const Graphics::PixelFormat &dstFormat,
+                      const Graphics::PixelFormat &srcFormat, bool blend, float aTint, float rTint, float gTint, float bTint,
+                      bool copyOpaque = false);
+#endif
+
 // memory.c
 void gl_free(void *p);
 void *gl_malloc(int size);
@@ -128,7 +128,7 @@ static inline void _appendDirtyRectangle(const DrawCall &call, Common::List<Dirt
 }
 
 void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas) {
-	typedef Common::List<DrawCall *>::const_iterator DrawCallIterator;
+	typedef Common::Array<DrawCall *>::const_iterator DrawCallIterator;
 	typedef Common::List<DirtyRectangle>::iterator RectangleIterator;
 
 	Common::List<DirtyRectangle> rectangles;
@@ -240,8 +240,9 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 		delete p;
 	}
 
-	_previousFrameDrawCallsQueue = _drawCallsQueue;
-	_drawCallsQueue.clear();
+	// The queues keep their storage, so that queuing draw calls does not allocate memory
+	_previousFrameDrawCallsQueue.swap(_drawCallsQueue);
+	_drawCallsQueue.resize(0);
 
 	disposeResources();
 
@@ -257,7 +258,7 @@ void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 		delete drawCall;
 	}
 
-	_drawCallsQueue.clear();
+	_drawCallsQueue.resize(0);
 
 	disposeResources();
 
@@ -266,6 +267,7 @@ void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 
 void presentBuffer(Common::List<Common::Rect> &dirtyAreas) {
 	GLContext *c = gl_get_context();
+	c->fb->resetOccludedTriangleCount();
 	if (c->_enableDirtyRectangles) {
 		c->presentBufferDirtyRects(dirtyAreas);
 	} else {
@@ -278,6 +280,21 @@ void presentBuffer() {
 	presentBuffer(dirtyAreas);
 }
 
+uint32 getDrawCallMemoryHighWaterMark() {
+	GLContext *c = gl_get_context();
+	return MAX(c->_drawCallAllocator[0].getHighWaterMark(), c->_drawCallAllocator[1].getHighWaterMark());
+}
+
+uint32 getQueuedDrawCallCount() {
+	GLContext *c = gl_get_context();
+	return c->_drawCallsQueue.size();
+}
+
+uint32 getOccludedTriangleCount() {
+	GLContext *c = gl_get_context();
+	return c->fb->getOccludedTriangleCount();
+}
+
 bool DrawCall::operator==(const DrawCall &other) const {
 	if (_type == other._type) {
 		switch (_type) {
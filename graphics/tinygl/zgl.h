@@ -57,6 +57,9 @@ enum {
 // initially # of allocated GLVertexes (will grow when necessary)
 #define POLYGON_MAX_VERTEX 16
 
+// Highest element index + 1 for which glDrawElements reuses transformed vertices
+#define VERTEX_CACHE_MAX_SIZE 65536
+
 // Max # of specular light pow buffers
 #define MAX_SPECULAR_BUFFERS 8
 // # of entries in specular buffer
@@ -226,11 +229,13 @@ struct GLSharedState {
 
 /**
  * A linear allocator implementation.
- * The allocator can be initialized to a specific buffer size only once.
+ * The allocator is initialized to a specific buffer size only once.
  * The allocation scheme is pretty simple: pointers are returned relative to a current memory position,
  * the allocator starts with an offset of 0 and increases its offset by the allocated amount every time.
- * Memory is released through the method free(), care has to be taken to call the destructors of the deallocated objects either manually (for complex struct arrays) or
+ * Memory is released through the method reset(), care has to be taken to call the destructors of the deallocated objects either manually (for complex struct arrays) or
  * by overriding the delete operator (with an empty implementation).
+ * When the buffer is full, further allocations are taken from the heap until the next reset(),
+ * which then grows the buffer so that it can hold everything that was allocated.
  */
 class LinearAllocator {
 public:
@@ -238,6 +243,9 @@ public:
 		_memoryBuffer = nullptr;
 		_memorySize = 0;
 		_memoryPosition = 0;
+		_overflowBlocks = nullptr;
+		_overflowSize = 0;
+		_highWaterMark = 0;
 	}
 
 	void initialize(size_t newSize) {
@@ -251,14 +259,23 @@ public:
 	}
 
 	~LinearAllocator() {
+		freeOverflowBlocks();
 		if (_memoryBuffer != nullptr) {
 			gl_free(_memoryBuffer);
 		}
 	}
 
 	void *allocate(size_t size) {
-		if (_memoryPosition + size >= _memorySize) {
-			error("Allocator out of memory: couldn't allocate more memory from linear allocator.");
+		size = (size + kAlignment - 1) & ~(kAlignment - 1);
+		if (_memoryPosition + size > _memorySize) {
+			OverflowBlock *block = (OverflowBlock *)gl_malloc(kAlignment + size);
+			if (block == nullptr) {
+				error("Allocator out of memory: couldn't allocate more memory from linear allocator.");
+			}
+			block->next = _overflowBlocks;
+			_overflowBlocks = block;
+			_overflowSize += size;
+			return ((byte *)block) + kAlignment;
 		}
 		size_t returnPos = _memoryPosition;
 		_memoryPosition += size;
@@ -266,12 +283,47 @@ public:
 	}
 
 	void reset() {
+		_highWaterMark = getHighWaterMark();
+		if (_overflowBlocks != nullptr) {
+			freeOverflowBlocks();
+			// Leave some room for the next frames to use more memory
+			size_t newSize = _highWaterMark + _highWaterMark / 2;
+			gl_free(_memoryBuffer);
+			_memoryBuffer = gl_malloc(newSize);
+			if (_memoryBuffer == nullptr) {
+				error("Couldn't allocate memory for linear allocator.");
+			}
+			_memorySize = newSize;
+		}
 		_memoryPosition = 0;
 	}
+
+	// The most memory used between two resets
+	size_t getHighWaterMark() const {
+		return MAX(_highWaterMark, _memoryPosition + _overflowSize);
+	}
 private:
+	struct OverflowBlock {
+		OverflowBlock *next;
+	};
+
+	static const size_t kAlignment = 8;
+
+	void freeOverflowBlocks() {
+		while (_overflowBlocks != nullptr) {
+			OverflowBlock *next = _overflowBlocks->next;
+			gl_free(_overflowBlocks);
+			_overflowBlocks = next;
+		}
+		_overflowSize = 0;
+	}
+
 	void *_memoryBuffer;
 	size_t _memorySize;
 	size_t _memoryPosition;
+	OverflowBlock *_overflowBlocks;
+	size_t _overflowSize;
+	size_t _highWaterMark;
 };
 
 struct GLContext;
@@ -331,6 +383,7 @@ struct GLContext {
 	GLSharedState shared_state;
 
 	// current list
+	GLList *current_list;
 	GLParamBuffer *current_op_buffer;
 	int current_op_buffer_index;
 	int exec_flag, compile_flag, print_flag;
@@ -390,6 +443,8 @@ struct GLContext {
 	int vertex_n, vertex_cnt;
 	int vertex_max;
 	GLVertex *vertex;
+	int *vertex_cache;
+	int vertex_cache_size;
 
 	// opengl 1.1 arrays
 	TGLvoid *vertex_array;
@@ -465,14 +520,17 @@ struct GLContext {
 	Common::List<BlitImage *> _blitImages;
 
 	// Draw call queue
-	Common::List<DrawCall *> _drawCallsQueue;
-	Common::List<DrawCall *> _previousFrameDrawCallsQueue;
+	Common::Array<DrawCall *> _drawCallsQueue;
+	Common::Array<DrawCall *> _previousFrameDrawCallsQueue;
 	int _currentAllocatorIndex;
 	LinearAllocator _drawCallAllocator[2];
 	bool _debugRectsEnabled;
 	bool _profilingEnabled;
 
 	void gl_vertex_transform(GLVertex *v);
+	void gl_reserve_vertex();
+	void gl_copy_vertex(int index);
+	void gl_array_element(int idx, int states);
 	void gl_calc_fog_factor(GLVertex *v);
 
 	void gl_get_pname(TGLenum pname, union uglValue *data, eDataType &dataType);
@@ -540,6 +598,7 @@ public:
 	GLList *alloc_list(int list);
 	GLList *find_list(uint list);
 	void delete_list(int list);
+	void optimize_list(GLList *l);
 	void gl_NewList(TGLuint list, TGLenum mode);
 	void gl_EndList();
 	TGLboolean gl_IsList(TGLuint list);
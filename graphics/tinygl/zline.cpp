@@ -58,6 +58,8 @@ FORCEINLINE void FrameBuffer::putPixel(uint pixelOffset, int color, int x, int y
 
 template <bool kInterpRGB, bool kInterpZ, bool kDepthWrite>
 void FrameBuffer::drawLine(const ZBufferPoint *p1, const ZBufferPoint *p2) {
+	if (kDepthWrite)
+		invalidateDepthTiles(MIN(p1->x, p2->x), MIN(p1->y, p2->y), MAX(p1->x, p2->x), MAX(p1->y, p2->y));
 	if (_clippingEnabled)
 		drawLine<kInterpRGB, kInterpZ, kDepthWrite, true>(p1, p2);
 	else
@@ -146,10 +148,12 @@ void FrameBuffer::plot(ZBufferPoint *p) {
 	const uint pixelOffset = p->y * _pbufWidth + p->x;
 	const int col = RGB_TO_PIXEL(p->r, p->g, p->b);
 	const uint z = p->z;
-	if (_depthWrite && _depthTestEnabled)
+	if (_depthWrite && _depthTestEnabled) {
+		invalidateDepthTiles(p->x, p->y, p->x, p->y);
 		putPixel<true>(pixelOffset, col, p->x, p->y, z);
-	else
+	} else {
 		putPixel<false>(pixelOffset, col, p->x, p->y, z);
+	}
 }
 
 void FrameBuffer::fillLineFlatZ(ZBufferPoint *p1, ZBufferPoint *p2) {
@@ -209,7 +209,7 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
                                FrameBuffer::ColorMode colorMode, bool kInterpZ,
                                bool kInterpST, bool kInterpSTZ, bool stippleEnabled) {
 	const TexelBuffer *texture = nullptr;
-	float fdzdx = 0, fndzdx = 0, ndszdx = 0, ndtzdx = 0;
+	float fdzdx = 0, fdzdy = 0, fndzdx = 0, ndszdx = 0, ndtzdx = 0;
 
 	ZBufferPoint *tp, *pr1 = 0, *pr2 = 0, *l1 = 0, *l2 = 0;
 	float fdx1, fdx2, fdy1, fdy2, fz0, d1, d2;
@@ -265,6 +265,15 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 	fz0 = fdx1 * fdy2 - fdx2 * fdy1;
 	if (fz0 == 0)
 		return;
+
+	// Skip the triangles which are behind everything already drawn in all of their tiles
+	if (kDepthTestEnabled && kInterpZ && !kStencilEnabled && !(_offsetStates & TGL_OFFSET_FILL) &&
+	    (_depthFunc == TGL_LESS || _depthFunc == TGL_LEQUAL) && isTriangleOccluded(p0, p1, p2))
+		return;
+	if (kDepthWrite) {
+		invalidateDepthTiles(MIN(MIN(p0->x, p1->x), p2->x), p0->y,
+		                     MAX(MAX(p0->x, p1->x), p2->x), p2->y);
+	}
 	fz0 = (float)(1.0 / fz0);
 
 	fdx1 *= fz0;
@@ -367,6 +376,7 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 	if (colorMode != ColorMode::NoInterpolation && (kInterpST || kInterpSTZ)) {
 		texture = _currentTexture;
 		fdzdx = (float)dzdx;
+		fdzdy = (float)dzdy;
 		fndzdx = NB_INTERP * fdzdx;
 		ndszdx = NB_INTERP * dszdx;
 		ndtzdx = NB_INTERP * dtzdx;
@@ -582,6 +592,7 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				int n, pp;
 				float sz, tz, fz, zinv;
 				int dsdx, dtdx;
+				const TexelBuffer *level = texture;
 
 				n = (x2 >> 16) - x1;
 				fz = (float)z1;
@@ -613,12 +624,17 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 						t = (int)tt;
 						dsdx = (int)((dszdx - ss * fdzdx) * zinv);
 						dtdx = (int)((dtzdx - tt * fdzdx) * zinv);
+						if (texture->hasMipmaps()) {
+							int dsdy = (int)((dszdy - ss * fdzdy) * zinv);
+							int dtdy = (int)((dtzdy - tt * fdzdy) * zinv);
+							level = texture->getMipmap(dsdx, dtdx, dsdy, dtdy);
+						}
 						fz += fndzdx;
 						zinv = (float)(1.0 / fz);
 					}
 					for (int _a = 0; _a < NB_INTERP; _a++) {
 						putPixelTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
-						               (pp, texture, colorMode, _wrapS, _wrapT, pz, ps, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						               (pp, level, colorMode, _wrapS, _wrapT, pz, ps, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
 					}
 					pp += NB_INTERP;
 					if (kInterpZ) {
@@ -641,11 +657,16 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 					t = (int)tt;
 					dsdx = (int)((dszdx - ss * fdzdx) * zinv);
 					dtdx = (int)((dtzdx - tt * fdzdx) * zinv);
+					if (texture->hasMipmaps()) {
+						int dsdy = (int)((dszdy - ss * fdzdy) * zinv);
+						int dtdy = (int)((dtzdy - tt * fdzdy) * zinv);
+						level = texture->getMipmap(dsdx, dtdx, dsdy, dtdy);
+					}
 				}
 
 				while (n >= 0) {
 					putPixelTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
-					               (pp, texture, colorMode, _wrapS, _wrapT, pz, ps, 0, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+					               (pp, level, colorMode, _wrapS, _wrapT, pz, ps, 0, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
 					pp += 1;
 					if (kInterpZ) {
 						pz += 1;
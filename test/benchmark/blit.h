@@ -0,0 +1,260 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "common/str.h"
+#include "common/system.h"
+
+#include "graphics/blit.h"
+#include "graphics/managed_surface.h"
+#include "graphics/transform_struct.h"
+
+#include "../system/null_osystem.h"
+
+// Times the blits of graphics/blit, and traces how many megapixels per second
+// each implementation of them blits. This is not part of the unit tests, as
+// their results are checked in test/graphics/blit.h and test/image/blending.h:
+// "make test-benchmark" runs it.
+
+class BlitBenchmarkTestSuite : public CxxTest::TestSuite {
+	// Every blit is repeated for at least this many milliseconds
+	static const uint32 kMinTime = 200;
+
+	struct Size {
+		int w, h;
+	};
+
+	struct Format {
+		const char *name;
+		Graphics::PixelFormat format;
+	};
+
+	struct Implementation {
+		const char *name;
+		Graphics::BlendBlit::BlitFunc func;
+	};
+
+	static const int kNumSizes = 2;
+	static const Size kSizes[kNumSizes];
+
+	uint32 _seed;
+
+	void createSurfaces(Graphics::ManagedSurface &dst, Graphics::ManagedSurface &src, const Size &size,
+	                    const Graphics::PixelFormat &dstFormat, const Graphics::PixelFormat &srcFormat) {
+		dst.create(size.w, size.h, dstFormat);
+		src.create(size.w, size.h, srcFormat);
+		fillRandom(dst);
+		fillRandom(src);
+	}
+
+	void fillRandom(Graphics::ManagedSurface &surface) {
+		for (int y = 0; y < surface.h; y++) {
+			byte *row = (byte *)surface.getBasePtr(0, y);
+			for (int x = 0; x < surface.w * surface.format.bytesPerPixel; x++) {
+				_seed = _seed * 1103515245 + 12345;
+				row[x] = _seed >> 16;
+			}
+		}
+	}
+
+	template<typename Blit>
+	static void measure(const char *blit, const char *implementation, const Size &size, const char *format, Blit doBlit) {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		uint32 iterations = 0;
+		const uint32 start = g_system->getMillis();
+		uint32 time;
+		do {
+			doBlit();
+			iterations++;
+			time = g_system->getMillis() - start;
+		} while (time < kMinTime);
+
+		const double megapixels = (double)size.w * size.h * iterations / 1000000.0;
+		TS_TRACE(Common::String::format("%s (%s) %dx%d %s: %.1f megapixels/s", blit, implementation, size.w, size.h, format,
+		                                megapixels * 1000.0 / time).c_str());
+#endif
+	}
+
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+		_seed = 1;
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_copy_blit() {
+		static const Format kFormats[] = {
+			{ "CLUT8", Graphics::PixelFormat::createFormatCLUT8() },
+			{ "RGB565", Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0) },
+			{ "ARGB8888", Graphics::PixelFormat::createFormatARGB32() },
+		};
+
+		for (int s = 0; s < kNumSizes; s++) {
+			for (uint f = 0; f < ARRAYSIZE(kFormats); f++) {
+				const Graphics::PixelFormat &format = kFormats[f].format;
+				Graphics::ManagedSurface dst, src;
+				createSurfaces(dst, src, kSizes[s], format, format);
+
+				measure("copyBlit", "generic", kSizes[s], kFormats[f].name, [&]() {
+					Graphics::copyBlit((byte *)dst.getPixels(), (const byte *)src.getPixels(),
+					                   dst.pitch, src.pitch, src.w, src.h, format.bytesPerPixel);
+				});
+				measure("keyBlit", "generic", kSizes[s], kFormats[f].name, [&]() {
+					Graphics::keyBlit((byte *)dst.getPixels(), (const byte *)src.getPixels(),
+					                  dst.pitch, src.pitch, src.w, src.h, format.bytesPerPixel, 0);
+				});
+			}
+		}
+	}
+
+	void test_cross_blit() {
+		static const Format kFormats[][2] = {
+			{ { "ARGB8888", Graphics::PixelFormat::createFormatARGB32() }, { "RGBA8888", Graphics::PixelFormat::createFormatRGBA32() } },
+			{ { "ABGR8888", Graphics::PixelFormat::createFormatABGR32() }, { "ARGB8888", Graphics::PixelFormat::createFormatARGB32() } },
+			{ { "RGB565", Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0) }, { "XRGB1555", Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0) } },
+			{ { "RGBA8888", Graphics::PixelFormat::createFormatRGBA32() }, { "RGB565", Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0) } },
+		};
+
+		for (int s = 0; s < kNumSizes; s++) {
+			for (uint f = 0; f < ARRAYSIZE(kFormats); f++) {
+				const Graphics::PixelFormat &dstFormat = kFormats[f][0].format, &srcFormat = kFormats[f][1].format;
+				const Common::String formatName = Common::String::format("%s from %s", kFormats[f][0].name, kFormats[f][1].name);
+				Graphics::ManagedSurface dst, src;
+				createSurfaces(dst, src, kSizes[s], dstFormat, srcFormat);
+
+				// Masking every pixel in always goes through the generic conversion
+				Graphics::ManagedSurface mask(src.w, src.h, Graphics::PixelFormat::createFormatCLUT8());
+				mask.fillRect(Common::Rect(mask.w, mask.h), 1);
+
+				measure("crossBlit", "generic", kSizes[s], formatName.c_str(), [&]() {
+					Graphics::crossMaskBlit((byte *)dst.getPixels(), (const byte *)src.getPixels(), (const byte *)mask.getPixels(),
+					                        dst.pitch, src.pitch, mask.pitch, src.w, src.h, dstFormat, srcFormat);
+				});
+				if (Graphics::getFastBlitFunc(dstFormat, srcFormat) != nullptr) {
+					measure("crossBlit", "fast", kSizes[s], formatName.c_str(), [&]() {
+						Graphics::crossBlit((byte *)dst.getPixels(), (const byte *)src.getPixels(),
+						                    dst.pitch, src.pitch, src.w, src.h, dstFormat, srcFormat);
+					});
+				}
+			}
+		}
+	}
+
+	void test_alpha_blit() {
+		const Graphics::PixelFormat format = Graphics::PixelFormat::createFormatARGB32();
+		for (int s = 0; s < kNumSizes; s++) {
+			for (int aMod = 128; aMod <= 255; aMod += 127) {
+				Graphics::ManagedSurface dst, src;
+				createSurfaces(dst, src, kSizes[s], format, format);
+
+				const Common::String formatName = Common::String::format("ARGB8888 alpha %d", aMod);
+				measure("alphaBlit", "generic", kSizes[s], formatName.c_str(), [&]() {
+					Graphics::alphaBlit((byte *)dst.getPixels(), (const byte *)src.getPixels(),
+					                    dst.pitch, src.pitch, src.w, src.h, format, format, 0, aMod);
+				});
+			}
+		}
+	}
+
+	void test_blend_blit() {
+		static const char *const kBlendModes[] = { "normal", "additive", "subtractive", "multiply" };
+		static const char *const kAlphaTypes[] = { "opaque", "binary", "full" };
+
+		Implementation implementations[4];
+		int numImplementations = 0;
+		implementations[numImplementations].name = "generic";
+		implementations[numImplementations++].func = Graphics::BlendBlit::blitGeneric;
+#ifdef SCUMMVM_NEON
+		implementations[numImplementations].name = "NEON";
+		implementations[numImplementations++].func = Graphics::BlendBlit::blitNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2) {
+			implementations[numImplementations].name = "SSE2";
+			implementations[numImplementations++].func = Graphics::BlendBlit::blitSSE2;
+		}
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8) {
+			implementations[numImplementations].name = "AVX2";
+			implementations[numImplementations++].func = Graphics::BlendBlit::blitAVX2;
+		}
+#endif
+
+		const Graphics::PixelFormat format = Graphics::BlendBlit::getSupportedPixelFormat();
+		Graphics::BlendBlit::BlitFunc oldFunc = Graphics::BlendBlit::blitFunc;
+
+		for (int s = 0; s < kNumSizes; s++) {
+			const Size &size = kSizes[s];
+			Graphics::ManagedSurface dst, src;
+			createSurfaces(dst, src, size, format, format);
+
+			for (int blendMode = 0; blendMode < Graphics::NUM_BLEND_MODES; blendMode++) {
+				for (int alphaType = 0; alphaType <= Graphics::ALPHA_FULL; alphaType++) {
+					for (int scaled = 0; scaled < 2; scaled++) {
+						// Scaling blits the top left quarter of the source at twice its size
+						const Common::Rect srcRect = scaled ? Common::Rect(size.w / 2, size.h / 2) : Common::Rect(size.w, size.h);
+						const Common::String formatName = Common::String::format("%s %s%s", kBlendModes[blendMode], kAlphaTypes[alphaType], scaled ? " scaled" : "");
+						for (int impl = 0; impl < numImplementations; impl++) {
+							Graphics::BlendBlit::blitFunc = implementations[impl].func;
+							measure("BlendBlit", implementations[impl].name, size, formatName.c_str(), [&]() {
+								dst.blendBlitFrom(src, srcRect, Common::Rect(size.w, size.h), Graphics::FLIP_NONE, MS_ARGB(255, 255, 255, 255),
+								                  (Graphics::TSpriteBlendMode)blendMode, (Graphics::AlphaType)alphaType);
+							});
+						}
+					}
+				}
+			}
+		}
+
+		Graphics::BlendBlit::blitFunc = oldFunc;
+	}
+
+	void test_scale_blit() {
+		static const Format kFormats[] = {
+			{ "ARGB8888", Graphics::PixelFormat::createFormatARGB32() },
+			{ "RGB565", Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0) },
+		};
+
+		for (int s = 0; s < kNumSizes; s++) {
+			const Size &size = kSizes[s];
+			const Size half = { size.w / 2, size.h / 2 };
+			for (uint f = 0; f < ARRAYSIZE(kFormats); f++) {
+				const Graphics::PixelFormat &format = kFormats[f].format;
+				Graphics::ManagedSurface dst, src;
+				createSurfaces(dst, src, size, format, format);
+
+				// Upscaling from half the size, and rotating by 30 degrees
+				measure("scaleBlit", "generic", size, kFormats[f].name, [&]() {
+					Graphics::scaleBlit((byte *)dst.getPixels(), (const byte *)src.getPixels(), dst.pitch, src.pitch,
+					                    size.w, size.h, half.w, half.h, format);
+				});
+				measure("scaleBlitBilinear", "generic", size, kFormats[f].name, [&]() {
+					Graphics::scaleBlitBilinear((byte *)dst.getPixels(), (const byte *)src.getPixels(), dst.pitch, src.pitch,
+					                            size.w, size.h, half.w, half.h, format);
+				});
+
+				const Graphics::TransformStruct transform(Graphics::kDefaultZoomX, Graphics::kDefaultZoomY, 30, size.w / 2, size.h / 2);
+				measure("rotoscaleBlit", "generic", size, kFormats[f].name, [&]() {
+					Graphics::rotoscaleBlit((byte *)dst.getPixels(), (const byte *)src.getPixels(), dst.pitch, src.pitch,
+					                        size.w, size.h, size.w, size.h, format, transform, Common::Point(size.w / 2, size.h / 2));
+				});
+				measure("rotoscaleBlitBilinear", "generic", size, kFormats[f].name, [&]() {
+					Graphics::rotoscaleBlitBilinear((byte *)dst.getPixels(), (const byte *)src.getPixels(), dst.pitch, src.pitch,
+					                                size.w, size.h, size.w, size.h, format, transform, Common::Point(size.w / 2, size.h / 2));
+				});
+			}
+		}
+	}
+};
+
+// Common game resolutions
+const BlitBenchmarkTestSuite::Size BlitBenchmarkTestSuite::kSizes[BlitBenchmarkTestSuite::kNumSizes] = {
+	{ 320, 200 }, { 640, 480 }
+};
@@ -0,0 +1,174 @@
+#include <cxxtest/TestSuite.h>
+#include "engines/ultima/ultima8/misc/point3.h"
+#include "engines/ultima/ultima8/world/item_sorter.h"
+#include "engines/ultima/ultima8/world/sort_item.h"
+
+/**
+ * Test suite for the display list of engines/ultima/ultima8/world/item_sorter.h
+ *
+ * Items are only compared with the ones sharing a screenspace bin, and the
+ * list walk stops early once nothing is left to compare. The resulting list
+ * order, occlusion and dependencies must be those of comparing every item,
+ * which is what the sorter did before binning.
+ */
+class U8ItemSorterTestSuite : public CxxTest::TestSuite {
+	static const int kNumItems = 300;
+
+	uint32 _seed;
+
+	int randomInt(int min, int max) {
+		_seed = _seed * 1103515245 + 12345;
+		return min + (int)((_seed >> 8) % (uint32)(max - min + 1));
+	}
+
+	// Sets up an item like AddItem does from a shape, around the clip window
+	// and past its edges. The coordinates are sometimes snapped to a grid, so
+	// that items touch and line up exactly.
+	void randomItem(Ultima::Ultima8::SortItem &si, uint16 itemNum, const Common::Rect32 &clipWindow) {
+		const int snap = randomInt(0, 1) ? 32 : 1;
+		const int sx = randomInt(clipWindow.left - 150, clipWindow.right + 50);
+		const int sy = randomInt(clipWindow.top - 50, clipWindow.bottom + 100);
+		const int z = randomInt(0, 20) * (snap == 1 ? 1 : 8);
+		const int x = (2 * sx + 4 * (sy + z)) / snap * snap;
+		const int y = (4 * (sy + z) - 2 * sx) / snap * snap;
+		const int xd = randomInt(1, 8) * 32;
+		const int yd = randomInt(1, 8) * 32;
+		const int zd = randomInt(0, 4) * 32;
+
+		si._itemNum = itemNum;
+		si.setBoxBounds(Ultima::Ultima8::Box(x, y, z, xd, yd, zd), 0, 0);
+
+		// Shape frames may stick out of the box
+		if (randomInt(0, 3) == 0) {
+			si._sr.left -= randomInt(0, 40);
+			si._sr.top -= randomInt(0, 40);
+			si._sr.right += randomInt(0, 40);
+			si._sr.bottom += randomInt(0, 40);
+		}
+
+		si._draw = randomInt(0, 7) != 0;
+		si._solid = randomInt(0, 1);
+		si._occl = randomInt(0, 1);
+		si._roof = randomInt(0, 7) == 0;
+		si._trans = randomInt(0, 7) == 0;
+		si._fixed = randomInt(0, 1);
+		si._land = randomInt(0, 1);
+	}
+
+	// The sort before binning, which compares the new item with every item
+	static void insertExhaustive(Common::Array<Ultima::Ultima8::SortItem *> &list, Ultima::Ultima8::SortItem *si) {
+		si->_occluded = false;
+		si->_depends.clear();
+
+		int addpoint = -1;
+		for (uint i = 0; i < list.size(); i++) {
+			Ultima::Ultima8::SortItem *si2 = list[i];
+			if (addpoint < 0 && si->listLessThan(*si2))
+				addpoint = i;
+
+			if (si2->_occluded)
+				continue;
+
+			if (si->overlap(*si2)) {
+				if (si->below(*si2)) {
+					if (si2->_occl && si2->occludes(*si)) {
+						si->_occluded = true;
+						break;
+					} else {
+						si2->_depends.insert_sorted(si);
+					}
+				} else {
+					if (si->_occl && si->occludes(*si2)) {
+						si2->_occluded = true;
+					} else {
+						si->_depends.insert_sorted(si2);
+					}
+				}
+			}
+		}
+
+		if (addpoint >= 0)
+			list.insert_at(addpoint, si);
+		else
+			list.push_back(si);
+	}
+
+	static Common::String describe(const Ultima::Ultima8::SortItem &si) {
+		Common::String s = Common::String::format("%d%s:", si._itemNum, si._occluded ? " occluded" : "");
+		for (Ultima::Ultima8::SortItem::DependsList::iterator it = si._depends.begin(); it != si._depends.end(); ++it)
+			s += Common::String::format(" %d", (*it)->_itemNum);
+		return s;
+	}
+
+	void compareWithExhaustive(uint32 seed, const Common::Rect32 &clipWindow) {
+		Ultima::Ultima8::ItemSorter sorter(kNumItems);
+		sorter.ResetDisplayList(clipWindow, Ultima::Ultima8::Point3(0, 0, 0));
+
+		Ultima::Ultima8::SortItem *items = new Ultima::Ultima8::SortItem[kNumItems];
+		Common::Array<Ultima::Ultima8::SortItem *> expected;
+
+		_seed = seed;
+		int clipped = 0, crossing = 0;
+		for (int i = 0; i < kNumItems; i++) {
+			// Set up the same item for both sorts
+			Ultima::Ultima8::SortItem *si = sorter._itemsUnused;
+			const uint32 itemSeed = _seed;
+			randomItem(*si, i, clipWindow);
+			_seed = itemSeed;
+			randomItem(items[i], i, clipWindow);
+
+			// Clipped away entirely, as AddItem does before inserting
+			if (!clipWindow.intersects(items[i]._sr)) {
+				clipped++;
+				continue;
+			}
+
+			if (!clipWindow.contains(items[i]._sr))
+				crossing++;
+
+			sorter.InsertSortItem(si);
+
+			insertExhaustive(expected, &items[i]);
+		}
+
+		// Some items are clipped, and some more stick out of the window
+		TS_ASSERT_LESS_THAN(0, clipped);
+		TS_ASSERT_LESS_THAN(0, crossing);
+
+		uint index = 0, dependencies = 0;
+		int occluded = 0;
+		for (Ultima::Ultima8::SortItem *si = sorter._items; si != nullptr; si = si->_next, index++) {
+			TS_ASSERT_LESS_THAN(index, expected.size());
+			if (index >= expected.size())
+				break;
+			TS_ASSERT_EQUALS(describe(*si), describe(*expected[index]));
+
+			if (si->_depends.begin() != si->_depends.end())
+				dependencies++;
+			if (si->_occluded)
+				occluded++;
+		}
+		TS_ASSERT_EQUALS(index, expected.size());
+
+		// The scene has items in front of others, and hidden by others
+		TS_ASSERT_LESS_THAN(0u, dependencies);
+		TS_ASSERT_LESS_THAN(0, occluded);
+
+		delete[] items;
+	}
+
+public:
+	void test_binned_sort_matches_exhaustive() {
+		// Several bins in both directions, and a window smaller than a bin
+		const Common::Rect32 clipWindows[] = {
+			Common::Rect32(0, 0, 640, 480),
+			Common::Rect32(100, 150, 420, 350),
+			Common::Rect32(300, 300, 340, 330)
+		};
+
+		for (uint w = 0; w < ARRAYSIZE(clipWindows); w++) {
+			for (uint32 seed = 1; seed <= 20; seed++)
+				compareWithExhaustive(seed * 7919, clipWindows[w]);
+		}
+	}
+};
@@ -0,0 +1,73 @@
+#include <cxxtest/TestSuite.h>
+#include "engines/wintermute/system/sys_pool.h"
+
+/**
+ * Test suite for the SystemPool allocator in engines/wintermute/system/sys_pool.h
+ *
+ * Pooled classes hand out the memory of deleted instances again, without
+ * clearing it. This is why their dynamic constructors, which are used to
+ * load saved games, must initialize every member not loaded from the save.
+ */
+class SystemPoolTestSuite : public CxxTest::TestSuite {
+	struct Object {
+		char *buffer;
+		uint32 bufferSize;
+		double value;
+	};
+
+	Wintermute::SystemPool _pool;
+
+public:
+	void test_reuse_released_objects() {
+		Object *first = (Object *)_pool.allocate(sizeof(Object));
+		Object *second = (Object *)_pool.allocate(sizeof(Object));
+		TS_ASSERT_DIFFERS(first, second);
+		TS_ASSERT_EQUALS(_pool.getNumObjects(), 2u);
+
+		first->buffer = nullptr;
+		first->bufferSize = 42;
+		_pool.release(first);
+		TS_ASSERT_EQUALS(_pool.getNumObjects(), 1u);
+
+		// The last released object comes back first, with the members
+		// following the free list link left as they were
+		Object *third = (Object *)_pool.allocate(sizeof(Object));
+		TS_ASSERT_EQUALS(third, first);
+		TS_ASSERT_EQUALS(third->bufferSize, 42u);
+
+		_pool.release(second);
+		_pool.release(third);
+		TS_ASSERT_EQUALS(_pool.getNumObjects(), 0u);
+	}
+
+	void test_alignment() {
+		Object *objects[3];
+		for (int i = 0; i < 3; i++) {
+			objects[i] = (Object *)_pool.allocate(sizeof(Object));
+			TS_ASSERT_EQUALS((uintptr)objects[i] % sizeof(double), 0u);
+			objects[i]->value = i;
+		}
+
+		for (int i = 0; i < 3; i++) {
+			TS_ASSERT_EQUALS(objects[i]->value, (double)i);
+			_pool.release(objects[i]);
+		}
+	}
+
+	void test_many_blocks() {
+		// More objects than a single block holds
+		const int kNumObjects = 1000;
+		Object *objects[kNumObjects];
+		for (int i = 0; i < kNumObjects; i++) {
+			objects[i] = (Object *)_pool.allocate(sizeof(Object));
+			objects[i]->bufferSize = i;
+		}
+		TS_ASSERT_EQUALS(_pool.getNumObjects(), (uint32)kNumObjects);
+
+		for (int i = 0; i < kNumObjects; i++) {
+			TS_ASSERT_EQUALS(objects[i]->bufferSize, (uint32)i);
+			_pool.release(objects[i]);
+		}
+		TS_ASSERT_EQUALS(_pool.getNumObjects(), 0u);
+	}
+};
@@ -0,0 +1,290 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/str.h"
+
+#include "graphics/blit.h"
+#include "graphics/managed_surface.h"
+#include "graphics/transform_struct.h"
+
+// Checks the blits of graphics/blit against a per-pixel reference, over a
+// few pixel formats, sizes and alignments. Where a blit has a fast path, its
+// result is checked against the generic conversion. BlendBlit, whose vector
+// implementations are checked against the generic one, is tested along with
+// the rest of the blending in test/image/blending.h. The timing lives in
+// test/benchmark/blit.h, which "make test-benchmark" runs.
+
+class BlitTestSuite : public CxxTest::TestSuite {
+	struct Size {
+		int w, h;
+	};
+
+	struct Format {
+		const char *name;
+		Graphics::PixelFormat format;
+	};
+
+	static const int kNumSizes = 3;
+	static const Size kSizes[kNumSizes];
+
+	uint32 _seed;
+
+	// The destination is one pixel wider, so that blitting at an offset of
+	// one pixel gives rows which are not aligned like the allocation
+	void createSurfaces(Graphics::ManagedSurface &dst, Graphics::ManagedSurface &src, const Size &size,
+	                    const Graphics::PixelFormat &dstFormat, const Graphics::PixelFormat &srcFormat) {
+		dst.create(size.w + 1, size.h, dstFormat);
+		src.create(size.w, size.h, srcFormat);
+		fillRandom(dst);
+		fillRandom(src);
+	}
+
+	void fillRandom(Graphics::ManagedSurface &surface) {
+		for (int y = 0; y < surface.h; y++) {
+			byte *row = (byte *)surface.getBasePtr(0, y);
+			for (int x = 0; x < surface.w * surface.format.bytesPerPixel; x++) {
+				_seed = _seed * 1103515245 + 12345;
+				row[x] = _seed >> 16;
+			}
+		}
+	}
+
+	static Common::String describe(const char *blit, const Size &size, const char *format, int offset) {
+		return Common::String::format("%s %dx%d %s%s", blit, size.w, size.h, format, offset ? " unaligned" : "");
+	}
+
+	static bool equalPixels(const Graphics::ManagedSurface &a, const Graphics::ManagedSurface &b) {
+		for (int y = 0; y < a.h; y++) {
+			if (memcmp(a.getBasePtr(0, y), b.getBasePtr(0, y), a.w * a.format.bytesPerPixel) != 0)
+				return false;
+		}
+		return true;
+	}
+
+public:
+	void setUp() {
+		_seed = 1;
+	}
+
+	void test_copy_blit() {
+		static const Format kFormats[] = {
+			{ "CLUT8", Graphics::PixelFormat::createFormatCLUT8() },
+			{ "RGB565", Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0) },
+			{ "ARGB8888", Graphics::PixelFormat::createFormatARGB32() },
+		};
+
+		for (int s = 0; s < kNumSizes; s++) {
+			for (uint f = 0; f < ARRAYSIZE(kFormats); f++) {
+				const Graphics::PixelFormat &format = kFormats[f].format;
+				for (int offset = 0; offset < 2; offset++) {
+					const Common::String name = describe("copyBlit", kSizes[s], kFormats[f].name, offset);
+					Graphics::ManagedSurface dst, src, expected;
+					createSurfaces(dst, src, kSizes[s], format, format);
+					expected.copyFrom(dst);
+					for (int y = 0; y < src.h; y++)
+						memcpy(expected.getBasePtr(offset, y), src.getBasePtr(0, y), src.w * format.bytesPerPixel);
+
+					Graphics::copyBlit((byte *)dst.getBasePtr(offset, 0), (const byte *)src.getPixels(),
+					                   dst.pitch, src.pitch, src.w, src.h, format.bytesPerPixel);
+					TSM_ASSERT(name.c_str(), equalPixels(dst, expected));
+				}
+			}
+		}
+	}
+
+	void test_key_blit() {
+		static const Format kFormats[] = {
+			{ "CLUT8", Graphics::PixelFormat::createFormatCLUT8() },
+			{ "RGB565", Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0) },
+			{ "ARGB8888", Graphics::PixelFormat::createFormatARGB32() },
+		};
+
+		for (int s = 0; s < kNumSizes; s++) {
+			for (uint f = 0; f < ARRAYSIZE(kFormats); f++) {
+				const Graphics::PixelFormat &format = kFormats[f].format;
+				for (int offset = 0; offset < 2; offset++) {
+					const Common::String name = describe("keyBlit", kSizes[s], kFormats[f].name, offset);
+					Graphics::ManagedSurface dst, src, expected;
+					createSurfaces(dst, src, kSizes[s], format, format);
+
+					// Every third pixel is the key, which random data would hardly ever hit
+					const uint32 key = src.getPixel(0, 0);
+					for (int y = 0; y < src.h; y++) {
+						for (int x = 0; x < src.w; x++) {
+							if ((x + y) % 3 == 0)
+								src.setPixel(x, y, key);
+						}
+					}
+
+					expected.copyFrom(dst);
+					for (int y = 0; y < src.h; y++) {
+						for (int x = 0; x < src.w; x++) {
+							if (src.getPixel(x, y) != key)
+								expected.setPixel(x + offset, y, src.getPixel(x, y));
+						}
+					}
+
+					Graphics::keyBlit((byte *)dst.getBasePtr(offset, 0), (const byte *)src.getPixels(),
+					                  dst.pitch, src.pitch, src.w, src.h, format.bytesPerPixel, key);
+					TSM_ASSERT(name.c_str(), equalPixels(dst, expected));
+				}
+			}
+		}
+	}
+
+	void test_cross_blit() {
+		// The first three pairs have fast conversions
+		static const Format kFormats[][2] = {
+			{ { "ARGB8888", Graphics::PixelFormat::createFormatARGB32() }, { "RGBA8888", Graphics::PixelFormat::createFormatRGBA32() } },
+			{ { "ABGR8888", Graphics::PixelFormat::createFormatABGR32() }, { "ARGB8888", Graphics::PixelFormat::createFormatARGB32() } },
+			{ { "RGB565", Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0) }, { "XRGB1555", Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0) } },
+			{ { "RGBA8888", Graphics::PixelFormat::createFormatRGBA32() }, { "RGB565", Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0) } },
+			{ { "RGB565", Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0) }, { "ARGB8888", Graphics::PixelFormat::createFormatARGB32() } },
+		};
+
+		for (int s = 0; s < kNumSizes; s++) {
+			for (uint f = 0; f < ARRAYSIZE(kFormats); f++) {
+				const Format &dstFormat = kFormats[f][0], &srcFormat = kFormats[f][1];
+				const Common::String formatName = Common::String::format("%s from %s", dstFormat.name, srcFormat.name);
+				for (int offset = 0; offset < 2; offset++) {
+					const Common::String name = describe("crossBlit", kSizes[s], formatName.c_str(), offset);
+					Graphics::ManagedSurface dst, src, expected;
+					createSurfaces(dst, src, kSizes[s], dstFormat.format, srcFormat.format);
+
+					expected.copyFrom(dst);
+					for (int y = 0; y < src.h; y++) {
+						for (int x = 0; x < src.w; x++) {
+							byte a, r, g, b;
+							srcFormat.format.colorToARGB(src.getPixel(x, y), a, r, g, b);
+							expected.setPixel(x + offset, y, dstFormat.format.ARGBToColor(a, r, g, b));
+						}
+					}
+
+					// The generic conversion, which masking every pixel in always goes through
+					Graphics::ManagedSurface generic;
+					generic.copyFrom(dst);
+					Graphics::ManagedSurface mask(src.w, src.h, Graphics::PixelFormat::createFormatCLUT8());
+					mask.fillRect(Common::Rect(mask.w, mask.h), 1);
+					Graphics::crossMaskBlit((byte *)generic.getBasePtr(offset, 0), (const byte *)src.getPixels(), (const byte *)mask.getPixels(),
+					                        generic.pitch, src.pitch, mask.pitch, src.w, src.h, dstFormat.format, srcFormat.format);
+					TSM_ASSERT((name + " generic").c_str(), equalPixels(generic, expected));
+
+					Graphics::crossBlit((byte *)dst.getBasePtr(offset, 0), (const byte *)src.getPixels(),
+					                    dst.pitch, src.pitch, src.w, src.h, dstFormat.format, srcFormat.format);
+					TSM_ASSERT(name.c_str(), equalPixels(dst, expected));
+				}
+			}
+		}
+	}
+
+	void test_alpha_blit() {
+		const Graphics::PixelFormat format = Graphics::PixelFormat::createFormatARGB32();
+		for (int s = 0; s < kNumSizes; s++) {
+			for (int aMod = 128; aMod <= 255; aMod += 127) {
+				for (int offset = 0; offset < 2; offset++) {
+					const Common::String formatName = Common::String::format("ARGB8888 alpha %d", aMod);
+					const Common::String name = describe("alphaBlit", kSizes[s], formatName.c_str(), offset);
+					Graphics::ManagedSurface dst, src, expected;
+					createSurfaces(dst, src, kSizes[s], format, format);
+
+					// Opaque pixels are copied, transparent ones skipped, and the rest
+					// blended by their alpha scaled by the modulation
+					expected.copyFrom(dst);
+					for (int y = 0; y < src.h; y++) {
+						for (int x = 0; x < src.w; x++) {
+							byte sA, sR, sG, sB, dA, dR, dG, dB;
+							format.colorToARGB(src.getPixel(x, y), sA, sR, sG, sB);
+							format.colorToARGB(expected.getPixel(x + offset, y), dA, dR, dG, dB);
+							if (sA == 0xff && aMod == 0xff) {
+								expected.setPixel(x + offset, y, src.getPixel(x, y));
+							} else if (sA != 0) {
+								sA = (sA * aMod) >> 8;
+								dR = (dR * (255 - sA) + sR * sA) >> 8;
+								dG = (dG * (255 - sA) + sG * sA) >> 8;
+								dB = (dB * (255 - sA) + sB * sA) >> 8;
+								expected.setPixel(x + offset, y, format.RGBToColor(dR, dG, dB));
+							}
+						}
+					}
+
+					Graphics::alphaBlit((byte *)dst.getBasePtr(offset, 0), (const byte *)src.getPixels(),
+					                    dst.pitch, src.pitch, src.w, src.h, format, format, 0, aMod);
+					TSM_ASSERT(name.c_str(), equalPixels(dst, expected));
+				}
+			}
+		}
+	}
+
+	void test_scale_blit() {
+		static const Format kFormats[] = {
+			{ "ARGB8888", Graphics::PixelFormat::createFormatARGB32() },
+			{ "RGB565", Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0) },
+		};
+
+		for (int s = 0; s < kNumSizes; s++) {
+			const Size &size = kSizes[s];
+			const Size twice = { size.w * 2, size.h * 2 };
+			for (uint f = 0; f < ARRAYSIZE(kFormats); f++) {
+				const Graphics::PixelFormat &format = kFormats[f].format;
+				Graphics::ManagedSurface dst, src, expected;
+				createSurfaces(dst, src, twice, format, format);
+				src.create(size.w, size.h, format);
+				fillRandom(src);
+
+				// Doubling the size repeats every pixel twice in both directions
+				expected.copyFrom(dst);
+				for (int y = 0; y < twice.h; y++) {
+					for (int x = 0; x < twice.w; x++)
+						expected.setPixel(x, y, src.getPixel(x / 2, y / 2));
+				}
+
+				Graphics::scaleBlit((byte *)dst.getPixels(), (const byte *)src.getPixels(), dst.pitch, src.pitch,
+				                    twice.w, twice.h, size.w, size.h, format);
+				TSM_ASSERT(describe("scaleBlit", size, kFormats[f].name, 0).c_str(), equalPixels(dst, expected));
+
+				// The bilinear scaling at the same size changes nothing
+				expected.copyFrom(dst);
+				for (int y = 0; y < size.h; y++)
+					memcpy(expected.getBasePtr(0, y), src.getBasePtr(0, y), size.w * format.bytesPerPixel);
+
+				Graphics::ManagedSurface bilinear;
+				bilinear.copyFrom(dst);
+				Graphics::scaleBlitBilinear((byte *)bilinear.getPixels(), (const byte *)src.getPixels(), bilinear.pitch, src.pitch,
+				                            size.w, size.h, size.w, size.h, format);
+				TSM_ASSERT(describe("scaleBlitBilinear", size, kFormats[f].name, 0).c_str(), equalPixels(bilinear, expected));
+
+				// Rotating by 180 degrees around the last pixel, which ends up at
+				// the origin, flips the source both ways. The rotation writes rows
+				// as wide as the destination, without a pitch of their own.
+				Graphics::ManagedSurface rotated(size.w, size.h, format);
+				fillRandom(rotated);
+				for (int filtering = 0; filtering < 2; filtering++) {
+					expected.copyFrom(rotated);
+					for (int y = 0; y < size.h; y++) {
+						for (int x = 0; x < size.w; x++) {
+							// The bilinear rotation leaves out the last column and row of the source
+							if (!filtering || (x > 0 && y > 0))
+								expected.setPixel(x, y, src.getPixel(size.w - 1 - x, size.h - 1 - y));
+						}
+					}
+
+					const Graphics::TransformStruct transform(Graphics::kDefaultZoomX, Graphics::kDefaultZoomY, 180, size.w - 1, size.h - 1);
+					Graphics::ManagedSurface result;
+					result.copyFrom(rotated);
+					if (filtering) {
+						Graphics::rotoscaleBlitBilinear((byte *)result.getPixels(), (const byte *)src.getPixels(), result.pitch, src.pitch,
+						                                size.w, size.h, size.w, size.h, format, transform, Common::Point());
+					} else {
+						Graphics::rotoscaleBlit((byte *)result.getPixels(), (const byte *)src.getPixels(), result.pitch, src.pitch,
+						                        size.w, size.h, size.w, size.h, format, transform, Common::Point());
+					}
+					TSM_ASSERT(describe(filtering ? "rotoscaleBlitBilinear" : "rotoscaleBlit", size, kFormats[f].name, 0).c_str(), equalPixels(result, expected));
+				}
+			}
+		}
+	}
+};
+
+// An odd size leaves tails after the unrolled loops, the others are common game resolutions
+const BlitTestSuite::Size BlitTestSuite::kSizes[BlitTestSuite::kNumSizes] = {
+	{ 37, 19 }, { 320, 200 }, { 640, 480 }
+};
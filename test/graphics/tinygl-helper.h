@@ -0,0 +1,51 @@
+#ifndef TEST_GRAPHICS_TINYGL_HELPER_H
+#define TEST_GRAPHICS_TINYGL_HELPER_H
+
+#include "graphics/tinygl/tinygl.h"
+
+namespace TinyGLTest {
+
+// Creates a square ARGB context and makes it current, with identity
+// matrices and a viewport covering all of it
+inline TinyGL::ContextHandle *createContext(int size, int textureSize = 2) {
+	TinyGL::ContextHandle *context = TinyGL::createContext(size, size, Graphics::PixelFormat::createFormatARGB32(), textureSize, false, false);
+	TinyGL::setContext(context);
+
+	tglMatrixMode(TGL_PROJECTION);
+	tglLoadIdentity();
+	tglMatrixMode(TGL_MODELVIEW);
+	tglLoadIdentity();
+	tglViewport(0, 0, size, size);
+	return context;
+}
+
+inline void destroyContext(TinyGL::ContextHandle *&context) {
+	if (context != nullptr) {
+		TinyGL::destroyContext(context);
+		context = nullptr;
+	}
+}
+
+// Presents the frame and copies it into surface, which the caller frees
+inline void copyFrame(Graphics::Surface &surface) {
+	Graphics::Surface frame;
+	TinyGL::presentBuffer();
+	TinyGL::getSurfaceRef(frame);
+	surface.copyFrom(frame);
+}
+
+// Returns how many pixels of two surfaces of the same size differ
+inline int countDifferences(const Graphics::Surface &a, const Graphics::Surface &b) {
+	int differences = 0;
+	for (int y = 0; y < a.h; y++) {
+		for (int x = 0; x < a.w; x++) {
+			if (a.getPixel(x, y) != b.getPixel(x, y))
+				differences++;
+		}
+	}
+	return differences;
+}
+
+} // End of namespace TinyGLTest
+
+#endif
@@ -0,0 +1,140 @@
+#include <cxxtest/TestSuite.h>
+
+#ifdef USE_TINYGL
+
+#include "test/graphics/tinygl-helper.h"
+
+// glDrawElements transforms each vertex of the mesh once, whatever the number
+// of triangles sharing it: drawing with glArrayElement gives the reference
+
+class TinyGLArraysTestSuite : public CxxTest::TestSuite {
+	static const int kSize = 32;
+	static const int kGrid = 5;
+
+	TinyGL::ContextHandle *_context = nullptr;
+	float _vertices[kGrid * kGrid * 3];
+	float _normals[kGrid * kGrid * 3];
+	float _colors[kGrid * kGrid * 4];
+	TGLushort _indices[(kGrid - 1) * (kGrid - 1) * 6];
+	int _indexCount;
+
+public:
+	void setUp() {
+		_context = TinyGLTest::createContext(kSize);
+		tglDisable(TGL_BLEND);
+		tglEnable(TGL_DEPTH_TEST);
+		tglRotatef(20.0f, 1.0f, 0.5f, 0.0f);
+
+		// A grid slightly larger than the viewport, so that some triangles are clipped
+		for (int y = 0; y < kGrid; y++) {
+			for (int x = 0; x < kGrid; x++) {
+				int i = y * kGrid + x;
+				_vertices[i * 3 + 0] = -1.2f + 2.4f * x / (kGrid - 1);
+				_vertices[i * 3 + 1] = -1.2f + 2.4f * y / (kGrid - 1);
+				_vertices[i * 3 + 2] = 0.1f * ((x + y) % 3) - 0.1f;
+				_normals[i * 3 + 0] = 0.1f * (x - 2);
+				_normals[i * 3 + 1] = 0.1f * (y - 2);
+				_normals[i * 3 + 2] = 1.0f;
+				_colors[i * 4 + 0] = x / (float)(kGrid - 1);
+				_colors[i * 4 + 1] = y / (float)(kGrid - 1);
+				_colors[i * 4 + 2] = ((x + y) & 1) ? 1.0f : 0.25f;
+				_colors[i * 4 + 3] = 1.0f;
+			}
+		}
+
+		_indexCount = 0;
+		for (int y = 0; y < kGrid - 1; y++) {
+			for (int x = 0; x < kGrid - 1; x++) {
+				TGLushort i = y * kGrid + x;
+				_indices[_indexCount++] = i;
+				_indices[_indexCount++] = i + 1;
+				_indices[_indexCount++] = i + kGrid;
+				_indices[_indexCount++] = i + 1;
+				_indices[_indexCount++] = i + kGrid + 1;
+				_indices[_indexCount++] = i + kGrid;
+			}
+		}
+
+		tglEnableClientState(TGL_VERTEX_ARRAY);
+		tglEnableClientState(TGL_NORMAL_ARRAY);
+		tglEnableClientState(TGL_COLOR_ARRAY);
+		tglVertexPointer(3, TGL_FLOAT, 0, _vertices);
+		tglNormalPointer(TGL_FLOAT, 0, _normals);
+		tglColorPointer(4, TGL_FLOAT, 0, _colors);
+	}
+
+	void tearDown() {
+		TinyGLTest::destroyContext(_context);
+	}
+
+	void drawAndCompare() {
+		Graphics::Surface surface, expected;
+
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+		tglDrawElements(TGL_TRIANGLES, _indexCount, TGL_UNSIGNED_SHORT, _indices);
+		TinyGLTest::copyFrame(surface);
+
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+		tglBegin(TGL_TRIANGLES);
+		for (int i = 0; i < _indexCount; i++)
+			tglArrayElement(_indices[i]);
+		tglEnd();
+		TinyGLTest::copyFrame(expected);
+
+		TS_ASSERT_EQUALS(TinyGLTest::countDifferences(surface, expected), 0);
+
+		surface.free();
+		expected.free();
+	}
+
+	void testUnlit() {
+		drawAndCompare();
+	}
+
+	void testLitColorMaterial() {
+		const float lightPos[] = { 0.5f, 0.5f, 1.0f, 0.0f };
+		tglEnable(TGL_LIGHTING);
+		tglEnable(TGL_LIGHT0);
+		tglLightfv(TGL_LIGHT0, TGL_POSITION, lightPos);
+		tglEnable(TGL_COLOR_MATERIAL);
+		tglColorMaterial(TGL_FRONT_AND_BACK, TGL_AMBIENT_AND_DIFFUSE);
+		tglEnable(TGL_NORMALIZE);
+		drawAndCompare();
+	}
+
+	void testOffscreen() {
+		Graphics::Surface surface;
+
+		tglClearColor(0.0f, 0.0f, 1.0f, 1.0f);
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+		uint32 drawCalls = TinyGL::getQueuedDrawCallCount();
+
+		// A mesh partly in view is drawn
+		tglPushMatrix();
+		tglTranslatef(1.0f, 0.0f, 0.0f);
+		tglDrawElements(TGL_TRIANGLES, _indexCount, TGL_UNSIGNED_SHORT, _indices);
+		tglPopMatrix();
+		TS_ASSERT_EQUALS(TinyGL::getQueuedDrawCallCount(), drawCalls + 1);
+		TinyGL::presentBuffer();
+
+		// A mesh beyond the right of the view is skipped before being rasterized,
+		// as all of its vertices are outside of the same clip plane
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+		tglTranslatef(4.0f, 0.0f, 0.0f);
+		tglDrawElements(TGL_TRIANGLES, _indexCount, TGL_UNSIGNED_SHORT, _indices);
+		TS_ASSERT_EQUALS(TinyGL::getQueuedDrawCallCount(), drawCalls);
+		TinyGL::presentBuffer();
+		TinyGL::getSurfaceRef(surface);
+
+		int drawn = 0;
+		for (int y = 0; y < kSize; y++) {
+			for (int x = 0; x < kSize; x++) {
+				if (surface.getPixel(x, y) != surface.format.ARGBToColor(255, 0, 0, 255))
+					drawn++;
+			}
+		}
+		TS_ASSERT_EQUALS(drawn, 0);
+	}
+};
+
+#endif
@@ -0,0 +1,179 @@
+#include <cxxtest/TestSuite.h>
+
+#ifdef USE_TINYGL
+
+#include "graphics/tinygl/zbuffer.h"
+
+#include "test/graphics/tinygl-helper.h"
+
+// The tinted, blended and scaled blits write whole rows at once; their pixels
+// are checked against a per pixel reference of the same arithmetic
+
+class TinyGLBlitTestSuite : public CxxTest::TestSuite {
+	static const int kSize = 32;
+	static const int kImageWidth = 13;
+	static const int kImageHeight = 5;
+
+	TinyGL::ContextHandle *_context = nullptr;
+	TinyGL::BlitImage *_image = nullptr;
+	Graphics::Surface _imageSurface;
+
+public:
+	void setUp() {
+		_context = TinyGLTest::createContext(kSize);
+
+		// Transparent, translucent and opaque pixels
+		_imageSurface.create(kImageWidth, kImageHeight, Graphics::PixelFormat::createFormatRGBA32());
+		for (int y = 0; y < kImageHeight; y++) {
+			for (int x = 0; x < kImageWidth; x++) {
+				const byte a = (x % 5 == 0) ? 0 : (x % 5 == 1 ? 255 : 40 * x + 7 * y);
+				_imageSurface.setPixel(x, y, _imageSurface.format.ARGBToColor(a, 19 * x + y, 255 - 11 * x, 50 * y + x));
+			}
+		}
+		_image = tglGenBlitImage();
+		tglUploadBlitImage(_image, _imageSurface, 0, false);
+	}
+
+	void tearDown() {
+		tglDeleteBlitImage(_image);
+		_imageSurface.free();
+		TinyGLTest::destroyContext(_context);
+	}
+
+	static uint32 referencePixel(const Graphics::PixelFormat &dstFormat, uint32 dst, uint32 src, const Graphics::PixelFormat &srcFormat,
+	                             bool blend, float aTint, float rTint, float gTint, float bTint, bool copyOpaque = false) {
+		byte a, r, g, b;
+		srcFormat.colorToARGB(src, a, r, g, b);
+		a = a * aTint;
+		r = r * rTint;
+		g = g * gTint;
+		b = b * bTint;
+		if (!blend || (copyOpaque && a == 255))
+			return dstFormat.ARGBToColor(a, r, g, b);
+
+		byte aDst, rDst, gDst, bDst;
+		dstFormat.colorToARGB(dst, aDst, rDst, gDst, bDst);
+		return dstFormat.RGBToColor(MIN(((rDst * (255 - a)) >> 8) + ((r * a) >> 8), 255),
+		                            MIN(((gDst * (255 - a)) >> 8) + ((g * a) >> 8), 255),
+		                            MIN(((bDst * (255 - a)) >> 8) + ((b * a) >> 8), 255));
+	}
+
+	void checkTintedBlit(bool blend, bool tint = true) {
+		const int dstX = 3, dstY = 7;
+		const float aTint = tint ? 0.75f : 1.0f, rTint = tint ? 0.5f : 1.0f, gTint = 1.0f, bTint = tint ? 0.3f : 1.0f;
+
+		if (blend) {
+			tglEnable(TGL_BLEND);
+			tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
+		} else {
+			tglDisable(TGL_BLEND);
+		}
+		tglClearColor(0.25f, 0.5f, 0.75f, 1.0f);
+		tglClear(TGL_COLOR_BUFFER_BIT);
+		TinyGL::BlitTransform transform(dstX, dstY);
+		if (tint)
+			transform.tint(aTint, rTint, gTint, bTint);
+		tglBlit(_image, transform);
+
+		Graphics::Surface surface, expected;
+		TinyGLTest::copyFrame(surface);
+		expected.copyFrom(surface);
+		const uint32 background = surface.getPixel(0, 0);
+		for (int y = 0; y < kImageHeight; y++) {
+			for (int x = 0; x < kImageWidth; x++) {
+				// Transparent pixels are skipped
+				const uint32 src = _imageSurface.getPixel(x, y);
+				uint32 pixel = background;
+				if ((src & _imageSurface.format.ARGBToColor(255, 0, 0, 0)) != 0)
+					pixel = referencePixel(surface.format, background, src, _imageSurface.format, blend, aTint, rTint, gTint, bTint, !tint);
+				expected.setPixel(dstX + x, dstY + y, pixel);
+			}
+		}
+		TS_ASSERT_EQUALS(TinyGLTest::countDifferences(surface, expected), 0);
+
+		surface.free();
+		expected.free();
+	}
+
+	void testTintedBlit() {
+		checkTintedBlit(false);
+	}
+
+	void testTintedAlphaBlendedBlit() {
+		checkTintedBlit(true);
+	}
+
+	// Without a tint, the opaque pixels are copied instead of blended
+	void testAlphaBlendedBlit() {
+		checkTintedBlit(true, false);
+	}
+
+	void checkScaledBlit(bool flip) {
+		const int dstX = 2, dstY = 1, width = 29, height = 11;
+
+		tglDisable(TGL_BLEND);
+		tglClear(TGL_COLOR_BUFFER_BIT);
+		TinyGL::BlitTransform transform(dstX, dstY);
+		transform.scale(width, height);
+		transform.flip(false, flip);
+		tglBlit(_image, transform);
+
+		Graphics::Surface surface, expected;
+		TinyGLTest::copyFrame(surface);
+		expected.copyFrom(surface);
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++) {
+				const int xSource = flip ? width - x - 1 : x;
+				byte a, r, g, b;
+				_imageSurface.format.colorToARGB(_imageSurface.getPixel((xSource * kImageWidth) / width, (y * kImageHeight) / height), a, r, g, b);
+				expected.setPixel(dstX + x, dstY + y, surface.format.ARGBToColor(a, r, g, b));
+			}
+		}
+		TS_ASSERT_EQUALS(TinyGLTest::countDifferences(surface, expected), 0);
+
+		surface.free();
+		expected.free();
+	}
+
+	void testScaledBlit() {
+		checkScaledBlit(false);
+	}
+
+	void testScaledFlippedBlit() {
+		checkScaledBlit(true);
+	}
+
+#ifdef SCUMMVM_SSE2
+	void testWritePixelRowSSE2() {
+		const int kCount = 11;
+		const Graphics::PixelFormat dstFormat = Graphics::PixelFormat::createFormatARGB32();
+		const Graphics::PixelFormat &srcFormat = _imageSurface.format;
+		const uint32 *src = (const uint32 *)_imageSurface.getBasePtr(0, 1);
+
+		for (int blend = 0; blend < 2; blend++) {
+			uint32 dst[kCount], expected[kCount];
+			for (int i = 0; i < kCount; i++) {
+				dst[i] = dstFormat.ARGBToColor(255, 23 * i, 200 - 13 * i, 128);
+				expected[i] = referencePixel(dstFormat, dst[i], src[i], srcFormat, blend, 0.9f, 1.0f, 0.6f, 0.2f);
+			}
+
+			// Only the whole groups of four pixels are written
+			TS_ASSERT_EQUALS(TinyGL::writePixelRowSSE2(dst, src, kCount, dstFormat, srcFormat, blend, 0.9f, 1.0f, 0.6f, 0.2f), 8);
+			for (int i = 0; i < 8; i++)
+				TS_ASSERT_EQUALS(dst[i], expected[i]);
+		}
+
+		// Untinted, with the opaque pixels copied
+		uint32 dst[kCount], expected[kCount];
+		for (int i = 0; i < kCount; i++) {
+			dst[i] = dstFormat.ARGBToColor(255, 23 * i, 200 - 13 * i, 128);
+			expected[i] = referencePixel(dstFormat, dst[i], src[i], srcFormat, true, 1.0f, 1.0f, 1.0f, 1.0f, true);
+		}
+		TS_ASSERT_EQUALS(TinyGL::writePixelRowSSE2(dst, src, kCount, dstFormat, srcFormat, true, 1.0f, 1.0f, 1.0f, 1.0f, true), 8);
+		for (int i = 0; i < 8; i++)
+			TS_ASSERT_EQUALS(dst[i], expected[i]);
+	}
+#endif
+};
+
+#endif
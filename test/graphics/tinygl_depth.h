@@ -0,0 +1,210 @@
+#include <cxxtest/TestSuite.h>
+
+#ifdef USE_TINYGL
+
+#include "graphics/tinygl/zblit_public.h"
+#include "graphics/tinygl/zgl.h"
+
+#include "test/graphics/tinygl-helper.h"
+
+// The z buffer keeps the farthest depth of each tile, to skip the triangles
+// behind it without testing their pixels one by one
+
+class TinyGLDepthTestSuite : public CxxTest::TestSuite {
+	static const int kSize = 64;
+	static const int kHidden = 4;
+	static const int kPartlyVisible = 2;
+
+	TinyGL::ContextHandle *_context = nullptr;
+
+public:
+	void setUp() {
+		_context = TinyGLTest::createContext(kSize);
+		tglDisable(TGL_BLEND);
+		tglEnable(TGL_DEPTH_TEST);
+		tglDepthFunc(TGL_LESS);
+	}
+
+	void tearDown() {
+		TinyGLTest::destroyContext(_context);
+	}
+
+	void drawQuad(float x1, float y1, float x2, float y2, float z, byte r, byte g, byte b) {
+		tglColor3ub(r, g, b);
+		tglBegin(TGL_QUADS);
+		tglVertex3f(x1, y1, z);
+		tglVertex3f(x2, y1, z);
+		tglVertex3f(x2, y2, z);
+		tglVertex3f(x1, y2, z);
+		tglEnd();
+	}
+
+	void drawTriangle(float x, float y, byte r, byte g, byte b) {
+		tglColor3ub(r, g, b);
+		tglBegin(TGL_TRIANGLES);
+		tglVertex3f(x, y, 0.2f);
+		tglVertex3f(x + 0.5f, y, 0.4f);
+		tglVertex3f(x, y + 0.5f, 0.6f);
+		tglEnd();
+	}
+
+	// Covers the left of the screen, up to 40 pixels
+	void drawOccluder() {
+		drawQuad(-1.0f, -1.0f, 0.25f, 1.0f, -0.5f, 255, 0, 0);
+	}
+
+	// Triangles behind the occluder, the first one of which is in the
+	// bottom left tile
+	void drawHidden() {
+		for (int i = 0; i < kHidden; i++)
+			drawTriangle(-1.0f + 0.5f * (i % 2), -1.0f + (i / 2), 0, 255, 0);
+	}
+
+	// Triangles which stick out of the right of the occluder
+	void drawPartlyVisible() {
+		for (int i = 0; i < kPartlyVisible; i++)
+			drawTriangle(0.0f, -1.0f + i, 0, 0, 255);
+	}
+
+	void drawScene(bool frontToBack) {
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+		if (frontToBack)
+			drawOccluder();
+		drawHidden();
+		drawPartlyVisible();
+		if (!frontToBack)
+			drawOccluder();
+	}
+
+	// Draws the occluder and the triangles hidden behind it, which leaves the
+	// depth of the tiles computed until the z buffer is changed
+	void drawOccluderAndHidden() {
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+		drawOccluder();
+		drawHidden();
+		TinyGL::presentBuffer();
+		TS_ASSERT_EQUALS(TinyGL::getOccludedTriangleCount(), (uint32)kHidden);
+	}
+
+	void testDrawOrder() {
+		Graphics::Surface surface, expected;
+
+		// Nothing is hidden yet when drawing back to front
+		drawScene(false);
+		TinyGLTest::copyFrame(expected);
+		TS_ASSERT_EQUALS(TinyGL::getOccludedTriangleCount(), 0u);
+
+		// Only the hidden triangles are skipped when drawing front to back
+		drawScene(true);
+		TinyGLTest::copyFrame(surface);
+		TS_ASSERT_EQUALS(TinyGL::getOccludedTriangleCount(), (uint32)kHidden);
+		TS_ASSERT_EQUALS(TinyGLTest::countDifferences(surface, expected), 0);
+
+		// The partly visible triangles are visible on the right
+		TS_ASSERT_EQUALS(surface.getPixel(kSize / 4, kSize / 2), surface.format.ARGBToColor(255, 255, 0, 0));
+		TS_ASSERT_EQUALS(surface.getPixel(kSize * 5 / 8 + 2, kSize - 4), surface.format.ARGBToColor(255, 0, 0, 255));
+
+		surface.free();
+		expected.free();
+	}
+
+	void testZBufferBlit() {
+		Graphics::Surface surface, farthest;
+
+		drawOccluderAndHidden();
+
+		// Blitting the farthest depth to the bottom left tile shows what is behind there
+		farthest.create(8, 8, Graphics::PixelFormat::createFormatARGB32());
+		farthest.fillRect(Common::Rect(8, 8), 0);
+		TinyGL::BlitImage *image = tglGenBlitImage();
+		tglUploadBlitImage(image, farthest, 0, false, true);
+		tglBlitZBuffer(image, 0, kSize - 8);
+		drawHidden();
+		TinyGL::presentBuffer();
+		TS_ASSERT_EQUALS(TinyGL::getOccludedTriangleCount(), (uint32)kHidden - 1);
+
+		TinyGL::getSurfaceRef(surface);
+		TS_ASSERT_EQUALS(surface.getPixel(2, kSize - 3), surface.format.ARGBToColor(255, 0, 255, 0));
+		TS_ASSERT_EQUALS(surface.getPixel(10, kSize - 3), surface.format.ARGBToColor(255, 255, 0, 0));
+
+		tglDeleteBlitImage(image);
+		farthest.free();
+	}
+
+	void testClearRegion() {
+		Graphics::Surface surface;
+
+		drawOccluderAndHidden();
+
+		// Clearing the depth of the bottom left tile shows what is behind there
+		tglEnable(TGL_SCISSOR_TEST);
+		tglScissor(0, 0, 8, 8);
+		tglClear(TGL_DEPTH_BUFFER_BIT);
+		tglDisable(TGL_SCISSOR_TEST);
+		drawHidden();
+		TinyGL::presentBuffer();
+		TS_ASSERT_EQUALS(TinyGL::getOccludedTriangleCount(), (uint32)kHidden - 1);
+
+		TinyGL::getSurfaceRef(surface);
+		TS_ASSERT_EQUALS(surface.getPixel(2, kSize - 3), surface.format.ARGBToColor(255, 0, 255, 0));
+		TS_ASSERT_EQUALS(surface.getPixel(10, kSize - 3), surface.format.ARGBToColor(255, 255, 0, 0));
+	}
+
+	void testOffscreenBuffer() {
+		TinyGL::FrameBuffer *fb = TinyGL::gl_get_context()->fb;
+
+		drawOccluderAndHidden();
+
+		// Nothing is drawn yet in the z buffer of another buffer
+		TinyGL::Buffer *buffer = fb->genOffscreenBuffer();
+		fb->selectOffscreenBuffer(buffer);
+		drawHidden();
+		TinyGL::presentBuffer();
+		TS_ASSERT_EQUALS(TinyGL::getOccludedTriangleCount(), 0u);
+
+		// While the occluder is still in the z buffer of the screen
+		fb->selectOffscreenBuffer(nullptr);
+		drawHidden();
+		TinyGL::presentBuffer();
+		TS_ASSERT_EQUALS(TinyGL::getOccludedTriangleCount(), (uint32)kHidden);
+
+		fb->delOffscreenBuffer(buffer);
+	}
+
+	void testLessEqual() {
+		Graphics::Surface surface;
+
+		// Drawing again at the same depth is not hidden with TGL_LEQUAL
+		tglDepthFunc(TGL_LEQUAL);
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+		drawQuad(-1.0f, -1.0f, 1.0f, 1.0f, 0.0f, 255, 0, 0);
+		drawQuad(-1.0f, -1.0f, 1.0f, 1.0f, 0.0f, 0, 255, 0);
+		TinyGL::presentBuffer();
+		TinyGL::getSurfaceRef(surface);
+		TS_ASSERT_EQUALS(surface.getPixel(kSize / 2, kSize / 2), surface.format.ARGBToColor(255, 0, 255, 0));
+
+		// But is with TGL_LESS
+		tglDepthFunc(TGL_LESS);
+		drawQuad(-1.0f, -1.0f, 1.0f, 1.0f, 0.0f, 0, 0, 255);
+		TinyGL::presentBuffer();
+		TinyGL::getSurfaceRef(surface);
+		TS_ASSERT_EQUALS(surface.getPixel(kSize / 2, kSize / 2), surface.format.ARGBToColor(255, 0, 255, 0));
+	}
+
+	void testDepthWriteWithoutTest() {
+		Graphics::Surface surface;
+
+		// The far quad overwrites the depth of the near one, so the last one is visible
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+		drawQuad(-1.0f, -1.0f, 1.0f, 1.0f, -0.5f, 255, 0, 0);
+		tglDepthFunc(TGL_ALWAYS);
+		drawQuad(-1.0f, -1.0f, 1.0f, 1.0f, 0.5f, 0, 255, 0);
+		tglDepthFunc(TGL_LESS);
+		drawQuad(-1.0f, -1.0f, 1.0f, 1.0f, 0.0f, 0, 0, 255);
+		TinyGL::presentBuffer();
+		TinyGL::getSurfaceRef(surface);
+		TS_ASSERT_EQUALS(surface.getPixel(kSize / 2, kSize / 2), surface.format.ARGBToColor(255, 0, 0, 255));
+	}
+};
+
+#endif
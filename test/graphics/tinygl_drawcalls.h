@@ -0,0 +1,74 @@
+#include <cxxtest/TestSuite.h>
+
+#ifdef USE_TINYGL
+
+#include "graphics/tinygl/tinygl.h"
+
+// every test queues more draw calls than the draw call memory of the context
+// can hold, which must then grow instead of running out of memory
+
+class TinyGLDrawCallsTestSuite : public CxxTest::TestSuite {
+	static const int kSize = 16;
+	static const int kMemorySize = 1024;
+	static const int kTriangles = 64;
+
+	TinyGL::ContextHandle *_context = nullptr;
+
+public:
+	void tearDown() {
+		if (_context != nullptr) {
+			TinyGL::destroyContext(_context);
+			_context = nullptr;
+		}
+	}
+
+	void createContext(bool dirtyRects) {
+		_context = TinyGL::createContext(kSize, kSize, Graphics::PixelFormat::createFormatARGB32(), 2, false, dirtyRects, kMemorySize);
+		TinyGL::setContext(_context);
+
+		tglMatrixMode(TGL_PROJECTION);
+		tglLoadIdentity();
+		tglMatrixMode(TGL_MODELVIEW);
+		tglLoadIdentity();
+		tglViewport(0, 0, kSize, kSize);
+	}
+
+	void drawFrame(int frame) {
+		tglClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		tglClear(TGL_COLOR_BUFFER_BIT);
+		for (int i = 0; i < kTriangles; i++) {
+			const float x = -1.0f + 2.0f * (i % 8) / 8, y = -1.0f + 2.0f * (i / 8) / 8;
+			tglColor3f(1.0f, (frame & 1) ? 1.0f : 0.0f, 0.0f);
+			tglBegin(TGL_TRIANGLES);
+			tglVertex3f(x, y, 0.0f);
+			tglVertex3f(x + 0.25f, y, 0.0f);
+			tglVertex3f(x, y + 0.25f, 0.0f);
+			tglEnd();
+		}
+		TinyGL::presentBuffer();
+	}
+
+	void checkFrames() {
+		for (int frame = 0; frame < 4; frame++) {
+			drawFrame(frame);
+
+			Graphics::Surface surface;
+			TinyGL::getSurfaceRef(surface);
+			TS_ASSERT_EQUALS(surface.getPixel(0, kSize - 1), surface.format.ARGBToColor(255, 255, (frame & 1) ? 255 : 0, 0));
+		}
+
+		TS_ASSERT_LESS_THAN((uint32)kMemorySize, TinyGL::getDrawCallMemoryHighWaterMark());
+	}
+
+	void testDirtyRects() {
+		createContext(true);
+		checkFrames();
+	}
+
+	void testNoDirtyRects() {
+		createContext(false);
+		checkFrames();
+	}
+};
+
+#endif
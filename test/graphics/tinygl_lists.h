@@ -0,0 +1,102 @@
+#include <cxxtest/TestSuite.h>
+
+#ifdef USE_TINYGL
+
+#include "test/graphics/tinygl-helper.h"
+
+// glEndList drops repeated state changes and joins glBegin/glEnd blocks, which
+// must not change what a list draws compared to the same calls made directly
+
+class TinyGLListsTestSuite : public CxxTest::TestSuite {
+	static const int kSize = 32;
+	static const int kGrid = 4;
+
+	TinyGL::ContextHandle *_context = nullptr;
+
+public:
+	void setUp() {
+		_context = TinyGLTest::createContext(kSize);
+	}
+
+	void tearDown() {
+		TinyGLTest::destroyContext(_context);
+	}
+
+	void drawScene(TGLenum mode) {
+		for (int y = 0; y < kGrid; y++) {
+			for (int x = 0; x < kGrid; x++) {
+				const float x0 = -1.0f + 2.0f * x / kGrid, x1 = x0 + 2.0f / kGrid;
+				const float y0 = -1.0f + 2.0f * y / kGrid, y1 = y0 + 2.0f / kGrid;
+
+				// The same state is set again for every cell
+				tglEnable(TGL_DEPTH_TEST);
+				tglDepthFunc(TGL_LESS);
+				tglColor3f(x / (float)kGrid, y / (float)kGrid, 0.5f);
+				tglBegin(mode);
+				if (mode == TGL_QUADS) {
+					tglVertex3f(x0, y0, 0.0f);
+					tglVertex3f(x1, y0, 0.5f);
+					tglVertex3f(x1, y1, 0.0f);
+					tglVertex3f(x0, y1, -0.5f);
+				} else {
+					tglVertex3f(x0, y0, 0.0f);
+					tglVertex3f(x1, y0, 0.5f);
+					tglColor3f(1.0f, x / (float)kGrid, y / (float)kGrid);
+					tglVertex3f(x0, y1, -0.5f);
+				}
+				tglEnd();
+			}
+		}
+
+		// A strip is never joined with the previous blocks
+		tglDisable(TGL_DEPTH_TEST);
+		tglBegin(TGL_TRIANGLE_STRIP);
+		tglVertex3f(-0.5f, -0.5f, 0.0f);
+		tglVertex3f(0.5f, -0.5f, 0.0f);
+		tglVertex3f(-0.5f, 0.0f, 0.0f);
+		tglVertex3f(0.5f, 0.0f, 0.0f);
+		tglEnd();
+	}
+
+	// The clear and the strip take a draw call each, besides the cells
+	void drawAndCompare(TGLenum mode, uint32 listCellDrawCalls) {
+		Graphics::Surface surface, expected;
+
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+		drawScene(mode);
+		TS_ASSERT_EQUALS(TinyGL::getQueuedDrawCallCount(), (uint32)(kGrid * kGrid + 2));
+		TinyGLTest::copyFrame(expected);
+
+		TGLuint list = tglGenLists(1);
+		tglNewList(list, TGL_COMPILE);
+		drawScene(mode);
+		tglEndList();
+
+		// Start from the opposite state, which the list must set again
+		tglDisable(TGL_DEPTH_TEST);
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+		tglCallList(list);
+		TS_ASSERT_EQUALS(TinyGL::getQueuedDrawCallCount(), listCellDrawCalls + 2);
+		TinyGLTest::copyFrame(surface);
+
+		TS_ASSERT_EQUALS(TinyGLTest::countDifferences(surface, expected), 0);
+
+		surface.free();
+		expected.free();
+	}
+
+	void testTriangles() {
+		drawAndCompare(TGL_TRIANGLES, 1);
+	}
+
+	void testQuads() {
+		drawAndCompare(TGL_QUADS, 1);
+	}
+
+	// Polygons are never joined
+	void testPolygons() {
+		drawAndCompare(TGL_POLYGON, kGrid * kGrid);
+	}
+};
+
+#endif
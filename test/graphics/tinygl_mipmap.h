@@ -0,0 +1,141 @@
+#include <cxxtest/TestSuite.h>
+
+#ifdef USE_TINYGL
+
+#include "graphics/tinygl/texelbuffer.h"
+#include "graphics/tinygl/zbuffer.h"
+
+#include "test/graphics/tinygl-helper.h"
+
+// every test draws a finely checkered texture shrunk to a few pixels, which
+// only averages out to grey when the smaller levels of the texture are used
+
+class TinyGLMipmapTestSuite : public CxxTest::TestSuite {
+	static const int kSize = 4;
+	static const int kTextureSize = 64;
+
+	TinyGL::ContextHandle *_context = nullptr;
+	byte _texData[kTextureSize * kTextureSize * 4];
+
+public:
+	void setUp() {
+		_context = TinyGLTest::createContext(kSize, kTextureSize);
+		tglEnable(TGL_TEXTURE_2D);
+		tglDisable(TGL_BLEND);
+		tglDisable(TGL_DEPTH_TEST);
+		tglColor4ub(255, 255, 255, 255);
+
+		for (int y = 0; y < kTextureSize; y++) {
+			for (int x = 0; x < kTextureSize; x++) {
+				const byte value = ((x + y) & 1) ? 255 : 0;
+				byte *texel = _texData + (y * kTextureSize + x) * 4;
+				texel[0] = texel[1] = texel[2] = value;
+				texel[3] = 255;
+			}
+		}
+	}
+
+	void tearDown() {
+		TinyGLTest::destroyContext(_context);
+	}
+
+	// Returns how many pixels are neither close to black nor to white.
+	// The filter is set before the upload, after it, or not at all when 0.
+	int drawCheckerboard(int minFilter, bool afterUpload = false, bool maxLevelZero = false) {
+		TGLuint texture;
+		tglGenTextures(1, &texture);
+		tglBindTexture(TGL_TEXTURE_2D, texture);
+		if (minFilter && !afterUpload)
+			tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MIN_FILTER, minFilter);
+		tglTexImage2D(TGL_TEXTURE_2D, 0, TGL_RGBA, kTextureSize, kTextureSize, 0, TGL_RGBA, TGL_UNSIGNED_BYTE, _texData);
+		if (minFilter && afterUpload)
+			tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MIN_FILTER, minFilter);
+		if (maxLevelZero)
+			tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MAX_LEVEL, 0);
+
+		tglClear(TGL_COLOR_BUFFER_BIT);
+		tglBegin(TGL_QUADS);
+		tglTexCoord2f(0.0f, 0.0f); tglVertex2f(-1.0f, -1.0f);
+		tglTexCoord2f(1.0f, 0.0f); tglVertex2f(+1.0f, -1.0f);
+		tglTexCoord2f(1.0f, 1.0f); tglVertex2f(+1.0f, +1.0f);
+		tglTexCoord2f(0.0f, 1.0f); tglVertex2f(-1.0f, +1.0f);
+		tglEnd();
+
+		Graphics::Surface surface;
+		TinyGL::presentBuffer();
+		TinyGL::getSurfaceRef(surface);
+
+		int grey = 0;
+		for (int y = 0; y < kSize; y++) {
+			for (int x = 0; x < kSize; x++) {
+				byte a, r, g, b;
+				surface.format.colorToARGB(surface.getPixel(x, y), a, r, g, b);
+				if (r > 64 && r < 192)
+					grey++;
+			}
+		}
+
+		tglDeleteTextures(1, &texture);
+		return grey;
+	}
+
+	void testNearest() {
+		TS_ASSERT_EQUALS(drawCheckerboard(TGL_NEAREST), 0);
+	}
+
+	void testDefaultFilter() {
+		TS_ASSERT_EQUALS(drawCheckerboard(0), 0);
+	}
+
+	void testNearestMipmapNearest() {
+		TS_ASSERT_EQUALS(drawCheckerboard(TGL_NEAREST_MIPMAP_NEAREST), kSize * kSize);
+	}
+
+	void testLinearMipmapLinear() {
+		TS_ASSERT_EQUALS(drawCheckerboard(TGL_LINEAR_MIPMAP_LINEAR), kSize * kSize);
+	}
+
+	void testFilterSetAfterUpload() {
+		TS_ASSERT_EQUALS(drawCheckerboard(TGL_NEAREST_MIPMAP_NEAREST, true), kSize * kSize);
+
+		tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MIN_FILTER, TGL_NEAREST_MIPMAP_NEAREST);
+		TS_ASSERT_EQUALS(drawCheckerboard(TGL_NEAREST, true), 0);
+	}
+
+	void testMaxLevelZero() {
+		TS_ASSERT_EQUALS(drawCheckerboard(TGL_NEAREST_MIPMAP_LINEAR, false, true), 0);
+	}
+
+	// Textures re-uploaded every frame, then drawn without minification or
+	// with their mipmaps turned off, must not build the smaller levels
+	void testMipmapsBuiltOnFirstMinification() {
+		TinyGL::TexelBuffer *texture = TinyGL::createNearestTexelBuffer(_texData, Graphics::PixelFormat::createFormatRGBA32(),
+		                                                                TGL_RGBA, TGL_UNSIGNED_BYTE, kTextureSize, kTextureSize, kTextureSize, TGL_RGBA);
+		const int texel = 1 << ZB_POINT_ST_FRAC_BITS;
+
+		texture->setMipmapMode(TinyGL::TexelBuffer::kMipmapBilinear);
+		TS_ASSERT(texture->hasMipmaps());
+		TS_ASSERT(!texture->hasBuiltMipmaps());
+
+		// One texel per pixel stays on the base level
+		TS_ASSERT_EQUALS(texture->getMipmap(texel, 0, 0, texel), texture);
+		TS_ASSERT(!texture->hasBuiltMipmaps());
+
+		const TinyGL::TexelBuffer *level = texture->getMipmap(texel * 4, 0, 0, texel * 4);
+		TS_ASSERT(texture->hasBuiltMipmaps());
+		TS_ASSERT_DIFFERS(level, texture);
+		TS_ASSERT_EQUALS(level->width(), (uint)kTextureSize / 4);
+
+		// Keeping the filter keeps the levels, turning them off drops them
+		texture->setMipmapMode(TinyGL::TexelBuffer::kMipmapBilinear);
+		TS_ASSERT(texture->hasBuiltMipmaps());
+		texture->setMipmapMode(TinyGL::TexelBuffer::kMipmapNone);
+		TS_ASSERT(!texture->hasMipmaps());
+		TS_ASSERT(!texture->hasBuiltMipmaps());
+		TS_ASSERT_EQUALS(texture->getMipmap(texel * 4, 0, 0, texel * 4), texture);
+
+		delete texture;
+	}
+};
+
+#endif
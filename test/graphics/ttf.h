@@ -0,0 +1,251 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/endian.h"
+#include "common/fs.h"
+#include "common/memstream.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "graphics/font.h"
+#include "graphics/fonts/ttf.h"
+#include "graphics/surface.h"
+
+#include "../system/null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+class TTFTestSuite : public CxxTest::TestSuite {
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_glyph_atlas_sharing() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Graphics::Font *font1 = loadFont(16);
+		if (!font1)
+			return;
+
+		uint32 size = Graphics::getTTFGlyphAtlasSize();
+		TS_ASSERT_LESS_THAN(0u, size);
+
+		// The same face at the same size reuses the glyphs of the first font
+		Graphics::Font *font2 = loadFont(16);
+		TS_ASSERT(font2);
+		TS_ASSERT_EQUALS(Graphics::getTTFGlyphAtlasSize(), size);
+
+		// Faces in use are kept whatever the limit
+		delete font2;
+		Graphics::setTTFGlyphAtlasLimit(0);
+		TS_ASSERT_LESS_THAN(0u, Graphics::getTTFGlyphAtlasSize());
+
+		delete font1;
+		Graphics::setTTFGlyphAtlasLimit(0);
+		TS_ASSERT_EQUALS(Graphics::getTTFGlyphAtlasSize(), 0u);
+
+		Graphics::setTTFGlyphAtlasLimit(4 * 1024 * 1024);
+#endif
+	}
+
+	void test_glyph_atlas_different_files() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::FSNode node("test/engine-data/LiberationSans-Regular.ttf");
+		Common::SeekableReadStream *stream = node.createReadStream();
+		if (!stream)
+			return;
+
+		const uint32 fileSize = stream->size();
+		byte *data1 = (byte *)malloc(fileSize);
+		byte *data2 = (byte *)malloc(fileSize);
+		stream->read(data1, fileSize);
+		delete stream;
+		memcpy(data2, data1, fileSize);
+
+		// Change a byte of the glyph outlines, which leaves the names, size and
+		// metrics of the face alone. Only the checksum of the outlines in the
+		// table directory at the start of the file changes along with it.
+		const uint numTables = READ_BE_UINT16(data1 + 4);
+		for (uint i = 0; i < numTables; ++i) {
+			byte *record = data2 + 12 + i * 16;
+			if (READ_BE_UINT32(record) == MKTAG('g', 'l', 'y', 'f')) {
+				const uint32 offset = READ_BE_UINT32(record + 8), length = READ_BE_UINT32(record + 12);
+				data2[offset + length / 2] ^= 0xFF;
+
+				uint32 checksum = 0;
+				for (uint32 j = 0; j + 4 <= length; j += 4)
+					checksum += READ_BE_UINT32(data2 + offset + j);
+				for (uint32 j = length & ~3; j < length; ++j)
+					checksum += data2[offset + j] << (24 - 8 * (j & 3));
+				WRITE_BE_UINT32(record + 4, checksum);
+			}
+		}
+		TS_ASSERT_DIFFERS(memcmp(data1, data2, fileSize), 0);
+
+		Graphics::Font *font1 = Graphics::loadTTFFont(new Common::MemoryReadStream(data1, fileSize, DisposeAfterUse::YES), DisposeAfterUse::YES,
+		                                              16, Graphics::kTTFSizeModeCharacter, 0, 0, Graphics::kTTFRenderModeLight);
+		TS_ASSERT(font1);
+		const uint32 size = Graphics::getTTFGlyphAtlasSize();
+
+		// Fonts from different files do not share their glyphs
+		Graphics::Font *font2 = Graphics::loadTTFFont(new Common::MemoryReadStream(data2, fileSize, DisposeAfterUse::YES), DisposeAfterUse::YES,
+		                                              16, Graphics::kTTFSizeModeCharacter, 0, 0, Graphics::kTTFRenderModeLight);
+		TS_ASSERT(font2);
+		TS_ASSERT_LESS_THAN(size, Graphics::getTTFGlyphAtlasSize());
+
+		delete font1;
+		delete font2;
+		Graphics::setTTFGlyphAtlasLimit(0);
+		Graphics::setTTFGlyphAtlasLimit(4 * 1024 * 1024);
+#endif
+	}
+
+	void test_text_run() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Graphics::Font *font = loadFont(16);
+		if (!font)
+			return;
+
+		const Common::String str("AVAST! Wave To You, Tom.");
+		const Common::U32String u32str(str);
+
+		TS_ASSERT_EQUALS(font->getStringWidth(str), getCharByCharWidth(*font, u32str));
+		TS_ASSERT_EQUALS(font->getStringWidth(u32str), getCharByCharWidth(*font, u32str));
+
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat::createFormatCLUT8(),
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0)
+		};
+
+		for (int i = 0; i < ARRAYSIZE(formats); ++i) {
+			Graphics::Surface runSurf, charSurf;
+			runSurf.create(320, 40, formats[i]);
+			charSurf.create(320, 40, formats[i]);
+
+			const uint32 color = formats[i].isCLUT8() ? 15 : formats[i].RGBToColor(255, 128, 0);
+			font->drawString(&runSurf, str, -3, 5, 317, color);
+			drawCharByChar(*font, &charSurf, u32str, -3, 5, 317, color);
+			TS_ASSERT(compareSurfaces(runSurf, charSurf));
+
+			// Clipped at the right end of the text area
+			runSurf.fillRect(Common::Rect(runSurf.w, runSurf.h), 0);
+			charSurf.fillRect(Common::Rect(charSurf.w, charSurf.h), 0);
+			font->drawString(&runSurf, u32str, 10, 5, 80, color);
+			drawCharByChar(*font, &charSurf, u32str, 10, 5, 80, color);
+			TS_ASSERT(compareSurfaces(runSurf, charSurf));
+
+			runSurf.free();
+			charSurf.free();
+		}
+
+		delete font;
+#endif
+	}
+
+	void test_paragraph_speed() {
+#if BENCHMARK_TIME
+		Graphics::Font *font = loadFont(14);
+		if (!font)
+			return;
+
+		const char *const paragraph[] = {
+			"It was a dark and stormy night; the rain fell in torrents,",
+			"except at occasional intervals, when it was checked by a",
+			"violent gust of wind which swept up the streets (for it is",
+			"in London that our scene lies), rattling along the housetops,",
+			"and fiercely agitating the scanty flame of the lamps that",
+			"struggled against the darkness."
+		};
+
+		Graphics::Surface surf;
+		surf.create(480, 120, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+		const uint32 color = surf.format.RGBToColor(255, 255, 255);
+
+#ifdef SLOW_TESTS
+		const int iters = 1000;
+#else
+		const int iters = 1;
+#endif
+
+		uint32 charStart = g_system->getMillis();
+		for (int i = 0; i < iters; i++) {
+			for (int line = 0; line < ARRAYSIZE(paragraph); ++line)
+				drawCharByChar(*font, &surf, Common::U32String(paragraph[line]), 0, line * 18, surf.w, color);
+		}
+		uint32 charTime = g_system->getMillis() - charStart;
+
+		uint32 runStart = g_system->getMillis();
+		for (int i = 0; i < iters; i++) {
+			for (int line = 0; line < ARRAYSIZE(paragraph); ++line)
+				font->drawString(&surf, paragraph[line], 0, line * 18, surf.w, color);
+		}
+		uint32 runTime = g_system->getMillis() - runStart;
+
+		debug("Paragraph drawn character by character, time for %d iters (in milliseconds): %d\n", iters, charTime);
+		debug("Paragraph drawn from cached text runs, time for %d iters (in milliseconds): %d\n", iters, runTime);
+
+		surf.free();
+		delete font;
+#endif
+	}
+
+private:
+	Graphics::Font *loadFont(int size) {
+		Common::FSNode node("test/engine-data/LiberationSans-Regular.ttf");
+		Common::SeekableReadStream *stream = node.createReadStream();
+		if (!stream) {
+			warning("LiberationSans-Regular.ttf not found, skipping TTF test");
+			return nullptr;
+		}
+
+		return Graphics::loadTTFFont(stream, DisposeAfterUse::YES, size, Graphics::kTTFSizeModeCharacter, 0, 0, Graphics::kTTFRenderModeLight);
+	}
+
+	// The generic layout of Font, which does not use text runs
+	static int getCharByCharWidth(const Graphics::Font &font, const Common::U32String &str) {
+		int width = 0;
+		uint32 last = 0;
+		for (uint i = 0; i < str.size(); ++i) {
+			width += font.getKerningOffset(last, str[i]) + font.getCharWidth(str[i]);
+			last = str[i];
+		}
+		return width;
+	}
+
+	static void drawCharByChar(const Graphics::Font &font, Graphics::Surface *dst, const Common::U32String &str, int x, int y, int w, uint32 color) {
+		const int leftX = MAX<int>(x, 0), rightX = x + w + 1;
+		uint32 last = 0;
+		for (uint i = 0; i < str.size(); ++i) {
+			x += font.getKerningOffset(last, str[i]);
+			last = str[i];
+
+			Common::Rect charBox = font.getBoundingBox(str[i]);
+			if (x + charBox.right > rightX)
+				break;
+			if (x + charBox.right >= leftX)
+				font.drawChar(dst, str[i], x, y, color);
+
+			x += font.getCharWidth(str[i]);
+		}
+	}
+
+	static bool compareSurfaces(const Graphics::Surface &a, const Graphics::Surface &b) {
+		for (int y = 0; y < a.h; ++y) {
+			if (memcmp(a.getBasePtr(0, y), b.getBasePtr(0, y), a.w * a.format.bytesPerPixel))
+				return false;
+		}
+		return true;
+	}
+};
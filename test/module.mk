@@ -2,6 +2,7 @@
 # Unit/regression tests, based on CxxTest.
 # Use the 'test' target to run them.
 # Edit TESTS and TESTLIBS to add more tests.
+# Use the 'test-benchmark' target to run the benchmarks in BENCHMARKS.
 #
 ######################################################################
 
@@ -10,7 +11,9 @@ TESTS        := $(srcdir)/test/common/*.h \
 	$(srcdir)/test/common/formats/*.h \
 	$(srcdir)/test/audio/*.h \
 	$(srcdir)/test/math/*.h \
-	$(srcdir)/test/image/*.h
+	$(srcdir)/test/image/*.h \
+	$(srcdir)/test/graphics/blit.h
+BENCHMARKS   := $(srcdir)/test/benchmark/*.h
 TEST_LIBS    :=
 
 ifdef POSIX
@@ -38,7 +41,12 @@ TESTS += $(srcdir)/test/graphics/tinygl*.h
 endif
 
 # libcommon needs libformats and libformats needs libcommon: so libcommon is put twice
-TEST_LIBS +=	audio/libaudio.a math/libmath.a common/libcommon.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a image/libimage.a graphics/libgraphics.a
+# libgraphics loads TTF fonts from zip archives, so it comes before libcompression
+TEST_LIBS +=	audio/libaudio.a math/libmath.a image/libimage.a graphics/libgraphics.a common/libcommon.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a
+
+ifdef USE_FREETYPE2
+TESTS += $(srcdir)/test/graphics/ttf.h
+endif
 
 ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/wintermute/*.h
@@ -91,15 +99,32 @@ test/runner.cpp: $(TESTS) $(srcdir)/test/module.mk
 	@mkdir -p test
 	$(srcdir)/test/cxxtest/bin/cxxtestgen $(TEST_FLAGS) -o $@ $+
 
+# The benchmarks trace their timings, which only the verbose runner prints
+test-benchmark: test/benchmark/runner
+	./test/benchmark/runner -v
+test/benchmark/runner: test/benchmark/runner.cpp $(TEST_LIBS) copy-dat
+	+$(QUIET_CXX)$(LD) $(TEST_CXXFLAGS) $(CPPFLAGS) $(TEST_CFLAGS) -o $@ test/benchmark/runner.cpp $(TEST_LIBS) $(TEST_LDFLAGS)
+test/benchmark/runner.cpp: $(BENCHMARKS) $(srcdir)/test/module.mk
+	@mkdir -p test/benchmark
+	$(srcdir)/test/cxxtest/bin/cxxtestgen $(TEST_FLAGS) -o $@ $+
+
 clean: clean-test
 clean-test:
-	-$(RM) test/runner.cpp test/runner test/engine-data/encoding.dat test/system/null_osystem.o
-	-rmdir test/engine-data
+	-$(RM) test/runner.cpp test/runner test/engine-data/encoding.dat test/engine-data/LiberationSans-Regular.ttf test/system/null_osystem.o
+	-$(RM) test/benchmark/runner.cpp test/benchmark/runner
+	-rmdir test/engine-data test/benchmark
 
 test/engine-data/encoding.dat: $(srcdir)/dists/engine-data/encoding.dat
 	$(MKDIR) test/engine-data
 	$(CP) $(srcdir)/dists/engine-data/encoding.dat test/engine-data/encoding.dat
 
+test/engine-data/LiberationSans-Regular.ttf: $(srcdir)/dists/engine-data/fonts/fonts/LiberationSans-Regular.ttf
+	$(MKDIR) test/engine-data
+	$(CP) $(srcdir)/dists/engine-data/fonts/fonts/LiberationSans-Regular.ttf test/engine-data/LiberationSans-Regular.ttf
+
 copy-dat: test/engine-data/encoding.dat
+ifdef USE_FREETYPE2
+copy-dat: test/engine-data/LiberationSans-Regular.ttf
+endif
 
-.PHONY: test clean-test copy-dat
+.PHONY: test test-benchmark clean-test copy-dat